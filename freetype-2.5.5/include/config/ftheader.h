@@ -793,6 +793,42 @@
 #define FT_ADVANCES_H  <ftadvanc.h>
 
 
+  /*************************************************************************
+   *
+   * @macro:
+   *   FT_ARENA_H
+   *
+   * @description:
+   *   A macro used in #include statements to name the file containing the
+   *   FreeType~2 API which provides an arena memory manager.
+   */
+#define FT_ARENA_H  <ftarena.h>
+
+
+  /*************************************************************************
+   *
+   * @macro:
+   *   FT_MEMORY_PROFILER_H
+   *
+   * @description:
+   *   A macro used in #include statements to name the file containing the
+   *   FreeType~2 API which returns per-call-site allocation statistics.
+   */
+#define FT_MEMORY_PROFILER_H  <ftmemprf.h>
+
+
+  /*************************************************************************
+   *
+   * @macro:
+   *   FT_COUNTERS_H
+   *
+   * @description:
+   *   A macro used in #include statements to name the file containing the
+   *   FreeType~2 API which gives access to the performance counters.
+   */
+#define FT_COUNTERS_H  <ftcountr.h>
+
+
   /* */
 
 #define FT_ERROR_DEFINITIONS_H  <fterrdef.h>
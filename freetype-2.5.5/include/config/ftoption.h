@@ -129,6 +129,8 @@ FT_BEGIN_HEADER
   /* If this macro is defined, try to use an inlined assembler version of  */
   /* the `FT_MulFix' function, which is a `hotspot' when loading and       */
   /* hinting glyphs, and which should be executed as fast as possible.     */
+  /* If a 64-bit type is available, `FT_MulDiv', `FT_DivFix', and (if      */
+  /* there is no assembler version) `FT_MulFix' are inlined also.          */
   /*                                                                       */
   /* Note that if your compiler or CPU is not supported, this will default */
   /* to the standard and portable implementation found in `ftcalc.c'.      */
@@ -499,6 +501,19 @@ FT_BEGIN_HEADER
 /* #define FT_CONFIG_OPTION_PIC */
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* Performance counters                                                  */
+  /*                                                                       */
+  /*   If this macro is set, each library object counts glyph loads,       */
+  /*   executed bytecode instructions, rasterized cells, cache hits and    */
+  /*   misses, and similar events of FreeType's hot paths.  The counters   */
+  /*   are cheap enough to be always on; see file `ftcountr.h' for the     */
+  /*   API to query them.                                                  */
+  /*                                                                       */
+#define FT_CONFIG_OPTION_COUNTERS
+
+
   /*************************************************************************/
   /*************************************************************************/
   /****                                                                 ****/
@@ -0,0 +1,214 @@
+/***************************************************************************/
+/*                                                                         */
+/*  ftarena.h                                                              */
+/*                                                                         */
+/*    FreeType arena memory manager (specification).                       */
+/*                                                                         */
+/*  Copyright 2026 by                                                      */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+#ifndef __FTARENA_H__
+#define __FTARENA_H__
+
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#ifdef FREETYPE_H
+#error "freetype.h of FreeType 1 has been loaded!"
+#error "Please fix the directory search order for header files"
+#error "so that freetype.h of FreeType 2 is found first."
+#endif
+
+
+FT_BEGIN_HEADER
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Section>                                                             */
+  /*    arena_memory                                                       */
+  /*                                                                       */
+  /* <Title>                                                               */
+  /*    Arena Memory                                                       */
+  /*                                                                       */
+  /* <Abstract>                                                            */
+  /*    A bump allocator implementing the @FT_Memory interface.            */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Opening and closing a face allocates and releases a large number   */
+  /*    of small memory blocks.  Applications that only open a face to     */
+  /*    extract some metadata and close it immediately afterwards can      */
+  /*    avoid most of this work with an `arena' memory manager: blocks     */
+  /*    are carved out of large chunks, individual frees are ignored, and  */
+  /*    everything is given back at once.                                  */
+  /*                                                                       */
+  /*    An arena is created with @FT_Arena_New and passed to               */
+  /*    @FT_New_Library.  Use @FT_Arena_Mark and @FT_Arena_Release to      */
+  /*    discard all blocks allocated after a given point, for example      */
+  /*    after @FT_Done_Library.  The font drivers recognize arena memory   */
+  /*    and skip most of their per-object clean-up in this case.           */
+  /*                                                                       */
+  /*    Arena memory never shrinks the memory footprint while in use;      */
+  /*    it is thus not suited for long-living library objects that open    */
+  /*    and close many faces.                                              */
+  /*                                                                       */
+  /*************************************************************************/
+
+
+  /*************************************************************************
+   *
+   * @type:
+   *   FT_ArenaMark
+   *
+   * @description:
+   *   An opaque value representing the fill level of an arena, as
+   *   returned by @FT_Arena_Mark.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef FT_ULong  FT_ArenaMark;
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Arena_New
+   *
+   * @description:
+   *   Create a new arena memory manager.
+   *
+   * @input:
+   *   parent ::
+   *     The memory manager used to allocate the arena's chunks.
+   *
+   *   chunk_size ::
+   *     The size of a single chunk in bytes.  Blocks larger than this
+   *     value get a chunk of their own.  If set to~0, a default value of
+   *     64kByte is used.
+   *
+   * @output:
+   *   aarena ::
+   *     A handle to the new memory manager.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The arena must outlive all objects allocated from it.  In
+   *   particular, if used with @FT_New_Library, @FT_Done_Library must be
+   *   called before @FT_Arena_Done.
+   *
+   *   No memory is requested from `parent' before the first allocation.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_Error )
+  FT_Arena_New( FT_Memory   parent,
+                FT_ULong    chunk_size,
+                FT_Memory  *aarena );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Arena_Done
+   *
+   * @description:
+   *   Destroy an arena memory manager, releasing all of its chunks to
+   *   the parent memory manager.
+   *
+   * @input:
+   *   arena ::
+   *     A handle to the arena.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( void )
+  FT_Arena_Done( FT_Memory  arena );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Arena_Mark
+   *
+   * @description:
+   *   Retrieve the current fill level of an arena.
+   *
+   * @input:
+   *   arena ::
+   *     A handle to the arena.
+   *
+   * @return:
+   *   The current fill level, to be used with @FT_Arena_Release.  If
+   *   `arena' is not an arena memory manager, the return value is~0.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_ArenaMark )
+  FT_Arena_Mark( FT_Memory  arena );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Arena_Release
+   *
+   * @description:
+   *   Discard all blocks allocated from an arena since a given mark.
+   *
+   * @input:
+   *   arena ::
+   *     A handle to the arena.
+   *
+   *   mark ::
+   *     A value returned by an earlier call to @FT_Arena_Mark.  Use~0 to
+   *     discard all blocks.
+   *
+   * @note:
+   *   Chunks that become unused are kept for later allocations; they are
+   *   only given back to the parent memory manager by @FT_Arena_Done.
+   *
+   *   All objects allocated after `mark' must no longer be in use.  For
+   *   example, a typical scoped use looks like this.
+   *
+   *   {
+   *     FT_ArenaMark  mark = FT_Arena_Mark( arena );
+   *
+   *
+   *     error = FT_New_Library( arena, &library );
+   *     ...
+   *     FT_Done_Library( library );
+   *     FT_Arena_Release( arena, mark );
+   *   }
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( void )
+  FT_Arena_Release( FT_Memory     arena,
+                    FT_ArenaMark  mark );
+
+  /* */
+
+
+FT_END_HEADER
+
+#endif /* __FTARENA_H__ */
+
+
+/* END */
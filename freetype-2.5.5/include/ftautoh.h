@@ -391,6 +391,120 @@ FT_BEGIN_HEADER
 
   } FT_Prop_IncreaseXHeight;
 
+
+  /**************************************************************************
+   *
+   * @property:
+   *   globals-data
+   *
+   * @description:
+   *   Before the auto-hinter can process the first glyph of a face, it
+   *   assigns a style to every glyph (see @glyph-to-script-map), and for
+   *   every style it actually uses, it computes blue zones and standard
+   *   widths from a set of reference glyphs.  For large fonts, this
+   *   global analysis can take much longer than hinting a single glyph.
+   *
+   *   The `globals-data' property gives access to the analysis results of
+   *   a face as a block of bytes that can be stored by the application
+   *   (for example, in a disk cache) and handed back to the auto-hinter
+   *   after opening the same font again, skipping the analysis.
+   *
+   *   Reading the property fills `data' with the style of every glyph,
+   *   together with the global metrics of all styles computed so far;
+   *   reading it after rendering some text thus gives more complete data.
+   *   If `data' is NULL, only the necessary buffer size is returned in
+   *   `length'.
+   *
+   *   {
+   *     FT_Library           library;
+   *     FT_Face              face;
+   *     FT_Prop_GlobalsData  prop;
+   *
+   *
+   *     FT_Init_FreeType( &library );
+   *     FT_New_Face( library, "foo.ttf", 0, &face );
+   *
+   *     prop.face   = face;
+   *     prop.data   = NULL;
+   *     prop.length = 0;
+   *
+   *     FT_Property_Get( library, "autofitter", "globals-data", &prop );
+   *     prop.data = malloc( prop.length );
+   *     FT_Property_Get( library, "autofitter", "globals-data", &prop );
+   *
+   *     ... store `prop.data' ...
+   *   }
+   *
+   *   Setting the property replaces the analysis results of the face with
+   *   the given data.
+   *
+   *   {
+   *     FT_New_Face( library, "foo.ttf", 0, &face );
+   *
+   *     prop.face   = face;
+   *     prop.data   = cached_data;
+   *     prop.length = cached_length;
+   *
+   *     error = FT_Property_Set( library, "autofitter",
+   *                                       "globals-data", &prop );
+   *   }
+   *
+   * @note:
+   *   The data contains a fingerprint of the face, derived from the table
+   *   checksums of SFNT-based fonts and from the whole font file
+   *   otherwise, and of the @fallback-script and @default-script
+   *   properties.  Values are stored field by field in big-endian byte
+   *   order, so the data does not depend on the compiler or platform;
+   *   its format may change between FreeType versions, though.  A
+   *   checksum protects the data against corruption, and all counts are
+   *   checked against their limits.  If any of these checks fails,
+   *   setting the property fails with `FT_Err_Invalid_Argument' and the
+   *   auto-hinter analyzes the face as usual.  `length' must be exactly
+   *   the size returned when reading the property.
+   *
+   *   Reading the property fails with `FT_Err_Invalid_Argument' if
+   *   `length' is too small; `length' is then set to the necessary size.
+   *
+   *   Set this property right after opening the face, before loading any
+   *   glyph (using the auto-hinter).
+   *
+   * @since:
+   *   2.6
+   *
+   */
+
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   FT_Prop_GlobalsData
+   *
+   * @description:
+   *   The data exchange structure for the @globals-data property.
+   *
+   * @fields:
+   *   face ::
+   *     The face.
+   *
+   *   data ::
+   *     The buffer holding the data.
+   *
+   *   length ::
+   *     The size of `data' in bytes.  When reading the property, this is
+   *     an input and output value.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  typedef struct  FT_Prop_GlobalsData_
+  {
+    FT_Face   face;
+    FT_Byte*  data;
+    FT_ULong  length;
+
+  } FT_Prop_GlobalsData;
+
   /* */
 
 
@@ -22,6 +22,7 @@
 
 #include <ft2build.h>
 #include FT_GLYPH_H
+#include FT_STROKER_H
 
 
 FT_BEGIN_HEADER
@@ -97,6 +98,10 @@ FT_BEGIN_HEADER
    *   bitmaps directly.  (A small bitmap is one whose metrics and
    *   dimensions all fit into 8-bit integers).
    *
+   *   Stroked glyph images (for example, halos around text) can be cached
+   *   with @FTC_StrokeCache_New and @FTC_StrokeCache_Lookup, avoiding
+   *   to stroke the same glyph outlines again and again.
+   *
    *   We hope to also provide a kerning cache in the near future.
    *
    *
@@ -124,6 +129,12 @@ FT_BEGIN_HEADER
    *   FTC_SBitCache_New
    *   FTC_SBitCache_Lookup
    *
+   *   FTC_StrokeTypeRec
+   *   FTC_StrokeType
+   *   FTC_StrokeCache
+   *   FTC_StrokeCache_New
+   *   FTC_StrokeCache_Lookup
+   *
    *   FTC_CMapCache
    *   FTC_CMapCache_New
    *   FTC_CMapCache_Lookup
@@ -540,6 +551,49 @@ FT_BEGIN_HEADER
                             FTC_FaceID   face_id );
 
 
+  /*************************************************************************
+   *
+   * @function:
+   *   FTC_Manager_GetCacheStats
+   *
+   * @description:
+   *   Retrieve the lookup statistics of a cache.
+   *
+   * @input:
+   *   manager ::
+   *     The cache manager handle.
+   *
+   *   cache_index ::
+   *     The index of the cache.  Caches are numbered in the order of
+   *     their creation with @FTC_CMapCache_New, @FTC_ImageCache_New,
+   *     @FTC_SBitCache_New, or @FTC_StrokeCache_New, starting with~0.
+   *
+   * @output:
+   *   ahits ::
+   *     The number of lookups which found an existing node.  Can be NULL.
+   *
+   *   amisses ::
+   *     The number of lookups which had to create a new node.  Can be
+   *     NULL.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  An invalid `cache_index'
+   *   value returns `FT_Err_Invalid_Argument'.
+   *
+   * @note:
+   *   The sums over all caches are available as library counters; see
+   *   @FT_Counter.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_Error )
+  FTC_Manager_GetCacheStats( FTC_Manager  manager,
+                             FT_UInt      cache_index,
+                             FT_ULong    *ahits,
+                             FT_ULong    *amisses );
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Section>                                                             */
@@ -1046,6 +1100,168 @@ FT_BEGIN_HEADER
                               FTC_SBit      *sbit,
                               FTC_Node      *anode );
 
+
+  /*************************************************************************
+   *
+   * @struct:
+   *   FTC_StrokeTypeRec
+   *
+   * @description:
+   *   A structure used to model the type of images in a stroked glyph
+   *   cache.
+   *
+   * @fields:
+   *   image ::
+   *     The face ID, the size, and the load flags of the glyphs.  If the
+   *     load flags contain @FT_LOAD_RENDER, the stroked outline is
+   *     rendered with the mode given by @FT_LOAD_TARGET_MODE (or
+   *     @FT_RENDER_MODE_MONO for @FT_LOAD_MONOCHROME).
+   *
+   *   radius ::
+   *     The border radius, as in @FT_Stroker_Set.
+   *
+   *   line_cap ::
+   *     The line cap style.
+   *
+   *   line_join ::
+   *     The line join style.
+   *
+   *   miter_limit ::
+   *     The miter limit for the @FT_STROKER_LINEJOIN_MITER_FIXED and
+   *     @FT_STROKER_LINEJOIN_MITER_VARIABLE line join styles, expressed
+   *     as 16.16 fixed-point value.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  typedef struct  FTC_StrokeTypeRec_
+  {
+    FTC_ImageTypeRec     image;
+    FT_Fixed             radius;
+    FT_Stroker_LineCap   line_cap;
+    FT_Stroker_LineJoin  line_join;
+    FT_Fixed             miter_limit;
+
+  } FTC_StrokeTypeRec;
+
+
+  /*************************************************************************
+   *
+   * @type:
+   *   FTC_StrokeType
+   *
+   * @description:
+   *   A handle to an @FTC_StrokeTypeRec structure.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  typedef struct FTC_StrokeTypeRec_*  FTC_StrokeType;
+
+
+  /*************************************************************************
+   *
+   * @type:
+   *   FTC_StrokeCache
+   *
+   * @description:
+   *   A handle to a stroked glyph image cache object.  It holds glyph
+   *   images stroked with @FT_Glyph_Stroke, either as outlines or as
+   *   bitmaps.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  typedef struct FTC_StrokeCacheRec_*  FTC_StrokeCache;
+
+
+  /*************************************************************************
+   *
+   * @function:
+   *   FTC_StrokeCache_New
+   *
+   * @description:
+   *   Create a new stroked glyph image cache.
+   *
+   * @input:
+   *   manager ::
+   *     The parent manager for the cache.
+   *
+   * @output:
+   *   acache ::
+   *     A handle to the new stroked glyph image cache object.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  FT_EXPORT( FT_Error )
+  FTC_StrokeCache_New( FTC_Manager       manager,
+                       FTC_StrokeCache  *acache );
+
+
+  /*************************************************************************
+   *
+   * @function:
+   *   FTC_StrokeCache_Lookup
+   *
+   * @description:
+   *   Retrieve a given stroked glyph image from a stroked glyph image
+   *   cache.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source stroked glyph image cache.
+   *
+   *   type ::
+   *     A pointer to a stroked glyph image type descriptor.
+   *
+   *   gindex ::
+   *     The glyph index to retrieve.
+   *
+   * @output:
+   *   aglyph ::
+   *     The corresponding @FT_Glyph object, either an @FT_OutlineGlyph
+   *     or an @FT_BitmapGlyph.  0~in case of failure.
+   *
+   *   anode ::
+   *     Used to return the address of the corresponding cache node
+   *     after incrementing its reference count (see note below).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  Glyphs which aren't
+   *   outlines (for example, embedded bitmaps) return
+   *   `FT_Err_Invalid_Glyph_Format'; use @FT_LOAD_NO_BITMAP to avoid
+   *   them.
+   *
+   * @note:
+   *   The result is the same as loading the glyph with the image's load
+   *   flags (minus @FT_LOAD_RENDER), stroking it with @FT_Glyph_Stroke,
+   *   and rendering it with @FT_Glyph_To_Bitmap if requested.
+   *
+   *   The returned glyph is owned and managed by the cache.  Never try to
+   *   transform or discard it manually!  You can however create a copy
+   *   with @FT_Glyph_Copy and modify the new one.
+   *
+   *   The meaning of `anode' is the same as with @FTC_ImageCache_Lookup.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  FT_EXPORT( FT_Error )
+  FTC_StrokeCache_Lookup( FTC_StrokeCache  cache,
+                          FTC_StrokeType   type,
+                          FT_UInt          gindex,
+                          FT_Glyph        *aglyph,
+                          FTC_Node        *anode );
+
   /* */
 
 
@@ -112,6 +112,9 @@
 /*    raster                                                               */
 /*    glyph_stroker                                                        */
 /*    system_interface                                                     */
+/*    arena_memory                                                         */
+/*    memory_profiler                                                      */
+/*    performance_counters                                                 */
 /*    module_management                                                    */
 /*    gzip                                                                 */
 /*    lzw                                                                  */
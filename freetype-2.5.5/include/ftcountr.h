@@ -0,0 +1,298 @@
+/***************************************************************************/
+/*                                                                         */
+/*  ftcountr.h                                                             */
+/*                                                                         */
+/*    FreeType performance counters (specification).                       */
+/*                                                                         */
+/*  Copyright 2026 by                                                      */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+#ifndef __FTCOUNTR_H__
+#define __FTCOUNTR_H__
+
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#ifdef FREETYPE_H
+#error "freetype.h of FreeType 1 has been loaded!"
+#error "Please fix the directory search order for header files"
+#error "so that freetype.h of FreeType 2 is found first."
+#endif
+
+
+FT_BEGIN_HEADER
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Section>                                                             */
+  /*    performance_counters                                               */
+  /*                                                                       */
+  /* <Title>                                                               */
+  /*    Performance Counters                                               */
+  /*                                                                       */
+  /* <Abstract>                                                            */
+  /*    Event counters and timers of the library's hot paths.              */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    If FreeType is compiled with the `FT_CONFIG_OPTION_COUNTERS'       */
+  /*    macro (which is the default), each library object counts the      */
+  /*    glyphs loaded by its font drivers, the bytecode instructions       */
+  /*    executed, the cells generated by the smooth rasterizer, the hits   */
+  /*    and misses of the cache sub-system, and similar events.  Updating  */
+  /*    a counter costs a single addition; most of them are updated once   */
+  /*    per glyph or per rendering call only.                              */
+  /*                                                                       */
+  /*    Timers are only active after a clock function has been installed  */
+  /*    with @FT_Set_Counter_Clock; FreeType itself doesn't depend on any  */
+  /*    system timer.                                                      */
+  /*                                                                       */
+  /*************************************************************************/
+
+
+  /*************************************************************************
+   *
+   * @enum:
+   *   FT_Counter
+   *
+   * @description:
+   *   A list of the counters maintained by a library object.
+   *
+   * @values:
+   *   FT_COUNTER_GLYPH_LOADS ::
+   *     The number of glyphs loaded by the font drivers.  Use
+   *     @FT_Get_Driver_Glyph_Loads to get the number per font driver.
+   *     A glyph loaded through the auto-hinter is counted once, since the
+   *     auto-hinter calls @FT_Load_Glyph itself to get the unhinted
+   *     outline.
+   *
+   *   FT_COUNTER_AUTOHINT_LOADS ::
+   *     The number of glyphs loaded through the auto-hinter.
+   *
+   *   FT_COUNTER_LOAD_TIME ::
+   *     The clock ticks spent in the glyph loading functions of the font
+   *     drivers, including native hinting.
+   *
+   *   FT_COUNTER_HINTING_TIME ::
+   *     The clock ticks spent in the auto-hinter, in the TrueType glyph
+   *     programs, and in the PostScript hinter.  Note that this timer
+   *     overlaps with `FT_COUNTER_LOAD_TIME'.
+   *
+   *   FT_COUNTER_INSTRUCTIONS ::
+   *     The number of TrueType bytecode instructions executed.
+   *
+   *   FT_COUNTER_RASTER_CELLS ::
+   *     The number of cells generated by the smooth rasterizer.
+   *
+   *   FT_COUNTER_BAND_SPLITS ::
+   *     The number of times the smooth rasterizer had to split a band
+   *     because its render pool overflowed.
+   *
+   *   FT_COUNTER_CACHE_HITS ::
+   *     The number of cache node lookups that succeeded, summed over all
+   *     caches of all cache managers.  Use @FTC_Manager_GetCacheStats to
+   *     get the values of a single cache.
+   *
+   *   FT_COUNTER_CACHE_MISSES ::
+   *     The number of cache node lookups that had to create a new node.
+   *
+   *   FT_COUNTER_STREAM_BYTES ::
+   *     The number of bytes read or accessed through streams.
+   *
+   *   FT_COUNTER_ALLOCATIONS ::
+   *     The number of memory block allocations and reallocations.
+   *
+   *   FT_COUNTER_MAX ::
+   *     The number of counters.
+   *
+   * @note:
+   *   Streams and memory managers don't know about library objects;
+   *   `FT_COUNTER_STREAM_BYTES' and `FT_COUNTER_ALLOCATIONS' are thus
+   *   process-wide values, counting the events of all library objects
+   *   since the last call to @FT_Reset_Counters for the given library.
+   *   They are not available if FreeType is compiled with
+   *   `FT_CONFIG_OPTION_PIC'.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef enum  FT_Counter_
+  {
+    FT_COUNTER_GLYPH_LOADS = 0,
+    FT_COUNTER_AUTOHINT_LOADS,
+    FT_COUNTER_LOAD_TIME,
+    FT_COUNTER_HINTING_TIME,
+    FT_COUNTER_INSTRUCTIONS,
+    FT_COUNTER_RASTER_CELLS,
+    FT_COUNTER_BAND_SPLITS,
+    FT_COUNTER_CACHE_HITS,
+    FT_COUNTER_CACHE_MISSES,
+    FT_COUNTER_STREAM_BYTES,
+    FT_COUNTER_ALLOCATIONS,
+
+    FT_COUNTER_MAX
+
+  } FT_Counter;
+
+
+  /*************************************************************************
+   *
+   * @functype:
+   *   FT_Counter_ClockFunc
+   *
+   * @description:
+   *   A function returning the current time, in arbitrary but monotonic
+   *   ticks.  It is called twice per timed section and should be as
+   *   cheap as possible.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef FT_ULong
+  (*FT_Counter_ClockFunc)( void );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Get_Counter
+   *
+   * @description:
+   *   Retrieve the value of a counter.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library.
+   *
+   *   counter ::
+   *     The counter; see @FT_Counter.
+   *
+   * @return:
+   *   The value of the counter.  Invalid arguments, and counters not
+   *   available in this build, return~0.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_ULong )
+  FT_Get_Counter( FT_Library  library,
+                  FT_UInt     counter );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Get_Counter_Name
+   *
+   * @description:
+   *   Retrieve a short name of a counter, for example `glyph_loads'.
+   *
+   * @input:
+   *   counter ::
+   *     The counter; see @FT_Counter.
+   *
+   * @return:
+   *   The name, or NULL for invalid values of `counter'.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( const char* )
+  FT_Get_Counter_Name( FT_UInt  counter );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Get_Driver_Glyph_Loads
+   *
+   * @description:
+   *   Retrieve the number of glyphs loaded by a font driver.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library.
+   *
+   *   driver_name ::
+   *     The name of the font driver, for example `truetype' or `cff'.
+   *
+   * @return:
+   *   The number of glyphs loaded since the last call to
+   *   @FT_Reset_Counters.  Unknown driver names return~0.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_ULong )
+  FT_Get_Driver_Glyph_Loads( FT_Library   library,
+                             const char*  driver_name );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Reset_Counters
+   *
+   * @description:
+   *   Set all counters of a library object to zero, including the
+   *   per-driver values.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( void )
+  FT_Reset_Counters( FT_Library  library );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_Set_Counter_Clock
+   *
+   * @description:
+   *   Install the clock function used for the timers
+   *   `FT_COUNTER_LOAD_TIME' and `FT_COUNTER_HINTING_TIME'.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library.
+   *
+   *   clock ::
+   *     The clock function.  Use NULL to disable the timers, which is
+   *     the default.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *   `FT_Err_Unimplemented_Feature' is returned if FreeType has been
+   *   compiled without `FT_CONFIG_OPTION_COUNTERS'.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_Error )
+  FT_Set_Counter_Clock( FT_Library            library,
+                        FT_Counter_ClockFunc  clock );
+
+  /* */
+
+
+FT_END_HEADER
+
+#endif /* __FTCOUNTR_H__ */
+
+
+/* END */
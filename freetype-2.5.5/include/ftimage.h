@@ -952,10 +952,33 @@ FT_BEGIN_HEADER
   /*                              in direct rendering mode where all spans */
   /*                              are generated if no clipping box is set. */
   /*                                                                       */
+  /*    FT_RASTER_FLAG_STROKE  :: This flag is only used in anti-aliased   */
+  /*                              rendering mode.  If set, the outline is  */
+  /*                              stroked instead of filled, with a round  */
+  /*                              pen whose radius is given in the         */
+  /*                              `stroke_radius' field of the             */
+  /*                              @FT_Raster_Params structure.  Every      */
+  /*                              contour is treated as closed.  The       */
+  /*                              result is approximately the same as      */
+  /*                              filling the outline returned by          */
+  /*                              @FT_Glyph_Stroke with                    */
+  /*                              @FT_STROKER_LINEJOIN_ROUND; it differs   */
+  /*                              where the stroker's inner borders fold   */
+  /*                              over (for example, in contours smaller   */
+  /*                              than the pen, where the stroker leaves   */
+  /*                              holes), and this flag gives the correct  */
+  /*                              result there.  Since no intermediate     */
+  /*                              outline is built, this is considerably   */
+  /*                              faster.                                  */
+  /*                              Not supported by the monochrome          */
+  /*                              rasterizer (and the smooth one in        */
+  /*                              stand-alone mode).                       */
+  /*                                                                       */
 #define FT_RASTER_FLAG_DEFAULT  0x0
 #define FT_RASTER_FLAG_AA       0x1
 #define FT_RASTER_FLAG_DIRECT   0x2
 #define FT_RASTER_FLAG_CLIP     0x4
+#define FT_RASTER_FLAG_STROKE   0x8
 
   /* these constants are deprecated; use the corresponding */
   /* `FT_RASTER_FLAG_XXX' values instead                   */
@@ -998,6 +1021,11 @@ FT_BEGIN_HEADER
   /*                   should be expressed in _integer_ pixels (and not in */
   /*                   26.6 fixed-point units).                            */
   /*                                                                       */
+  /*    stroke_radius :: The pen radius in 26.6 fixed-point units, i.e.,   */
+  /*                     half the stroke width.  It is only used if        */
+  /*                     @FT_RASTER_FLAG_STROKE is set and must be         */
+  /*                     positive then.  Since FreeType 2.6.               */
+  /*                                                                       */
   /* <Note>                                                                */
   /*    An anti-aliased glyph bitmap is drawn if the @FT_RASTER_FLAG_AA    */
   /*    bit flag is set in the `flags' field, otherwise a monochrome       */
@@ -1020,6 +1048,7 @@ FT_BEGIN_HEADER
     FT_Raster_BitSet_Func   bit_set;      /* unused */
     void*                   user;
     FT_BBox                 clip_box;
+    FT_Pos                  stroke_radius;
 
   } FT_Raster_Params;
 
@@ -0,0 +1,378 @@
+/***************************************************************************/
+/*                                                                         */
+/*  ftmemprf.h                                                             */
+/*                                                                         */
+/*    FreeType allocation profiler (specification).                        */
+/*                                                                         */
+/*  Copyright 2026 by                                                      */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+#ifndef __FTMEMPRF_H__
+#define __FTMEMPRF_H__
+
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#ifdef FREETYPE_H
+#error "freetype.h of FreeType 1 has been loaded!"
+#error "Please fix the directory search order for header files"
+#error "so that freetype.h of FreeType 2 is found first."
+#endif
+
+
+FT_BEGIN_HEADER
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Section>                                                             */
+  /*    memory_profiler                                                    */
+  /*                                                                       */
+  /* <Title>                                                               */
+  /*    Allocation Profiler                                                */
+  /*                                                                       */
+  /* <Abstract>                                                            */
+  /*    Per-call-site allocation statistics.                               */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    If FreeType is compiled with the `FT_DEBUG_MEMORY' macro, the      */
+  /*    memory manager returned by @FT_New_Memory records statistics for   */
+  /*    every source location which allocates memory.  This happens if     */
+  /*    one of the following environment variables is defined at runtime.  */
+  /*                                                                       */
+  /*      FT2_DEBUG_MEMORY ::                                              */
+  /*        The full memory debugger, which also detects leaks and double  */
+  /*        frees; see file `docs/DEBUG' for details.                      */
+  /*                                                                       */
+  /*      FT2_DEBUG_MEMORY_PROFILE ::                                      */
+  /*        A lightweight profiler, which only keeps the per-site          */
+  /*        statistics.  It uses a small header per block instead of a     */
+  /*        separate tracking node and is thus cheap enough for            */
+  /*        production builds.                                             */
+  /*                                                                       */
+  /*    The functions in this section take snapshots of these statistics   */
+  /*    and convert them into the `folded stacks' format understood by     */
+  /*    flame graph tools.                                                 */
+  /*                                                                       */
+  /*************************************************************************/
+
+
+  /*************************************************************************
+   *
+   * @enum:
+   *   FT_MEM_PROFILE_GROWTH_BUCKETS
+   *
+   * @description:
+   *   The number of buckets in the reallocation growth histogram of
+   *   @FT_MemProfileSiteRec.
+   *
+   *   Bucket~0 counts reallocations that shrink a block.  Bucket~n, for
+   *   n~>~0, counts reallocations growing a block by at least 8^(n-1)
+   *   bytes and less than 8^n~bytes; the last bucket is unbounded.
+   *
+   * @since:
+   *   2.6
+   */
+#define FT_MEM_PROFILE_GROWTH_BUCKETS  8
+
+
+  /*************************************************************************
+   *
+   * @struct:
+   *   FT_MemProfileSiteRec
+   *
+   * @description:
+   *   Allocation statistics of a single source location.
+   *
+   * @fields:
+   *   file_name ::
+   *     The source file name, as given by `__FILE__'.
+   *
+   *   line_no ::
+   *     The source line number.
+   *
+   *   cur_blocks ::
+   *     The number of blocks currently allocated.
+   *
+   *   max_blocks ::
+   *     The maximum value of `cur_blocks'.
+   *
+   *   all_blocks ::
+   *     The total number of blocks allocated.
+   *
+   *   new_blocks ::
+   *     The number of blocks allocated since the previous snapshot.
+   *     Dividing this value by the time elapsed between two snapshots
+   *     gives the allocation rate.
+   *
+   *   cur_size ::
+   *     The current cumulative size of allocated blocks.
+   *
+   *   max_size ::
+   *     The maximum value of `cur_size'.
+   *
+   *   all_size ::
+   *     The total size of all allocations.
+   *
+   *   new_size ::
+   *     The total size of allocations since the previous snapshot.
+   *
+   *   reallocs ::
+   *     The number of reallocations performed at this location.
+   *
+   *   growth ::
+   *     A histogram of the size changes of these reallocations; see
+   *     @FT_MEM_PROFILE_GROWTH_BUCKETS.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef struct  FT_MemProfileSiteRec_
+  {
+    const char*  file_name;
+    FT_Long      line_no;
+
+    FT_Long      cur_blocks;
+    FT_Long      max_blocks;
+    FT_Long      all_blocks;
+    FT_Long      new_blocks;
+
+    FT_Long      cur_size;
+    FT_Long      max_size;
+    FT_Long      all_size;
+    FT_Long      new_size;
+
+    FT_Long      reallocs;
+    FT_Long      growth[FT_MEM_PROFILE_GROWTH_BUCKETS];
+
+  } FT_MemProfileSiteRec, *FT_MemProfileSite;
+
+
+  /*************************************************************************
+   *
+   * @struct:
+   *   FT_MemProfileRec
+   *
+   * @description:
+   *   A snapshot of the allocation statistics, as returned by
+   *   @FT_MemProfile_Snapshot.
+   *
+   * @fields:
+   *   alloc_current ::
+   *     The number of bytes currently allocated.
+   *
+   *   alloc_max ::
+   *     The maximum value of `alloc_current'.
+   *
+   *   alloc_total ::
+   *     The total number of bytes allocated.
+   *
+   *   alloc_count ::
+   *     The number of blocks currently allocated.
+   *
+   *   num_sites ::
+   *     The number of elements in `sites'.
+   *
+   *   sites ::
+   *     The allocation sites, sorted by decreasing `all_size' values.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef struct  FT_MemProfileRec_
+  {
+    FT_ULong           alloc_current;
+    FT_ULong           alloc_max;
+    FT_ULong           alloc_total;
+    FT_ULong           alloc_count;
+
+    FT_UInt            num_sites;
+    FT_MemProfileSite  sites;
+
+  } FT_MemProfileRec, *FT_MemProfile;
+
+
+  /*************************************************************************
+   *
+   * @enum:
+   *   FT_MemProfile_Metric
+   *
+   * @description:
+   *   The value emitted per site by @FT_MemProfile_Fold.
+   *
+   * @values:
+   *   FT_MEM_PROFILE_METRIC_ALL_SIZE ::
+   *     The `all_size' field of @FT_MemProfileSiteRec.
+   *
+   *   FT_MEM_PROFILE_METRIC_ALL_BLOCKS ::
+   *     The `all_blocks' field.
+   *
+   *   FT_MEM_PROFILE_METRIC_NEW_SIZE ::
+   *     The `new_size' field.
+   *
+   *   FT_MEM_PROFILE_METRIC_NEW_BLOCKS ::
+   *     The `new_blocks' field.
+   *
+   *   FT_MEM_PROFILE_METRIC_CUR_SIZE ::
+   *     The `cur_size' field.
+   *
+   *   FT_MEM_PROFILE_METRIC_REALLOCS ::
+   *     The `reallocs' field.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef enum  FT_MemProfile_Metric_
+  {
+    FT_MEM_PROFILE_METRIC_ALL_SIZE = 0,
+    FT_MEM_PROFILE_METRIC_ALL_BLOCKS,
+    FT_MEM_PROFILE_METRIC_NEW_SIZE,
+    FT_MEM_PROFILE_METRIC_NEW_BLOCKS,
+    FT_MEM_PROFILE_METRIC_CUR_SIZE,
+    FT_MEM_PROFILE_METRIC_REALLOCS
+
+  } FT_MemProfile_Metric;
+
+
+  /*************************************************************************
+   *
+   * @functype:
+   *   FT_MemProfile_LineFunc
+   *
+   * @description:
+   *   A function receiving the lines produced by @FT_MemProfile_Fold.
+   *
+   * @input:
+   *   line ::
+   *     A zero-terminated line, including the final newline character.
+   *
+   *   user ::
+   *     The user data passed to @FT_MemProfile_Fold.
+   *
+   * @since:
+   *   2.6
+   */
+  typedef void
+  (*FT_MemProfile_LineFunc)( const char*  line,
+                             void*        user );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_MemProfile_Snapshot
+   *
+   * @description:
+   *   Take a snapshot of the allocation statistics of a library's memory
+   *   manager.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library.
+   *
+   * @output:
+   *   aprofile ::
+   *     The snapshot.  Release it with @FT_MemProfile_Done.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  If the memory manager
+   *   doesn't collect statistics, `FT_Err_Unimplemented_Feature' is
+   *   returned.
+   *
+   * @note:
+   *   The snapshot itself is allocated without being tracked.  Each call
+   *   resets the baseline of the `new_blocks' and `new_size' fields of
+   *   @FT_MemProfileSiteRec.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_Error )
+  FT_MemProfile_Snapshot( FT_Library      library,
+                          FT_MemProfile  *aprofile );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_MemProfile_Done
+   *
+   * @description:
+   *   Release a snapshot created with @FT_MemProfile_Snapshot.
+   *
+   * @input:
+   *   library ::
+   *     A handle to the library.
+   *
+   *   profile ::
+   *     The snapshot.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( void )
+  FT_MemProfile_Done( FT_Library     library,
+                      FT_MemProfile  profile );
+
+
+  /*************************************************************************
+   *
+   * @func:
+   *   FT_MemProfile_Fold
+   *
+   * @description:
+   *   Write a snapshot in the `folded stacks' format used by flame graph
+   *   tools, one line per allocation site.  A line looks like
+   *
+   *   {
+   *     freetype;cff;cffload.c:1234 56789
+   *   }
+   *
+   *   where the frames are the library, the module directory, and the
+   *   source location, followed by the selected metric.  Sites with a
+   *   zero value are omitted.
+   *
+   * @input:
+   *   profile ::
+   *     The snapshot.
+   *
+   *   metric ::
+   *     The value to emit; see @FT_MemProfile_Metric.
+   *
+   *   func ::
+   *     The function receiving the lines.
+   *
+   *   user ::
+   *     User data passed to `func'.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.6
+   */
+  FT_EXPORT( FT_Error )
+  FT_MemProfile_Fold( FT_MemProfile           profile,
+                      FT_MemProfile_Metric    metric,
+                      FT_MemProfile_LineFunc  func,
+                      void*                   user );
+
+  /* */
+
+
+FT_END_HEADER
+
+#endif /* __FTMEMPRF_H__ */
+
+
+/* END */
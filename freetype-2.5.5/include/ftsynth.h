@@ -71,6 +71,40 @@ FT_BEGIN_HEADER
   FT_EXPORT( void )
   FT_GlyphSlot_Oblique( FT_GlyphSlot  slot );
 
+  /* Flags for @FT_GlyphSlot_Synthesize and @FT_Load_Glyph_Synthesized,    */
+  /* selecting the effects of @FT_GlyphSlot_Embolden and                   */
+  /* @FT_GlyphSlot_Oblique, respectively.                                  */
+#define FT_SYNTHESIS_EMBOLDEN  0x1
+#define FT_SYNTHESIS_OBLIQUE   0x2
+
+  /* Embolden and/or slant a glyph as selected by `flags', then transform  */
+  /* it by `matrix' and translate it by `delta' (both may be NULL).  For   */
+  /* outlines, this is done in a single pass over the points, with the     */
+  /* same result as calling @FT_GlyphSlot_Embolden,                        */
+  /* @FT_GlyphSlot_Oblique, @FT_Outline_Transform, and                     */
+  /* @FT_Outline_Translate in sequence.  The glyph's advance vector gets   */
+  /* transformed by `matrix', too.  Bitmap glyphs are only emboldened.     */
+  /*                                                                       */
+  /* The outline orientation needed for emboldening is computed once per   */
+  /* loaded glyph and updated for the applied transformations.  If you     */
+  /* reverse or mirror the slot's outline yourself, load it again before   */
+  /* calling this function.                                                */
+  FT_EXPORT( FT_Error )
+  FT_GlyphSlot_Synthesize( FT_GlyphSlot      slot,
+                           FT_UInt           flags,
+                           const FT_Matrix*  matrix,
+                           const FT_Vector*  delta );
+
+  /* Load a glyph like @FT_Load_Glyph and apply the synthetic styles       */
+  /* selected by `synthesis_flags' before the transformation set with      */
+  /* @FT_Set_Transform, in a single pass.  If `load_flags' contains        */
+  /* FT_LOAD_RENDER, the result gets rendered afterwards.                  */
+  FT_EXPORT( FT_Error )
+  FT_Load_Glyph_Synthesized( FT_Face   face,
+                             FT_UInt   glyph_index,
+                             FT_Int32  load_flags,
+                             FT_UInt   synthesis_flags );
+
   /* */
 
 
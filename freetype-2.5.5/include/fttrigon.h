@@ -339,6 +339,82 @@ FT_BEGIN_HEADER
                         FT_Fixed    length,
                         FT_Angle    angle );
 
+
+  /*************************************************************************
+   *
+   * @function:
+   *   FT_Vector_Polarize_Array
+   *
+   * @description:
+   *   Compute the lengths and angles of an array of vectors.  This is
+   *   faster than calling @FT_Vector_Length and @FT_Atan2 for each
+   *   vector, and gives the same results.
+   *
+   * @input:
+   *   vecs ::
+   *     The source vectors.
+   *
+   *   count ::
+   *     The number of vectors.
+   *
+   * @output:
+   *   lengths ::
+   *     An array of `count' elements for the vector lengths.  Can be
+   *     NULL.
+   *
+   *   angles ::
+   *     An array of `count' elements for the vector angles.  Can be
+   *     NULL.
+   *
+   * @note:
+   *   Contrary to @FT_Vector_Polarize, the lengths are rounded, and zero
+   *   vectors get zero length and angle.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  FT_EXPORT( void )
+  FT_Vector_Polarize_Array( const FT_Vector*  vecs,
+                            FT_UInt           count,
+                            FT_Fixed*         lengths,
+                            FT_Angle*         angles );
+
+
+  /*************************************************************************
+   *
+   * @function:
+   *   FT_Vector_From_Polar_Array
+   *
+   * @description:
+   *   Compute the coordinates of an array of vectors from their lengths
+   *   and angles.  This is faster than calling @FT_Vector_From_Polar for
+   *   each vector, and gives the same results.
+   *
+   * @output:
+   *   vecs ::
+   *     The target vectors.
+   *
+   * @input:
+   *   count ::
+   *     The number of vectors.
+   *
+   *   lengths ::
+   *     The vector lengths.
+   *
+   *   angles ::
+   *     The vector angles.
+   *
+   * @since:
+   *   2.6
+   *
+   */
+  FT_EXPORT( void )
+  FT_Vector_From_Polar_Array( FT_Vector*       vecs,
+                              FT_UInt          count,
+                              const FT_Fixed*  lengths,
+                              const FT_Angle*  angles );
+
   /* */
 
 
@@ -239,12 +239,100 @@ FT_BEGIN_HEADER
 #endif /* !FT_CONFIG_OPTION_NO_ASSEMBLER */
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* With a native 64-bit type, the portable versions of FT_MulDiv(),      */
+  /* FT_MulFix(), and FT_DivFix() are short enough to be inlined.  They    */
+  /* give exactly the same results as the functions in `ftcalc.c' but     */
+  /* track the signs of the arguments without branches.                    */
+  /*                                                                       */
+  /* Note that FT_MulFix_64() relies on an arithmetic right shift of       */
+  /* negative values, as do the assembler versions above.                  */
+  /*                                                                       */
+  /*************************************************************************/
+
+#ifdef FT_LONG64
+
+#if defined( __GNUC__ )
+#define FT_CALC_INLINE  static __inline__
+#elif defined( _MSC_VER )
+#define FT_CALC_INLINE  static __inline
+#elif defined( __STDC_VERSION__ ) && __STDC_VERSION__ >= 199901L
+#define FT_CALC_INLINE  static inline
+#endif
+
+#endif /* FT_LONG64 */
+
+
+#ifdef FT_CALC_INLINE
+
+  FT_CALC_INLINE FT_Long
+  FT_MulDiv_64( FT_Long  a,
+                FT_Long  b,
+                FT_Long  c )
+  {
+    FT_Long  s = a ^ b ^ c;
+    FT_Long  d;
+
+
+    a = a < 0 ? -a : a;
+    b = b < 0 ? -b : b;
+    c = c < 0 ? -c : c;
+
+    d = (FT_Long)( c > 0 ? ( (FT_Int64)a * b + ( c >> 1 ) ) / c
+                         : 0x7FFFFFFFL );
+
+    return s < 0 ? -d : d;
+  }
+
+
+  FT_CALC_INLINE FT_Long
+  FT_MulFix_64( FT_Long  a,
+                FT_Long  b )
+  {
+    FT_Int64  ab = (FT_Int64)a * b;
+
+
+    /* this rounds half away from zero, like the generic version */
+    return (FT_Long)( ( ab + 0x8000L - ( ab < 0 ) ) >> 16 );
+  }
+
+
+  FT_CALC_INLINE FT_Long
+  FT_DivFix_64( FT_Long  a,
+                FT_Long  b )
+  {
+    FT_Long  s = a ^ b;
+    FT_Long  q;
+
+
+    a = a < 0 ? -a : a;
+    b = b < 0 ? -b : b;
+
+    q = (FT_Long)( b > 0 ? ( ( (FT_UInt64)a << 16 ) + ( b >> 1 ) ) / b
+                         : 0x7FFFFFFFL );
+
+    return s < 0 ? -q : q;
+  }
+
+#endif /* FT_CALC_INLINE */
+
+
 #ifdef FT_CONFIG_OPTION_INLINE_MULFIX
+
 #ifdef FT_MULFIX_ASSEMBLER
 #define FT_MulFix( a, b )  FT_MULFIX_ASSEMBLER( (FT_Int32)(a), (FT_Int32)(b) )
+#elif defined( FT_CALC_INLINE )
+#define FT_MulFix( a, b )  FT_MulFix_64( a, b )
 #endif
+
+#ifdef FT_CALC_INLINE
+#define FT_MulDiv( a, b, c )  FT_MulDiv_64( a, b, c )
+#define FT_DivFix( a, b )     FT_DivFix_64( a, b )
 #endif
 
+#endif /* FT_CONFIG_OPTION_INLINE_MULFIX */
+
 
   /*************************************************************************/
   /*                                                                       */
@@ -275,6 +363,18 @@ FT_BEGIN_HEADER
                       FT_Long  c );
 
 
+  /*
+   *  Replace each of the `count' elements of `values' with
+   *  `FT_MulDiv(values[i],b,c)'.  This is faster than calling FT_MulDiv()
+   *  in a loop, in particular if `c' is a power of two.
+   */
+  FT_BASE( void )
+  ft_muldiv_array( FT_Long*  values,
+                   FT_UInt   count,
+                   FT_Long   b,
+                   FT_Long   c );
+
+
   /*
    *  A variant of FT_Matrix_Multiply which scales its result afterwards.
    *  The idea is that both `a' and `b' are scaled by factors of 10 so that
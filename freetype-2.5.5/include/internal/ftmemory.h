@@ -367,6 +367,13 @@ FT_BEGIN_HEADER
 #define FT_STRCPYN( dst, src, size )                                         \
           ft_mem_strcpyn( (char*)dst, (const char*)(src), (FT_ULong)(size) )
 
+
+  /* Return 1 if `memory' was created with `FT_Arena_New'.  In this  */
+  /* case, freeing blocks is a no-op, and object destructors may     */
+  /* skip the release of sub-objects which only hold memory.         */
+  FT_BASE( FT_Bool )
+  ft_mem_is_arena( FT_Memory  memory );
+
  /* */
 
 
@@ -36,6 +36,7 @@
 #include FT_INTERNAL_AUTOHINT_H
 #include FT_INTERNAL_SERVICE_H
 #include FT_INTERNAL_PIC_H
+#include FT_COUNTERS_H
 
 #ifdef FT_CONFIG_OPTION_INCREMENTAL
 #include FT_INCREMENTAL_H
@@ -384,10 +385,11 @@ FT_BEGIN_HEADER
   /*    loader            :: The glyph loader object used to load outlines */
   /*                         into the glyph slot.                          */
   /*                                                                       */
-  /*    flags             :: Possible values are zero or                   */
-  /*                         FT_GLYPH_OWN_BITMAP.  The latter indicates    */
-  /*                         that the FT_GlyphSlot structure owns the      */
-  /*                         bitmap buffer.                                */
+  /*    flags             :: A combination of FT_GLYPH_OWN_BITMAP, which   */
+  /*                         indicates that the FT_GlyphSlot structure     */
+  /*                         owns the bitmap buffer, and                   */
+  /*                         FT_GLYPH_HAS_ORIENTATION, which indicates     */
+  /*                         that `orientation' is valid.                  */
   /*                                                                       */
   /*    glyph_transformed :: Boolean.  Set to TRUE when the loaded glyph   */
   /*                         must be transformed through a specific        */
@@ -403,8 +405,14 @@ FT_BEGIN_HEADER
   /*                                                                       */
   /*    glyph_hints       :: Format-specific glyph hints management.       */
   /*                                                                       */
+  /*    orientation       :: The orientation of the loaded outline, as     */
+  /*                         returned by FT_Outline_Get_Orientation().     */
+  /*                         It is computed on demand by the synthesizing  */
+  /*                         functions and reset for each glyph load.      */
+  /*                                                                       */
 
-#define FT_GLYPH_OWN_BITMAP  0x1
+#define FT_GLYPH_OWN_BITMAP       0x1
+#define FT_GLYPH_HAS_ORIENTATION  0x2
 
   typedef struct  FT_Slot_InternalRec_
   {
@@ -414,6 +422,7 @@ FT_BEGIN_HEADER
     FT_Matrix       glyph_matrix;
     FT_Vector       glyph_delta;
     void*           glyph_hints;
+    FT_Int          orientation;
 
   } FT_GlyphSlot_InternalRec;
 
@@ -668,6 +677,23 @@ FT_BEGIN_HEADER
                            FT_Byte*      buffer );
 
 
+  /* Embolden an outline like FT_Outline_EmboldenXY() for the given       */
+  /* orientation, then slant it horizontally by `slant' (as in            */
+  /* FT_GlyphSlot_Oblique()), transform it by `matrix', and translate it  */
+  /* by `delta', all in a single pass over the points.  The last three    */
+  /* steps are optional (use zero or NULL), and there is no emboldening   */
+  /* if `orientation' is FT_ORIENTATION_NONE.  The result is the same as  */
+  /* that of the individual functions applied in sequence.                */
+  FT_BASE( FT_Error )
+  ft_outline_synthesize( FT_Outline*       outline,
+                         FT_Pos            xstrength,
+                         FT_Pos            ystrength,
+                         FT_Int            orientation,
+                         FT_Fixed          slant,
+                         const FT_Matrix*  matrix,
+                         const FT_Vector*  delta );
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -744,6 +770,9 @@ FT_BEGIN_HEADER
   /*                     driver.  This object isn't defined for unscalable */
   /*                     formats.                                          */
   /*                                                                       */
+  /*     glyph_loads  :: The number of glyphs loaded by this driver.  Only */
+  /*                     present if `FT_CONFIG_OPTION_COUNTERS' is set.    */
+  /*                                                                       */
   typedef struct  FT_DriverRec_
   {
     FT_ModuleRec     root;
@@ -751,6 +780,10 @@ FT_BEGIN_HEADER
     FT_ListRec       faces_list;
     FT_GlyphLoader   glyph_loader;
 
+#ifdef FT_CONFIG_OPTION_COUNTERS
+    FT_ULong         glyph_loads;
+#endif
+
   } FT_DriverRec;
 
 
@@ -784,6 +817,19 @@ FT_BEGIN_HEADER
                                             FT_Library      library );
 
 
+#ifdef FT_CONFIG_OPTION_SUBPIXEL_RENDERING
+
+  /* Apply the LCD filter set in `library' to a single row of `width'  */
+  /* subpixels of a horizontal LCD bitmap, in place.  Filtering all    */
+  /* rows this way is the same as calling `library->lcd_filter_func'.  */
+  FT_BASE( void )
+  ft_lcd_filter_line( FT_Library  library,
+                      FT_Byte*    line,
+                      FT_UInt     width );
+
+#endif
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Struct>                                                              */
@@ -853,6 +899,14 @@ FT_BEGIN_HEADER
   /*                        if the counter is~1, otherwise it simply       */
   /*                        decrements it.                                 */
   /*                                                                       */
+  /*    counters         :: If performance counters are activated, the     */
+  /*                        values of the @FT_Counter enumeration.  The    */
+  /*                        entries of process-wide counters hold the      */
+  /*                        global value at the time of the last reset.    */
+  /*                                                                       */
+  /*    counter_clock    :: If performance counters are activated, the     */
+  /*                        clock function of the timers, or NULL.         */
+  /*                                                                       */
   typedef struct  FT_LibraryRec_
   {
     FT_Memory          memory;           /* library's memory manager */
@@ -887,9 +941,77 @@ FT_BEGIN_HEADER
 
     FT_Int             refcount;
 
+#ifdef FT_CONFIG_OPTION_COUNTERS
+    FT_ULong              counters[FT_COUNTER_MAX];
+    FT_Counter_ClockFunc  counter_clock;
+#endif
+
   } FT_LibraryRec;
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* Glyphs can be loaded from different threads with the same library     */
+  /* object (for example, with different faces), and process-wide          */
+  /* counters are shared by all library objects; all counters are thus     */
+  /* updated with relaxed atomic additions if the compiler provides them.  */
+  /*                                                                       */
+  /* `FT_TIMER_VAR' declares a local variable holding the start time of a  */
+  /* timed section; the timer macros do nothing if no clock is installed.  */
+  /*                                                                       */
+#if defined( __clang__ )                                        || \
+    ( defined( __GNUC__ )                                       && \
+      ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 7 ) ) )
+#define FT_ATOMIC_ADD( x, n )                                    \
+          (void)__atomic_fetch_add( &(x), (n), __ATOMIC_RELAXED )
+#else
+#define FT_ATOMIC_ADD( x, n )  (void)( (x) += (n) )
+#endif
+
+#ifdef FT_CONFIG_OPTION_COUNTERS
+
+#define FT_COUNTER_ADD( library, counter, n )                         \
+          FT_ATOMIC_ADD( (library)->counters[counter], (FT_ULong)(n) )
+#define FT_COUNTER_INC( library, counter )  \
+          FT_COUNTER_ADD( library, counter, 1 )
+
+#define FT_TIMER_VAR( start )  FT_ULong  start;
+
+#define FT_TIMER_START( library, start )                              \
+          start = (library)->counter_clock ? (library)->counter_clock() \
+                                           : 0
+#define FT_TIMER_STOP( library, counter, start )                      \
+          FT_BEGIN_STMNT                                              \
+            if ( (library)->counter_clock )                           \
+              FT_COUNTER_ADD( library, counter,                       \
+                              (library)->counter_clock() - (start) ); \
+          FT_END_STMNT
+
+#ifndef FT_CONFIG_OPTION_PIC
+
+  /* the process-wide counters; only `FT_COUNTER_STREAM_BYTES' and */
+  /* `FT_COUNTER_ALLOCATIONS' are used                              */
+  FT_BASE( FT_ULong )  ft_global_counters[FT_COUNTER_MAX];
+
+#define FT_GLOBAL_COUNTER_ADD( counter, n )                         \
+          FT_ATOMIC_ADD( ft_global_counters[counter], (FT_ULong)(n) )
+
+#else
+#define FT_GLOBAL_COUNTER_ADD( counter, n )  FT_BEGIN_STMNT FT_END_STMNT
+#endif
+
+#else /* !FT_CONFIG_OPTION_COUNTERS */
+
+#define FT_COUNTER_ADD( library, counter, n )     FT_BEGIN_STMNT FT_END_STMNT
+#define FT_COUNTER_INC( library, counter )        FT_BEGIN_STMNT FT_END_STMNT
+#define FT_TIMER_VAR( start )                     /* empty */
+#define FT_TIMER_START( library, start )          FT_BEGIN_STMNT FT_END_STMNT
+#define FT_TIMER_STOP( library, counter, start )  FT_BEGIN_STMNT FT_END_STMNT
+#define FT_GLOBAL_COUNTER_ADD( counter, n )       FT_BEGIN_STMNT FT_END_STMNT
+
+#endif /* !FT_CONFIG_OPTION_COUNTERS */
+
+
   FT_BASE( FT_Renderer )
   FT_Lookup_Renderer( FT_Library       library,
                       FT_Glyph_Format  format,
@@ -0,0 +1,102 @@
+/***************************************************************************/
+/*                                                                         */
+/*  ftsimd.h                                                               */
+/*                                                                         */
+/*    Vectorized computations (specification).                             */
+/*                                                                         */
+/*  Copyright 2026 by                                                      */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+#ifndef __FTSIMD_H__
+#define __FTSIMD_H__
+
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+
+FT_BEGIN_HEADER
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* SIMD code is only compiled with GCC and clang on x86_64 (SSE2 and     */
+  /* AVX2) and AArch64 (NEON), and never if the configuration macro        */
+  /* `FT_CONFIG_OPTION_NO_ASSEMBLER' is defined.  Instruction sets beyond  */
+  /* the base line of the target are selected at runtime with              */
+  /* `ft_simd_get_features'; the corresponding functions must be compiled  */
+  /* with `FT_SIMD_TARGET'.                                                */
+  /*                                                                       */
+  /*************************************************************************/
+
+#undef FT_SIMD_X86_64
+#undef FT_SIMD_ARM64
+
+#ifndef FT_CONFIG_OPTION_NO_ASSEMBLER
+
+#if defined( __GNUC__ ) && defined( __x86_64__ )                       && \
+    ( __GNUC__ >= 5 || defined( __clang__ ) )
+#define FT_SIMD_X86_64
+#define FT_SIMD_TARGET( x )  __attribute__(( __target__( x ) ))
+#endif
+
+#if defined( __GNUC__ ) && defined( __aarch64__ ) && defined( __ARM_NEON )
+#define FT_SIMD_ARM64
+#define FT_SIMD_TARGET( x )  /* */
+#endif
+
+#endif /* !FT_CONFIG_OPTION_NO_ASSEMBLER */
+
+
+  /* instruction sets returned by `ft_simd_get_features' */
+#define FT_SIMD_SSE2  0x1U
+#define FT_SIMD_AVX2  0x2U
+#define FT_SIMD_NEON  0x4U
+
+
+  /*
+   *  Return the instruction sets (a set of FT_SIMD_XXX flags) available on
+   *  the running CPU and supported by the compiled code.  The CPU is only
+   *  queried by the first call.
+   */
+  FT_BASE( FT_UInt )
+  ft_simd_get_features( void );
+
+
+  /*
+   *  Transform `count' vectors in place with `matrix' and translate them
+   *  by `delta' afterwards; either argument can be NULL.  The results are
+   *  bit-identical to calling `FT_Vector_Transform' for each vector.
+   */
+  FT_BASE( void )
+  ft_vector_array_transform( FT_Vector*        vectors,
+                             FT_Int            count,
+                             const FT_Matrix*  matrix,
+                             const FT_Vector*  delta );
+
+
+  /*
+   *  Compute the bounding box of `count' vectors, which is the same as
+   *  `FT_Outline_Get_CBox'.  For `count' = 0, all values are set to zero.
+   */
+  FT_BASE( void )
+  ft_vector_array_get_cbox( const FT_Vector*  vectors,
+                            FT_Int            count,
+                            FT_BBox          *acbox );
+
+
+FT_END_HEADER
+
+#endif /* __FTSIMD_H__ */
+
+
+/* END */
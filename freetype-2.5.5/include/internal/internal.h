@@ -30,6 +30,7 @@
 #define FT_INTERNAL_MEMORY_H              <internal/ftmemory.h>
 #define FT_INTERNAL_DEBUG_H               <internal/ftdebug.h>
 #define FT_INTERNAL_CALC_H                <internal/ftcalc.h>
+#define FT_INTERNAL_SIMD_H                <internal/ftsimd.h>
 #define FT_INTERNAL_DRIVER_H              <internal/ftdriver.h>
 #define FT_INTERNAL_TRACE_H               <internal/fttrace.h>
 #define FT_INTERNAL_GLYPH_LOADER_H        <internal/ftgloadr.h>
@@ -795,6 +795,42 @@ FT_BEGIN_HEADER
   /*************************************************************************/
   /*************************************************************************/
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /*****                                                               *****/
+  /*****                         KEYWORD HASH                          *****/
+  /*****                                                               *****/
+  /*************************************************************************/
+  /*************************************************************************/
+
+#define PS_KEYWORD_HASH_SIZE  256  /* must be a power of two */
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    PS_Keyword_HashRec                                                 */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    An open-addressing hash table that maps keyword names to the first */
+  /*    entry with the same name in an array of T1_FieldRec structures.    */
+  /*    The array must be terminated with an entry whose `ident' is NULL   */
+  /*    and must have less than PS_KEYWORD_HASH_SIZE/2 entries.            */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    fields :: The field array.                                         */
+  /*                                                                       */
+  /*    slots  :: The hash slots, holding an index into `fields' plus one, */
+  /*              or zero for empty slots.                                 */
+  /*                                                                       */
+  typedef struct  PS_Keyword_HashRec_
+  {
+    const T1_FieldRec*  fields;
+    FT_UShort           slots[PS_KEYWORD_HASH_SIZE];
+
+  } PS_Keyword_HashRec, *PS_Keyword_Hash;
+
+
   typedef struct  PSAux_ServiceRec_
   {
     /* don't use `PS_Table_Funcs' and friends to avoid compiler warnings */
@@ -813,6 +849,16 @@ FT_BEGIN_HEADER
     /* fields after this comment line were added after version 2.1.10 */
     const AFM_Parser_FuncsRec*  afm_parser_funcs;
 
+    /* fields after this comment line were added after version 2.5.5 */
+    void
+    (*keyword_hash_init)( PS_Keyword_Hash     hash,
+                          const T1_FieldRec*  fields );
+
+    const T1_FieldRec*
+    (*keyword_hash_lookup)( PS_Keyword_Hash  hash,
+                            const FT_Byte*   name,
+                            FT_PtrDist       len );
+
   } PSAux_ServiceRec, *PSAux_Service;
 
   /* backwards-compatible type definition */
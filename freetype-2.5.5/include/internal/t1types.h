@@ -112,6 +112,7 @@ FT_BEGIN_HEADER
     FT_String**      glyph_names;       /* array of glyph names       */
     FT_Byte**        charstrings;       /* array of glyph charstrings */
     FT_PtrDist*      charstrings_len;
+    FT_UInt32*       charstrings_keys;  /* see `T1_Decrypt_Charstring' */
 
     FT_Byte          paint_type;
     FT_Byte          font_type;
@@ -946,6 +946,9 @@ FT_BEGIN_HEADER
   /* forward declaration */
   typedef struct TT_LoaderRec_*  TT_Loader;
 
+  /* forward declaration; the structure is private to the TrueType driver */
+  typedef struct TT_BytecodeCacheRec_*  TT_BytecodeCache;
+
 
   /*************************************************************************/
   /*                                                                       */
@@ -1250,6 +1253,11 @@ FT_BEGIN_HEADER
   /*    postscript_name      :: The PS name of the font.  Used by the      */
   /*                            postscript name service.                   */
   /*                                                                       */
+  /*    bytecode_cache       :: The state after running the font program,  */
+  /*                            and a cache of the states after running    */
+  /*                            the CVT program for recently used sizes.   */
+  /*                            Shared by all sizes of the face.           */
+  /*                                                                       */
   typedef struct  TT_FaceRec_
   {
     FT_FaceRec            root;
@@ -1402,6 +1410,11 @@ FT_BEGIN_HEADER
     FT_Bool               sph_compatibility_mode;
 #endif /* TT_CONFIG_OPTION_SUBPIXEL_HINTING */
 
+#ifdef TT_USE_BYTECODE_INTERPRETER
+    /* since 2.6 */
+    TT_BytecodeCache      bytecode_cache;
+#endif
+
   } TT_FaceRec;
 
 
@@ -1168,26 +1168,6 @@
   }
 
 
-  /* Detect segments and edges for given dimension. */
-
-  static FT_Error
-  af_cjk_hints_detect_features( AF_GlyphHints  hints,
-                                AF_Dimension   dim )
-  {
-    FT_Error  error;
-
-
-    error = af_cjk_hints_compute_segments( hints, dim );
-    if ( !error )
-    {
-      af_cjk_hints_link_segments( hints, dim );
-
-      error = af_cjk_hints_compute_edges( hints, dim );
-    }
-    return error;
-  }
-
-
   /* Compute all edges which lie within blue zones. */
 
   FT_LOCAL_DEF( void )
@@ -2091,9 +2071,23 @@
     AF_Edge       edges      = axis->edges;
     AF_Edge       edge_limit = edges + axis->num_edges;
     AF_Edge       edge;
+    AF_Point      points     = hints->points;
+    FT_Pos*       cur;
+    AF_Flags      touch_flag;
     FT_Bool       snapping;
 
 
+    if ( dim == AF_DIMENSION_HORZ )
+    {
+      cur        = hints->x;
+      touch_flag = AF_FLAG_TOUCH_X;
+    }
+    else
+    {
+      cur        = hints->y;
+      touch_flag = AF_FLAG_TOUCH_Y;
+    }
+
     snapping = FT_BOOL( ( dim == AF_DIMENSION_HORZ             &&
                           AF_LATIN_HINTS_DO_HORZ_SNAP( hints ) )  ||
                         ( dim == AF_DIMENSION_VERT             &&
@@ -2115,16 +2109,8 @@
 
           for (;;)
           {
-            if ( dim == AF_DIMENSION_HORZ )
-            {
-              point->x      = edge->pos;
-              point->flags |= AF_FLAG_TOUCH_X;
-            }
-            else
-            {
-              point->y      = edge->pos;
-              point->flags |= AF_FLAG_TOUCH_Y;
-            }
+            cur[point - points] = edge->pos;
+            point->flags       |= touch_flag;
 
             if ( point == seg->last )
               break;
@@ -2148,16 +2134,8 @@
 
           for (;;)
           {
-            if ( dim == AF_DIMENSION_HORZ )
-            {
-              point->x     += delta;
-              point->flags |= AF_FLAG_TOUCH_X;
-            }
-            else
-            {
-              point->y     += delta;
-              point->flags |= AF_FLAG_TOUCH_Y;
-            }
+            cur[point - points] += delta;
+            point->flags        |= touch_flag;
 
             if ( point == seg->last )
               break;
@@ -2183,30 +2161,49 @@
     FT_Error  error;
     int       dim;
 
+    FT_UInt   dims = 0;
+    FT_UInt   cached;
+
     FT_UNUSED( metrics );
 
 
-    error = af_glyph_hints_reload( hints, outline );
+    /* analyze glyph outline */
+    if ( AF_HINTS_DO_HORIZONTAL( hints ) )
+      dims |= AF_DIMENSION_MASK( AF_DIMENSION_HORZ );
+
+    if ( AF_HINTS_DO_VERTICAL( hints ) )
+      dims |= AF_DIMENSION_MASK( AF_DIMENSION_VERT );
+
+    /* segments don't depend on the scaling (contrary to their  */
+    /* links); reuse them if the glyph has been analyzed before */
+    error = af_glyph_hints_reload_cached( hints, outline, &cached );
     if ( error )
       goto Exit;
 
-    /* analyze glyph outline */
-    if ( AF_HINTS_DO_HORIZONTAL( hints ) )
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
     {
-      error = af_cjk_hints_detect_features( hints, AF_DIMENSION_HORZ );
+      if ( !( dims & ~cached & AF_DIMENSION_MASK( dim ) ) )
+        continue;
+
+      error = af_cjk_hints_compute_segments( hints, (AF_Dimension)dim );
       if ( error )
         goto Exit;
-
-      af_cjk_hints_compute_blue_edges( hints, metrics, AF_DIMENSION_HORZ );
     }
 
-    if ( AF_HINTS_DO_VERTICAL( hints ) )
+    af_glyph_hints_cache_analysis( hints, cached, dims );
+
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
     {
-      error = af_cjk_hints_detect_features( hints, AF_DIMENSION_VERT );
+      if ( !( dims & AF_DIMENSION_MASK( dim ) ) )
+        continue;
+
+      af_cjk_hints_link_segments( hints, (AF_Dimension)dim );
+
+      error = af_cjk_hints_compute_edges( hints, (AF_Dimension)dim );
       if ( error )
         goto Exit;
 
-      af_cjk_hints_compute_blue_edges( hints, metrics, AF_DIMENSION_VERT );
+      af_cjk_hints_compute_blue_edges( hints, metrics, (AF_Dimension)dim );
     }
 
     /* grid-fit the outline */
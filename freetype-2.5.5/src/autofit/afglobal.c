@@ -20,6 +20,8 @@
 #include "afranges.h"
 #include "hbshim.h"
 #include FT_INTERNAL_DEBUG_H
+#include FT_INTERNAL_STREAM_H
+#include FT_INTERNAL_TRUETYPE_TYPES_H
 
 
   /*************************************************************************/
@@ -127,123 +129,129 @@
 #endif /* FT_DEBUG_LEVEL_TRACE */
 
 
-  /* Compute the style index of each glyph within a given face. */
-
-  static FT_Error
-  af_face_globals_compute_style_coverage( AF_FaceGlobals  globals )
+  /*
+   *  The style of each glyph is computed incrementally.  Styles are
+   *  scanned in the order of `af_style_classes'; a glyph gets the first
+   *  style whose Unicode ranges (or OpenType coverage) contain it.  Since
+   *  every scan only assigns glyphs that are still unassigned, we can stop
+   *  as soon as the glyph we are interested in has got a style; for
+   *  example, hinting Latin text never scans the Indic or CJK ranges.
+   *
+   *  `coverage_style' holds the index of the next style to scan.  After
+   *  the last one, the default OpenType features get handled and the
+   *  remaining glyphs are set to the fallback style; `coverage_style' is
+   *  then set to AF_STYLE_MAX + 1.
+   */
+
+  /* Scan style `ss'; the Unicode charmap must be selected. */
+
+  static void
+  af_face_globals_scan_style( AF_FaceGlobals  globals,
+                              FT_UInt         ss )
   {
-    FT_Error    error;
-    FT_Face     face        = globals->face;
-    FT_CharMap  old_charmap = face->charmap;
-    FT_Byte*    gstyles     = globals->glyph_styles;
-    FT_UInt     ss;
-    FT_UInt     i;
-    FT_UInt     dflt        = ~0U; /* a non-valid value */
+    FT_Face             face         = globals->face;
+    FT_Byte*            gstyles      = globals->glyph_styles;
+    AF_StyleClass       style_class  = AF_STYLE_CLASSES_GET[ss];
+    AF_ScriptClass      script_class =
+                          AF_SCRIPT_CLASSES_GET[style_class->script];
+    AF_Script_UniRange  range;
 
 
-    /* the value AF_STYLE_UNASSIGNED means `uncovered glyph' */
-    FT_MEM_SET( globals->glyph_styles,
-                AF_STYLE_UNASSIGNED,
-                globals->glyph_count );
+    if ( script_class->script_uni_ranges == NULL )
+      return;
 
-    error = FT_Select_Charmap( face, FT_ENCODING_UNICODE );
-    if ( error )
-    {
-      /*
-       * Ignore this error; we simply use the fallback style.
-       * XXX: Shouldn't we rather disable hinting?
-       */
-      error = FT_Err_Ok;
-      goto Exit;
-    }
-
-    /* scan each style in a Unicode charmap */
-    for ( ss = 0; AF_STYLE_CLASSES_GET[ss]; ss++ )
+    /*
+     *  Scan all Unicode points in the range and set the corresponding
+     *  glyph style index.
+     */
+    if ( style_class->coverage == AF_COVERAGE_DEFAULT )
     {
-      AF_StyleClass       style_class =
-                            AF_STYLE_CLASSES_GET[ss];
-      AF_ScriptClass      script_class =
-                            AF_SCRIPT_CLASSES_GET[style_class->script];
-      AF_Script_UniRange  range;
-
-
-      if ( script_class->script_uni_ranges == NULL )
-        continue;
-
-      /*
-       *  Scan all Unicode points in the range and set the corresponding
-       *  glyph style index.
-       */
-      if ( style_class->coverage == AF_COVERAGE_DEFAULT )
+      for ( range = script_class->script_uni_ranges;
+            range->first != 0;
+            range++ )
       {
-        if ( (FT_UInt)style_class->script ==
-             globals->module->default_script )
-          dflt = ss;
-
-        for ( range = script_class->script_uni_ranges;
-              range->first != 0;
-              range++ )
-        {
-          FT_ULong  charcode = range->first;
-          FT_UInt   gindex;
+        FT_ULong  charcode = range->first;
+        FT_UInt   gindex;
 
 
-          gindex = FT_Get_Char_Index( face, charcode );
+        gindex = FT_Get_Char_Index( face, charcode );
 
-          if ( gindex != 0                             &&
-               gindex < (FT_ULong)globals->glyph_count &&
-               gstyles[gindex] == AF_STYLE_UNASSIGNED  )
-            gstyles[gindex] = (FT_Byte)ss;
+        if ( gindex != 0                                        &&
+             gindex < (FT_ULong)globals->glyph_count            &&
+             ( gstyles[gindex] & AF_STYLE_UNASSIGNED ) ==
+               AF_STYLE_UNASSIGNED                              )
+          gstyles[gindex] = (FT_Byte)( ( gstyles[gindex] & AF_DIGIT ) |
+                                       ss                            );
 
-          for (;;)
-          {
-            charcode = FT_Get_Next_Char( face, charcode, &gindex );
+        for (;;)
+        {
+          charcode = FT_Get_Next_Char( face, charcode, &gindex );
 
-            if ( gindex == 0 || charcode > range->last )
-              break;
+          if ( gindex == 0 || charcode > range->last )
+            break;
 
-            if ( gindex < (FT_ULong)globals->glyph_count &&
-                 gstyles[gindex] == AF_STYLE_UNASSIGNED  )
-              gstyles[gindex] = (FT_Byte)ss;
-          }
+          if ( gindex < (FT_ULong)globals->glyph_count  &&
+               ( gstyles[gindex] & AF_STYLE_UNASSIGNED ) ==
+                 AF_STYLE_UNASSIGNED                    )
+            gstyles[gindex] = (FT_Byte)( ( gstyles[gindex] & AF_DIGIT ) |
+                                         ss                            );
         }
       }
-      else
-      {
-        /* get glyphs not directly addressable by cmap */
-        af_get_coverage( globals, style_class, gstyles );
-      }
     }
+    else
+    {
+      /* get glyphs not directly addressable by cmap */
+      af_get_coverage( globals, style_class, gstyles );
+    }
+  }
 
-    /* handle the default OpenType features of the default script ... */
-    af_get_coverage( globals, AF_STYLE_CLASSES_GET[dflt], gstyles );
 
-    /* ... and the remaining default OpenType features */
-    for ( ss = 0; AF_STYLE_CLASSES_GET[ss]; ss++ )
-    {
-      AF_StyleClass  style_class = AF_STYLE_CLASSES_GET[ss];
+  /* Handle the default OpenType features and the uncovered glyphs after */
+  /* all styles have been scanned.                                       */
 
+  static void
+  af_face_globals_finish_style_coverage( AF_FaceGlobals  globals,
+                                         FT_Bool         have_unicode )
+  {
+    FT_Byte*  gstyles = globals->glyph_styles;
+    FT_UInt   ss;
 
-      if ( ss != dflt && style_class->coverage == AF_COVERAGE_DEFAULT )
-        af_get_coverage( globals, style_class, gstyles );
-    }
 
-    /* mark ASCII digits */
-    for ( i = 0x30; i <= 0x39; i++ )
+    if ( have_unicode )
     {
-      FT_UInt  gindex = FT_Get_Char_Index( face, i );
+      /* handle the default OpenType features of the default script ... */
+      for ( ss = 0; AF_STYLE_CLASSES_GET[ss]; ss++ )
+      {
+        AF_StyleClass  style_class = AF_STYLE_CLASSES_GET[ss];
 
 
-      if ( gindex != 0 && gindex < (FT_ULong)globals->glyph_count )
-        gstyles[gindex] |= AF_DIGIT;
+        if ( (FT_UInt)style_class->script == globals->default_script &&
+             style_class->coverage == AF_COVERAGE_DEFAULT            &&
+             AF_SCRIPT_CLASSES_GET[style_class->script]
+               ->script_uni_ranges                                   )
+        {
+          af_get_coverage( globals, style_class, gstyles );
+          break;
+        }
+      }
+
+      /* ... and the remaining default OpenType features */
+      for ( ss = 0; AF_STYLE_CLASSES_GET[ss]; ss++ )
+      {
+        AF_StyleClass  style_class = AF_STYLE_CLASSES_GET[ss];
+
+
+        if ( (FT_UInt)style_class->script != globals->default_script &&
+             style_class->coverage == AF_COVERAGE_DEFAULT            )
+          af_get_coverage( globals, style_class, gstyles );
+      }
     }
 
-  Exit:
     /*
      *  By default, all uncovered glyphs are set to the fallback style.
      *  XXX: Shouldn't we disable hinting or do something similar?
      */
-    if ( globals->module->fallback_style != AF_STYLE_UNASSIGNED )
+    if ( globals->fallback_style != AF_STYLE_UNASSIGNED )
     {
       FT_Long  nn;
 
@@ -253,11 +261,13 @@
         if ( ( gstyles[nn] & ~AF_DIGIT ) == AF_STYLE_UNASSIGNED )
         {
           gstyles[nn] &= ~AF_STYLE_UNASSIGNED;
-          gstyles[nn] |= globals->module->fallback_style;
+          gstyles[nn] |= globals->fallback_style;
         }
       }
     }
 
+    globals->coverage_style = AF_STYLE_MAX + 1;
+
 #ifdef FT_DEBUG_LEVEL_TRACE
 
     FT_TRACE4(( "\n"
@@ -296,16 +306,125 @@
     }
 
 #endif /* FT_DEBUG_LEVEL_TRACE */
+  }
+
+
+  /* Scan styles until glyph `gindex' has got a style.  If `gindex' is */
+  /* not a valid glyph index, compute the styles of all glyphs.        */
+
+  static void
+  af_face_globals_compute_style_coverage( AF_FaceGlobals  globals,
+                                          FT_UInt         gindex )
+  {
+    FT_Face     face        = globals->face;
+    FT_CharMap  old_charmap = face->charmap;
+    FT_Byte*    gstyles     = globals->glyph_styles;
+    FT_Bool     all         = FT_BOOL( gindex >=
+                                         (FT_ULong)globals->glyph_count );
 
+
+    if ( globals->coverage_style > AF_STYLE_MAX )
+      return;
+
+    if ( FT_Select_Charmap( face, FT_ENCODING_UNICODE ) )
+    {
+      /*
+       * Ignore this error; we simply use the fallback style.
+       * XXX: Shouldn't we rather disable hinting?
+       */
+      af_face_globals_finish_style_coverage( globals, 0 );
+      goto Exit;
+    }
+
+    while ( globals->coverage_style < AF_STYLE_MAX                 &&
+            ( all                                                ||
+              ( gstyles[gindex] & AF_STYLE_UNASSIGNED ) ==
+                AF_STYLE_UNASSIGNED                              ) )
+      af_face_globals_scan_style( globals, globals->coverage_style++ );
+
+    if ( globals->coverage_style == AF_STYLE_MAX                 &&
+         ( all                                                ||
+           ( gstyles[gindex] & AF_STYLE_UNASSIGNED ) ==
+             AF_STYLE_UNASSIGNED                              ) )
+      af_face_globals_finish_style_coverage( globals, 1 );
+
+  Exit:
     FT_Set_Charmap( face, old_charmap );
-    return error;
   }
 
 
-  FT_LOCAL_DEF( FT_Error )
-  af_face_globals_new( FT_Face          face,
-                       AF_FaceGlobals  *aglobals,
-                       AF_Module        module )
+  /* Prepare the incremental computation of the glyph styles. */
+
+  static void
+  af_face_globals_init_style_coverage( AF_FaceGlobals  globals )
+  {
+    FT_Face     face        = globals->face;
+    FT_CharMap  old_charmap = face->charmap;
+    FT_Byte*    gstyles     = globals->glyph_styles;
+    FT_UInt     i;
+
+
+    /* the value AF_STYLE_UNASSIGNED means `uncovered glyph' */
+    FT_MEM_SET( globals->glyph_styles,
+                AF_STYLE_UNASSIGNED,
+                globals->glyph_count );
+
+    globals->coverage_style = 0;
+
+    if ( FT_Select_Charmap( face, FT_ENCODING_UNICODE ) )
+    {
+      /* no Unicode charmap: everything gets the fallback style */
+      af_face_globals_finish_style_coverage( globals, 0 );
+      goto Exit;
+    }
+
+    /* mark ASCII digits */
+    for ( i = 0x30; i <= 0x39; i++ )
+    {
+      FT_UInt  gindex = FT_Get_Char_Index( face, i );
+
+
+      if ( gindex != 0 && gindex < (FT_ULong)globals->glyph_count )
+        gstyles[gindex] |= AF_DIGIT;
+    }
+
+  Exit:
+    FT_Set_Charmap( face, old_charmap );
+  }
+
+
+  /* Return the style of a glyph, computing it if necessary. */
+
+  static FT_UInt
+  af_face_globals_get_style( AF_FaceGlobals  globals,
+                             FT_UInt         gindex )
+  {
+    FT_Byte*  gstyles = globals->glyph_styles;
+
+
+    if ( ( gstyles[gindex] & AF_STYLE_UNASSIGNED ) == AF_STYLE_UNASSIGNED )
+      af_face_globals_compute_style_coverage( globals, gindex );
+
+    return gstyles[gindex] & AF_STYLE_UNASSIGNED;
+  }
+
+
+  /* Return the complete glyph style map. */
+
+  FT_LOCAL_DEF( FT_Byte* )
+  af_face_globals_get_glyph_styles( AF_FaceGlobals  globals )
+  {
+    af_face_globals_compute_style_coverage( globals,
+                                            (FT_UInt)globals->glyph_count );
+
+    return globals->glyph_styles;
+  }
+
+
+  static FT_Error
+  af_face_globals_alloc( FT_Face          face,
+                         AF_FaceGlobals  *aglobals,
+                         AF_Module        module )
   {
     FT_Error        error;
     FT_Memory       memory;
@@ -318,26 +437,750 @@
                             face->num_glyphs * sizeof ( FT_Byte ) ) )
       goto Exit;
 
-    globals->face         = face;
-    globals->glyph_count  = face->num_glyphs;
-    globals->glyph_styles = (FT_Byte*)( globals + 1 );
-    globals->module       = module;
+    globals->face              = face;
+    globals->glyph_count       = face->num_glyphs;
+    globals->glyph_styles      = (FT_Byte*)( globals + 1 );
+    globals->module            = module;
+    globals->fallback_style    = module->fallback_style;
+    globals->default_script    = module->default_script;
+    globals->increase_x_height = AF_PROP_INCREASE_X_HEIGHT_MAX;
 
 #ifdef FT_CONFIG_OPTION_USE_HARFBUZZ
     globals->hb_font = hb_ft_font_create( face, NULL );
 #endif
 
-    error = af_face_globals_compute_style_coverage( globals );
-    if ( error )
+  Exit:
+    *aglobals = globals;
+    return error;
+  }
+
+
+  FT_LOCAL_DEF( FT_Error )
+  af_face_globals_new( FT_Face          face,
+                       AF_FaceGlobals  *aglobals,
+                       AF_Module        module )
+  {
+    FT_Error        error;
+    AF_FaceGlobals  globals;
+
+
+    error = af_face_globals_alloc( face, &globals, module );
+    if ( !error )
+      af_face_globals_init_style_coverage( globals );
+
+    *aglobals = globals;
+    return error;
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The serialized face globals have the following big-endian layout.     */
+  /*                                                                       */
+  /*   magic             4 bytes   `AFGC'                                  */
+  /*   version           4 bytes   FreeType version and format             */
+  /*   fingerprint       4 bytes   see `af_face_globals_fingerprint'       */
+  /*   checksum          4 bytes   hash of all following bytes             */
+  /*   glyph count       4 bytes                                           */
+  /*   style count       2 bytes   AF_STYLE_MAX                            */
+  /*   metrics count     2 bytes                                           */
+  /*   glyph styles      glyph count bytes                                 */
+  /*                                                                       */
+  /* and for each computed style metrics object                            */
+  /*                                                                       */
+  /*   style             2 bytes                                           */
+  /*   size              4 bytes   size of the following data              */
+  /*   same width digits 1 byte                                            */
+  /*   data              the writing-system specific part of the metrics   */
+  /*                                                                       */
+  /* The latter is empty for the `dummy' writing system.  For the `latin'  */
+  /* and `cjk' metrics (also used by `latin2' and `indic', respectively),  */
+  /* it is                                                                 */
+  /*                                                                       */
+  /*   units per EM      2 bytes                                           */
+  /*                                                                       */
+  /* followed by, for the horizontal and the vertical axis,                */
+  /*                                                                       */
+  /*   width count       2 bytes                                           */
+  /*   widths            4 bytes each                                      */
+  /*   edge distance     4 bytes   `edge_distance_threshold'               */
+  /*   standard width    4 bytes                                           */
+  /*   extra light       1 byte                                            */
+  /*   control overshoot 1 byte    `cjk' only                              */
+  /*   blue count        2 bytes                                           */
+  /*   blue zones        10 bytes each: reference, overshoot, and flags    */
+  /*                                                                       */
+  /* Only values in font units are stored; the scaled values are computed  */
+  /* by the `style_metrics_scale' method.                                  */
+  /*                                                                       */
+  /*************************************************************************/
+
+#define AF_GLOBALS_DATA_MAGIC    FT_MAKE_TAG( 'A', 'F', 'G', 'C' )
+#define AF_GLOBALS_DATA_VERSION  ( ( FREETYPE_MAJOR << 24 ) | \
+                                   ( FREETYPE_MINOR << 16 ) | \
+                                   ( FREETYPE_PATCH <<  8 ) | \
+                                   3                        )
+
+#define AF_GLOBALS_HEADER_SIZE   24
+#define AF_GLOBALS_CHECKSUM_POS  12
+#define AF_METRICS_HEADER_SIZE   7
+
+  /* the size of an axis record without widths and blue zones */
+#define AF_AXIS_HEADER_SIZE      13
+#define AF_WIDTH_SIZE            4
+#define AF_BLUE_SIZE             10
+
+
+#define AF_WRITE_USHORT( p, v )             \
+          do                                \
+          {                                 \
+            (p)[0] = (FT_Byte)( (v) >> 8 ); \
+            (p)[1] = (FT_Byte)( (v)      ); \
+            (p)   += 2;                     \
+          } while ( 0 )
+
+#define AF_WRITE_ULONG( p, v )               \
+          do                                 \
+          {                                  \
+            (p)[0] = (FT_Byte)( (v) >> 24 ); \
+            (p)[1] = (FT_Byte)( (v) >> 16 ); \
+            (p)[2] = (FT_Byte)( (v) >>  8 ); \
+            (p)[3] = (FT_Byte)( (v)       ); \
+            (p)   += 4;                      \
+          } while ( 0 )
+
+
+  /* A variant of the 32-bit FNV-1a hash that processes four bytes per */
+  /* step, used for both the fingerprint and the checksum.              */
+
+#define AF_HASH_INIT   2166136261UL
+#define AF_HASH_PRIME  16777619UL
+
+
+  static FT_UInt32
+  af_hash_ulong( FT_UInt32  hash,
+                 FT_ULong   value )
+  {
+    return (FT_UInt32)( ( hash ^ value ) * AF_HASH_PRIME );
+  }
+
+
+  static FT_UInt32
+  af_hash_bytes( FT_UInt32       hash,
+                 const FT_Byte*  p,
+                 FT_ULong        count )
+  {
+    for ( ; count >= 4; count -= 4, p += 4 )
+      hash = af_hash_ulong( hash, FT_PEEK_ULONG( p ) );
+
+    for ( ; count > 0; count-- )
+      hash = af_hash_ulong( hash, *p++ );
+
+    return hash;
+  }
+
+
+  /* Compute a fingerprint of everything the face globals depend on.  For */
+  /* SFNT-based fonts we use the table directory (tags, checksums, and    */
+  /* lengths) and the checksum adjustment of the `head' table.  Other     */
+  /* formats don't have checksums; we hash the whole font file, which is  */
+  /* still much cheaper than computing the metrics.                       */
+
+  static FT_Error
+  af_face_globals_fingerprint( FT_Face     face,
+                               FT_UInt     fallback_style,
+                               FT_UInt     default_script,
+                               FT_UInt32  *afingerprint )
+  {
+    FT_Error   error = FT_Err_Ok;
+    FT_UInt32  hash  = AF_HASH_INIT;
+
+
+    hash = af_hash_ulong( hash, (FT_ULong)face->num_glyphs );
+    hash = af_hash_ulong( hash, (FT_ULong)face->face_index );
+    hash = af_hash_ulong( hash, face->units_per_EM );
+    hash = af_hash_ulong( hash, fallback_style );
+    hash = af_hash_ulong( hash, default_script );
+
+    if ( FT_IS_SFNT( face ) )
     {
-      af_face_globals_free( globals );
-      globals = NULL;
+      TT_Face   ttface = (TT_Face)face;
+      TT_Table  table  = ttface->dir_tables;
+      TT_Table  limit  = table + ttface->num_tables;
+
+
+      hash = af_hash_ulong( hash, ttface->header.CheckSum_Adjust );
+
+      for ( ; table < limit; table++ )
+      {
+        hash = af_hash_ulong( hash, table->Tag );
+        hash = af_hash_ulong( hash, table->CheckSum );
+        hash = af_hash_ulong( hash, table->Length );
+      }
     }
     else
-      globals->increase_x_height = AF_PROP_INCREASE_X_HEIGHT_MAX;
+    {
+      FT_Stream  stream = face->stream;
+      FT_ULong   pos    = stream->pos;
+      FT_ULong   offset;
+      FT_Byte    buffer[4096];
+
+
+      hash = af_hash_ulong( hash, stream->size );
+
+      for ( offset = 0; offset < stream->size; )
+      {
+        FT_ULong  count = stream->size - offset;
+
+
+        if ( count > sizeof ( buffer ) )
+          count = sizeof ( buffer );
+
+        error = FT_Stream_ReadAt( stream, offset, buffer, count );
+        if ( error )
+          break;
+
+        hash    = af_hash_bytes( hash, buffer, count );
+        offset += count;
+      }
+
+      (void)FT_Stream_Seek( stream, pos );
+    }
+
+    *afingerprint = hash;
+
+    return error;
+  }
+
+
+  /* The layouts of the writing-system specific metrics data. */
+
+#define AF_METRICS_LAYOUT_NONE   0
+#define AF_METRICS_LAYOUT_LATIN  1
+#define AF_METRICS_LAYOUT_CJK    2
+
+
+  /* Return the layout of the metrics data of `writing_system', or -1 if */
+  /* it can't be serialized.                                              */
+
+  static FT_Int
+  af_metrics_layout( AF_WritingSystem  writing_system )
+  {
+    switch ( writing_system )
+    {
+    case AF_WRITING_SYSTEM_DUMMY:
+      return AF_METRICS_LAYOUT_NONE;
+
+    case AF_WRITING_SYSTEM_LATIN:
+#ifdef FT_OPTION_AUTOFIT2
+    case AF_WRITING_SYSTEM_LATIN2:
+#endif
+      return AF_METRICS_LAYOUT_LATIN;
+
+    case AF_WRITING_SYSTEM_CJK:
+    case AF_WRITING_SYSTEM_INDIC:
+      return AF_METRICS_LAYOUT_CJK;
+
+    default:
+      return -1;
+    }
+  }
+
+
+  static FT_ULong
+  af_metrics_data_size( AF_StyleMetrics  metrics,
+                        FT_Int           layout )
+  {
+    FT_ULong  size = 0;
+    FT_UInt   dim;
+
+
+    if ( layout == AF_METRICS_LAYOUT_LATIN )
+    {
+      AF_LatinMetrics  latin = (AF_LatinMetrics)metrics;
+
+
+      size = 2;
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        size += AF_AXIS_HEADER_SIZE                                 +
+                latin->axis[dim].width_count * AF_WIDTH_SIZE        +
+                latin->axis[dim].blue_count * AF_BLUE_SIZE;
+    }
+    else if ( layout == AF_METRICS_LAYOUT_CJK )
+    {
+      AF_CJKMetrics  cjk = (AF_CJKMetrics)metrics;
+
+
+      size = 2;
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        size += AF_AXIS_HEADER_SIZE + 1                           +
+                cjk->axis[dim].width_count * AF_WIDTH_SIZE        +
+                cjk->axis[dim].blue_count * AF_BLUE_SIZE;
+    }
+
+    return size;
+  }
+
+
+  static FT_Byte*
+  af_latin_axis_write( AF_LatinAxis  axis,
+                       FT_Byte*      p )
+  {
+    FT_UInt  nn;
+
+
+    AF_WRITE_USHORT( p, axis->width_count );
+    for ( nn = 0; nn < axis->width_count; nn++ )
+      AF_WRITE_ULONG( p, (FT_ULong)axis->widths[nn].org );
+
+    AF_WRITE_ULONG( p, (FT_ULong)axis->edge_distance_threshold );
+    AF_WRITE_ULONG( p, (FT_ULong)axis->standard_width );
+    *p++ = (FT_Byte)axis->extra_light;
+
+    AF_WRITE_USHORT( p, axis->blue_count );
+    for ( nn = 0; nn < axis->blue_count; nn++ )
+    {
+      AF_WRITE_ULONG( p, (FT_ULong)axis->blues[nn].ref.org );
+      AF_WRITE_ULONG( p, (FT_ULong)axis->blues[nn].shoot.org );
+      AF_WRITE_USHORT( p, axis->blues[nn].flags );
+    }
+
+    return p;
+  }
+
+
+  static FT_Byte*
+  af_cjk_axis_write( AF_CJKAxis  axis,
+                     FT_Byte*    p )
+  {
+    FT_UInt  nn;
+
+
+    AF_WRITE_USHORT( p, axis->width_count );
+    for ( nn = 0; nn < axis->width_count; nn++ )
+      AF_WRITE_ULONG( p, (FT_ULong)axis->widths[nn].org );
+
+    AF_WRITE_ULONG( p, (FT_ULong)axis->edge_distance_threshold );
+    AF_WRITE_ULONG( p, (FT_ULong)axis->standard_width );
+    *p++ = (FT_Byte)axis->extra_light;
+    *p++ = (FT_Byte)axis->control_overshoot;
+
+    AF_WRITE_USHORT( p, axis->blue_count );
+    for ( nn = 0; nn < axis->blue_count; nn++ )
+    {
+      AF_WRITE_ULONG( p, (FT_ULong)axis->blues[nn].ref.org );
+      AF_WRITE_ULONG( p, (FT_ULong)axis->blues[nn].shoot.org );
+      AF_WRITE_USHORT( p, axis->blues[nn].flags );
+    }
+
+    return p;
+  }
+
+
+  /* Read an axis record from `*ap', which must end at or before `limit'. */
+  /* All counts are checked since they are used as array limits.          */
+
+  static FT_Bool
+  af_latin_axis_read( AF_LatinAxis  axis,
+                      FT_Byte**     ap,
+                      FT_Byte*      limit )
+  {
+    FT_Byte*  p = *ap;
+    FT_UInt   nn;
+
+
+    if ( limit - p < AF_AXIS_HEADER_SIZE )
+      return FALSE;
+
+    axis->width_count = FT_NEXT_USHORT( p );
+    if ( axis->width_count > AF_LATIN_MAX_WIDTHS                       ||
+         limit - p < (FT_Long)( AF_AXIS_HEADER_SIZE - 2               +
+                                axis->width_count * AF_WIDTH_SIZE ) )
+      return FALSE;
+
+    for ( nn = 0; nn < axis->width_count; nn++ )
+      axis->widths[nn].org = FT_NEXT_LONG( p );
+
+    axis->edge_distance_threshold = FT_NEXT_LONG( p );
+    axis->standard_width          = FT_NEXT_LONG( p );
+    axis->extra_light             = FT_BOOL( FT_NEXT_BYTE( p ) );
+
+    axis->blue_count = FT_NEXT_USHORT( p );
+    if ( axis->blue_count > AF_BLUE_STRINGSET_MAX                      ||
+         limit - p < (FT_Long)( axis->blue_count * AF_BLUE_SIZE )      )
+      return FALSE;
+
+    for ( nn = 0; nn < axis->blue_count; nn++ )
+    {
+      axis->blues[nn].ref.org   = FT_NEXT_LONG( p );
+      axis->blues[nn].shoot.org = FT_NEXT_LONG( p );
+      axis->blues[nn].flags     = FT_NEXT_USHORT( p );
+    }
+
+    *ap = p;
+
+    return TRUE;
+  }
+
+
+  static FT_Bool
+  af_cjk_axis_read( AF_CJKAxis  axis,
+                    FT_Byte**   ap,
+                    FT_Byte*    limit )
+  {
+    FT_Byte*  p = *ap;
+    FT_UInt   nn;
+
+
+    if ( limit - p < AF_AXIS_HEADER_SIZE + 1 )
+      return FALSE;
+
+    axis->width_count = FT_NEXT_USHORT( p );
+    if ( axis->width_count > AF_CJK_MAX_WIDTHS                         ||
+         limit - p < (FT_Long)( AF_AXIS_HEADER_SIZE + 1 - 2           +
+                                axis->width_count * AF_WIDTH_SIZE ) )
+      return FALSE;
+
+    for ( nn = 0; nn < axis->width_count; nn++ )
+      axis->widths[nn].org = FT_NEXT_LONG( p );
+
+    axis->edge_distance_threshold = FT_NEXT_LONG( p );
+    axis->standard_width          = FT_NEXT_LONG( p );
+    axis->extra_light             = FT_BOOL( FT_NEXT_BYTE( p ) );
+    axis->control_overshoot       = FT_BOOL( FT_NEXT_BYTE( p ) );
+
+    axis->blue_count = FT_NEXT_USHORT( p );
+    if ( axis->blue_count > AF_BLUE_STRINGSET_MAX                      ||
+         limit - p < (FT_Long)( axis->blue_count * AF_BLUE_SIZE )      )
+      return FALSE;
+
+    for ( nn = 0; nn < axis->blue_count; nn++ )
+    {
+      axis->blues[nn].ref.org   = FT_NEXT_LONG( p );
+      axis->blues[nn].shoot.org = FT_NEXT_LONG( p );
+      axis->blues[nn].flags     = FT_NEXT_USHORT( p );
+    }
+
+    *ap = p;
+
+    return TRUE;
+  }
+
+
+  /* Write the font-unit values of `metrics'. */
+
+  static FT_Byte*
+  af_metrics_data_write( AF_StyleMetrics  metrics,
+                         FT_Int           layout,
+                         FT_Byte*         p )
+  {
+    FT_UInt  dim;
+
+
+    if ( layout == AF_METRICS_LAYOUT_LATIN )
+    {
+      AF_LatinMetrics  latin = (AF_LatinMetrics)metrics;
+
+
+      AF_WRITE_USHORT( p, latin->units_per_em );
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        p = af_latin_axis_write( &latin->axis[dim], p );
+    }
+    else if ( layout == AF_METRICS_LAYOUT_CJK )
+    {
+      AF_CJKMetrics  cjk = (AF_CJKMetrics)metrics;
+
+
+      AF_WRITE_USHORT( p, cjk->units_per_em );
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        p = af_cjk_axis_write( &cjk->axis[dim], p );
+    }
+
+    return p;
+  }
+
+
+  /* Read the font-unit values of `metrics' from `p'; the data must end */
+  /* exactly at `limit'.                                                 */
+
+  static FT_Bool
+  af_metrics_data_read( AF_StyleMetrics  metrics,
+                        FT_Int           layout,
+                        FT_Face          face,
+                        FT_Byte*         p,
+                        FT_Byte*         limit )
+  {
+    FT_UInt  dim;
+
+
+    if ( layout == AF_METRICS_LAYOUT_LATIN )
+    {
+      AF_LatinMetrics  latin = (AF_LatinMetrics)metrics;
+
+
+      if ( limit - p < 2 )
+        return FALSE;
+
+      latin->units_per_em = FT_NEXT_USHORT( p );
+      if ( latin->units_per_em != face->units_per_EM )
+        return FALSE;
+
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        if ( !af_latin_axis_read( &latin->axis[dim], &p, limit ) )
+          return FALSE;
+    }
+    else if ( layout == AF_METRICS_LAYOUT_CJK )
+    {
+      AF_CJKMetrics  cjk = (AF_CJKMetrics)metrics;
+
+
+      if ( limit - p < 2 )
+        return FALSE;
+
+      cjk->units_per_em = FT_NEXT_USHORT( p );
+      if ( cjk->units_per_em != face->units_per_EM )
+        return FALSE;
+
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        if ( !af_cjk_axis_read( &cjk->axis[dim], &p, limit ) )
+          return FALSE;
+    }
+
+    return FT_BOOL( p == limit );
+  }
+
+
+  /* Write the face globals to `buffer'.  If `buffer' is NULL, only */
+  /* return the necessary size in `*alength'.                       */
+
+  FT_LOCAL_DEF( FT_Error )
+  af_face_globals_serialize( AF_FaceGlobals  globals,
+                             FT_Byte*        buffer,
+                             FT_ULong       *alength )
+  {
+    FT_Error   error;
+    FT_UInt32  fingerprint;
+    FT_UInt32  checksum;
+    FT_ULong   size;
+    FT_UInt    num_metrics = 0;
+    FT_UInt    nn;
+    FT_Byte*   p;
+
+
+    size = AF_GLOBALS_HEADER_SIZE + (FT_ULong)globals->glyph_count;
+
+    for ( nn = 0; nn < AF_STYLE_MAX; nn++ )
+    {
+      AF_StyleMetrics  metrics = globals->metrics[nn];
+      FT_Int           layout;
+
+
+      if ( !metrics )
+        continue;
+
+      layout = af_metrics_layout( AF_STYLE_CLASSES_GET[nn]->writing_system );
+      if ( layout < 0 )
+        continue;
+
+      size += AF_METRICS_HEADER_SIZE + af_metrics_data_size( metrics, layout );
+      num_metrics++;
+    }
+
+    if ( !buffer )
+    {
+      *alength = size;
+      return FT_Err_Ok;
+    }
+
+    if ( *alength < size )
+    {
+      *alength = size;
+      return FT_THROW( Invalid_Argument );
+    }
+
+    error = af_face_globals_fingerprint( globals->face,
+                                         globals->fallback_style,
+                                         globals->default_script,
+                                         &fingerprint );
+    if ( error )
+      return error;
+
+    p = buffer;
+
+    AF_WRITE_ULONG( p, AF_GLOBALS_DATA_MAGIC );
+    AF_WRITE_ULONG( p, AF_GLOBALS_DATA_VERSION );
+    AF_WRITE_ULONG( p, fingerprint );
+    p += 4;                                /* checksum, see below */
+    AF_WRITE_ULONG( p, (FT_ULong)globals->glyph_count );
+    AF_WRITE_USHORT( p, AF_STYLE_MAX );
+    AF_WRITE_USHORT( p, num_metrics );
+
+    FT_MEM_COPY( p,
+                 af_face_globals_get_glyph_styles( globals ),
+                 globals->glyph_count );
+    p += globals->glyph_count;
+
+    for ( nn = 0; nn < AF_STYLE_MAX; nn++ )
+    {
+      AF_StyleMetrics  metrics = globals->metrics[nn];
+      FT_Int           layout;
+      FT_ULong         data_size;
+
+
+      if ( !metrics )
+        continue;
+
+      layout = af_metrics_layout( AF_STYLE_CLASSES_GET[nn]->writing_system );
+      if ( layout < 0 )
+        continue;
+
+      data_size = af_metrics_data_size( metrics, layout );
+
+      AF_WRITE_USHORT( p, nn );
+      AF_WRITE_ULONG( p, data_size );
+      *p++ = (FT_Byte)metrics->digits_have_same_width;
+
+      p = af_metrics_data_write( metrics, layout, p );
+    }
+
+    checksum = af_hash_bytes( AF_HASH_INIT,
+                              buffer + AF_GLOBALS_HEADER_SIZE,
+                              size - AF_GLOBALS_HEADER_SIZE );
+
+    p = buffer + AF_GLOBALS_CHECKSUM_POS;
+    AF_WRITE_ULONG( p, checksum );
+
+    *alength = size;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* Create face globals from data written by `af_face_globals_serialize'. */
+
+  FT_LOCAL_DEF( FT_Error )
+  af_face_globals_deserialize( FT_Face          face,
+                               AF_FaceGlobals  *aglobals,
+                               AF_Module        module,
+                               const FT_Byte*   data,
+                               FT_ULong         length )
+  {
+    FT_Error        error;
+    FT_Memory       memory  = face->memory;
+    AF_FaceGlobals  globals = NULL;
+    FT_UInt32       fingerprint;
+    FT_UInt32       checksum;
+    FT_UInt         num_metrics;
+    FT_UInt         nn;
+    FT_Byte*        p;
+    FT_Byte*        limit;
+
+
+    *aglobals = NULL;
+
+    if ( !data                                                       ||
+         length < AF_GLOBALS_HEADER_SIZE + (FT_ULong)face->num_glyphs )
+      return FT_THROW( Invalid_Argument );
+
+    error = af_face_globals_fingerprint( face,
+                                         module->fallback_style,
+                                         module->default_script,
+                                         &fingerprint );
+    if ( error )
+      return error;
+
+    checksum = af_hash_bytes( AF_HASH_INIT,
+                              data + AF_GLOBALS_HEADER_SIZE,
+                              length - AF_GLOBALS_HEADER_SIZE );
+
+    p     = (FT_Byte*)data;
+    limit = p + length;
+
+    if ( FT_NEXT_ULONG( p ) != AF_GLOBALS_DATA_MAGIC           ||
+         FT_NEXT_ULONG( p ) != AF_GLOBALS_DATA_VERSION         ||
+         FT_NEXT_ULONG( p ) != fingerprint                     ||
+         FT_NEXT_ULONG( p ) != checksum                        ||
+         FT_NEXT_ULONG( p ) != (FT_ULong)face->num_glyphs      ||
+         FT_NEXT_USHORT( p ) != AF_STYLE_MAX                   )
+    {
+      FT_TRACE2(( "af_face_globals_deserialize:"
+                  " data doesn't match face or library\n" ));
+      return FT_THROW( Invalid_Argument );
+    }
+
+    num_metrics = FT_NEXT_USHORT( p );
+
+    error = af_face_globals_alloc( face, &globals, module );
+    if ( error )
+      return error;
+
+    for ( nn = 0; nn < (FT_UInt)globals->glyph_count; nn++ )
+    {
+      if ( ( p[nn] & AF_STYLE_UNASSIGNED ) >= AF_STYLE_MAX )
+        goto Invalid;
+    }
+
+    FT_MEM_COPY( globals->glyph_styles, p, globals->glyph_count );
+    p += globals->glyph_count;
+
+    globals->coverage_style = AF_STYLE_MAX + 1;
+
+    for ( nn = 0; nn < num_metrics; nn++ )
+    {
+      AF_StyleMetrics        metrics;
+      AF_StyleClass          style_class;
+      AF_WritingSystemClass  writing_system_class;
+      FT_UInt                style;
+      FT_ULong               data_size;
+      FT_Int                 layout;
+
+
+      if ( limit - p < AF_METRICS_HEADER_SIZE )
+        goto Invalid;
+
+      style = FT_NEXT_USHORT( p );
+      if ( style >= AF_STYLE_MAX || globals->metrics[style] )
+        goto Invalid;
+
+      style_class          = AF_STYLE_CLASSES_GET[style];
+      writing_system_class = AF_WRITING_SYSTEM_CLASSES_GET
+                               [style_class->writing_system];
+      layout               = af_metrics_layout(
+                               style_class->writing_system );
+
+      data_size = FT_NEXT_ULONG( p );
+      if ( layout < 0 || data_size > (FT_ULong)( limit - p - 1 ) )
+        goto Invalid;
+
+      if ( FT_ALLOC( metrics, writing_system_class->style_metrics_size ) )
+        goto Fail;
+
+      metrics->style_class            = style_class;
+      metrics->globals                = globals;
+      metrics->digits_have_same_width = FT_BOOL( *p++ );
+
+      globals->metrics[style] = metrics;
+
+      if ( !af_metrics_data_read( metrics, layout, face,
+                                  p, p + data_size ) )
+        goto Invalid;
+
+      p += data_size;
+    }
+
+    if ( p != limit )
+      goto Invalid;
 
-  Exit:
     *aglobals = globals;
+
+    return FT_Err_Ok;
+
+  Invalid:
+    FT_TRACE2(( "af_face_globals_deserialize: invalid data\n" ));
+    error = FT_THROW( Invalid_Argument );
+
+  Fail:
+    af_face_globals_free( globals );
     return error;
   }
 
@@ -364,6 +1207,7 @@
           if ( writing_system_class->style_metrics_done )
             writing_system_class->style_metrics_done( globals->metrics[nn] );
 
+          af_glyph_analyses_free( globals->metrics[nn], memory );
           FT_FREE( globals->metrics[nn] );
         }
       }
@@ -406,8 +1250,7 @@
     /* if we have a forced style (via `options'), use it, */
     /* otherwise look into `glyph_styles' array           */
     if ( style == AF_STYLE_NONE_DFLT || style + 1 >= AF_STYLE_MAX )
-      style = (AF_Style)( globals->glyph_styles[gindex] &
-                          AF_STYLE_UNASSIGNED           );
+      style = (AF_Style)af_face_globals_get_style( globals, gindex );
 
     style_class          = AF_STYLE_CLASSES_GET[style];
     writing_system_class = AF_WRITING_SYSTEM_CLASSES_GET
@@ -93,7 +93,8 @@ FT_BEGIN_HEADER
 
   /*
    *  Note that glyph_styles[] maps each glyph to an index into the
-   *  `af_style_classes' array.
+   *  `af_style_classes' array.  The entries are computed on demand; use
+   *  `af_face_globals_get_glyph_styles' to access the complete array.
    *
    */
   typedef struct  AF_FaceGlobalsRec_
@@ -102,6 +103,12 @@ FT_BEGIN_HEADER
     FT_Long          glyph_count;    /* same as face->num_glyphs */
     FT_Byte*         glyph_styles;
 
+    /* state of the incremental computation of `glyph_styles', */
+    /* and the module properties it depends on                 */
+    FT_UInt          coverage_style;
+    FT_UInt          fallback_style;
+    FT_UInt          default_script;
+
 #ifdef FT_CONFIG_OPTION_USE_HARFBUZZ
     hb_font_t*       hb_font;
 #endif
@@ -132,9 +139,24 @@ FT_BEGIN_HEADER
                                FT_UInt           options,
                                AF_StyleMetrics  *ametrics );
 
+  FT_LOCAL( FT_Byte* )
+  af_face_globals_get_glyph_styles( AF_FaceGlobals  globals );
+
   FT_LOCAL( void )
   af_face_globals_free( AF_FaceGlobals  globals );
 
+  FT_LOCAL( FT_Error )
+  af_face_globals_serialize( AF_FaceGlobals  globals,
+                             FT_Byte*        buffer,
+                             FT_ULong       *alength );
+
+  FT_LOCAL( FT_Error )
+  af_face_globals_deserialize( FT_Face          face,
+                               AF_FaceGlobals  *aglobals,
+                               AF_Module        module,
+                               const FT_Byte*   data,
+                               FT_ULong         length );
+
   FT_LOCAL_DEF( FT_Bool )
   af_face_globals_is_digit( AF_FaceGlobals  globals,
                             FT_UInt         gindex );
@@ -205,10 +205,10 @@
                 AF_INDEX_NUM( point, points ),
                 point->fx,
                 point->fy,
-                point->ox / 64.0,
-                point->oy / 64.0,
-                point->x / 64.0,
-                point->y / 64.0,
+                hints->ox[point - points] / 64.0,
+                hints->oy[point - points] / 64.0,
+                hints->x[point - points] / 64.0,
+                hints->y[point - points] / 64.0,
                 ( point->flags & AF_FLAG_WEAK_INTERPOLATION ) ? 'w' : ' '));
     AF_DUMP(( "\n" ));
   }
@@ -283,8 +283,8 @@
                   " | %6d | %5d | %11s ]\n",
                   AF_INDEX_NUM( seg, segments ),
                   dimension == AF_DIMENSION_HORZ
-                               ? (int)seg->first->ox / 64.0
-                               : (int)seg->first->oy / 64.0,
+                               ? (int)hints->ox[seg->first - points] / 64.0
+                               : (int)hints->oy[seg->first - points] / 64.0,
                   af_dir_str( (AF_Direction)seg->dir ),
                   AF_INDEX_NUM( seg->first, points ),
                   AF_INDEX_NUM( seg->last, points ),
@@ -357,8 +357,9 @@
       return FT_THROW( Invalid_Argument );
 
     seg      = &axis->segments[idx];
-    *offset  = ( dim == AF_DIMENSION_HORZ ) ? seg->first->ox
-                                            : seg->first->oy;
+    *offset  = ( dim == AF_DIMENSION_HORZ )
+                 ? hints->ox[seg->first - hints->points]
+                 : hints->oy[seg->first - hints->points];
     if ( seg->edge )
       *is_blue = (FT_Bool)( seg->edge->blue_edge != 0 );
     else
@@ -529,6 +530,12 @@
     hints->num_points = 0;
     hints->max_points = 0;
 
+    /* the coordinate arrays share a single block */
+    FT_FREE( hints->x );
+    hints->y  = NULL;
+    hints->ox = NULL;
+    hints->oy = NULL;
+
     hints->memory = NULL;
   }
 
@@ -544,12 +551,12 @@
   }
 
 
-  /* Recompute all AF_Point in AF_GlyphHints from the definitions */
-  /* in a source outline.                                         */
+  /* Load the points and contours of a source outline into */
+  /* AF_GlyphHints, without analyzing the outline.          */
 
-  FT_LOCAL_DEF( FT_Error )
-  af_glyph_hints_reload( AF_GlyphHints  hints,
-                         FT_Outline*    outline )
+  static FT_Error
+  af_glyph_hints_load_outline( AF_GlyphHints  hints,
+                               FT_Outline*    outline )
   {
     FT_Error   error   = FT_Err_Ok;
     AF_Point   points;
@@ -593,28 +600,20 @@
     {
       new_max = ( new_max + 2 + 7 ) & ~7; /* round up to a multiple of 8 */
 
-      if ( FT_RENEW_ARRAY( hints->points, old_max, new_max ) )
+      if ( FT_RENEW_ARRAY( hints->points, old_max, new_max )     ||
+           FT_QRENEW_ARRAY( hints->x, old_max * 4, new_max * 4 ) )
         goto Exit;
 
+      hints->y  = hints->x + new_max;
+      hints->ox = hints->y + new_max;
+      hints->oy = hints->ox + new_max;
+
       hints->max_points = new_max;
     }
 
     hints->num_points   = outline->n_points;
     hints->num_contours = outline->n_contours;
 
-    /* We can't rely on the value of `FT_Outline.flags' to know the fill   */
-    /* direction used for a glyph, given that some fonts are broken (e.g., */
-    /* the Arphic ones).  We thus recompute it each time we need to.       */
-    /*                                                                     */
-    hints->axis[AF_DIMENSION_HORZ].major_dir = AF_DIR_UP;
-    hints->axis[AF_DIMENSION_VERT].major_dir = AF_DIR_LEFT;
-
-    if ( FT_Outline_Get_Orientation( outline ) == FT_ORIENTATION_POSTSCRIPT )
-    {
-      hints->axis[AF_DIMENSION_HORZ].major_dir = AF_DIR_DOWN;
-      hints->axis[AF_DIMENSION_VERT].major_dir = AF_DIR_RIGHT;
-    }
-
     hints->x_scale = x_scale;
     hints->y_scale = y_scale;
     hints->x_delta = x_delta;
@@ -639,17 +638,23 @@
         AF_Point    end           = points + outline->contours[0];
         AF_Point    prev          = end;
         FT_Int      contour_index = 0;
+        FT_Int      nn            = 0;
 
 
-        for ( point = points; point < point_limit; point++, vec++, tag++ )
+        for ( point = points;
+              point < point_limit;
+              point++, vec++, tag++, nn++ )
         {
           point->in_dir  = (FT_Char)AF_DIR_NONE;
           point->out_dir = (FT_Char)AF_DIR_NONE;
 
           point->fx = (FT_Short)vec->x;
           point->fy = (FT_Short)vec->y;
-          point->ox = point->x = FT_MulFix( vec->x, x_scale ) + x_delta;
-          point->oy = point->y = FT_MulFix( vec->y, y_scale ) + y_delta;
+
+          hints->ox[nn] = hints->x[nn] = FT_MulFix( vec->x, x_scale ) +
+                                         x_delta;
+          hints->oy[nn] = hints->y[nn] = FT_MulFix( vec->y, y_scale ) +
+                                         y_delta;
 
           switch ( FT_CURVE_TAG( *tag ) )
           {
@@ -692,6 +697,49 @@
           idx        = (short)( end[0] + 1 );
         }
       }
+    }
+
+  Exit:
+    return error;
+  }
+
+
+  /* Recompute all AF_Point in AF_GlyphHints from the definitions */
+  /* in a source outline.                                         */
+
+  FT_LOCAL_DEF( FT_Error )
+  af_glyph_hints_reload( AF_GlyphHints  hints,
+                         FT_Outline*    outline )
+  {
+    FT_Error  error;
+    AF_Point  points;
+
+
+    error = af_glyph_hints_load_outline( hints, outline );
+    if ( error )
+      goto Exit;
+
+    /* We can't rely on the value of `FT_Outline.flags' to know the fill   */
+    /* direction used for a glyph, given that some fonts are broken (e.g., */
+    /* the Arphic ones).  We thus recompute it each time we need to.       */
+    /*                                                                     */
+    hints->axis[AF_DIMENSION_HORZ].major_dir = AF_DIR_UP;
+    hints->axis[AF_DIMENSION_VERT].major_dir = AF_DIR_LEFT;
+
+    if ( FT_Outline_Get_Orientation( outline ) == FT_ORIENTATION_POSTSCRIPT )
+    {
+      hints->axis[AF_DIMENSION_HORZ].major_dir = AF_DIR_DOWN;
+      hints->axis[AF_DIMENSION_VERT].major_dir = AF_DIR_RIGHT;
+    }
+
+    points = hints->points;
+    if ( hints->num_points == 0 )
+      goto Exit;
+
+    {
+      AF_Point  point;
+      AF_Point  point_limit = points + hints->num_points;
+
 
       {
         /*
@@ -924,6 +972,341 @@
   }
 
 
+  /* Release the arrays of an analysis cache entry and mark it unused. */
+
+  static void
+  af_glyph_analysis_clear( AF_GlyphAnalysis  analysis,
+                           FT_Memory         memory )
+  {
+    FT_Int  dim;
+
+
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+    {
+      FT_FREE( analysis->segments[dim] );
+      analysis->num_segments[dim] = 0;
+    }
+
+    FT_FREE( analysis->points );
+    FT_FREE( analysis->contours );
+
+    analysis->num_points   = 0;
+    analysis->num_contours = 0;
+    analysis->dims         = 0;
+  }
+
+
+  /* Return the cache entry of the glyph being hinted if it has been */
+  /* computed for the very same outline, or NULL otherwise.           */
+
+  static AF_GlyphAnalysis
+  af_glyph_analysis_lookup( AF_GlyphHints  hints,
+                            FT_Outline*    outline )
+  {
+    AF_GlyphAnalysis  analysis = hints->metrics->analyses;
+    AF_CachedPoint    cpoint;
+    FT_Vector*        vec;
+    char*             tag;
+    FT_Int            nn;
+
+
+    if ( !analysis )
+      return NULL;
+
+    analysis += hints->glyph_index % AF_GLYPH_ANALYSIS_CACHE_SIZE;
+
+    if ( analysis->num_points   == 0                   ||
+         analysis->glyph_index  != hints->glyph_index  ||
+         analysis->num_points   != outline->n_points   ||
+         analysis->num_contours != outline->n_contours )
+      return NULL;
+
+    for ( nn = 0; nn < outline->n_contours; nn++ )
+      if ( analysis->contours[nn] != outline->contours[nn] )
+        return NULL;
+
+    cpoint = analysis->points;
+    vec    = outline->points;
+    tag    = outline->tags;
+
+    for ( nn = 0; nn < outline->n_points; nn++, cpoint++, vec++, tag++ )
+    {
+      FT_UInt  control;
+
+
+      if ( cpoint->fx != (FT_Short)vec->x ||
+           cpoint->fy != (FT_Short)vec->y )
+        return NULL;
+
+      switch ( FT_CURVE_TAG( *tag ) )
+      {
+      case FT_CURVE_TAG_CONIC:
+        control = AF_FLAG_CONIC;
+        break;
+      case FT_CURVE_TAG_CUBIC:
+        control = AF_FLAG_CUBIC;
+        break;
+      default:
+        control = AF_FLAG_NONE;
+      }
+
+      if ( ( cpoint->flags & AF_FLAG_CONTROL ) != control )
+        return NULL;
+    }
+
+    return analysis;
+  }
+
+
+  /* Like `af_glyph_hints_reload', but take the outline topology and */
+  /* the segments from the glyph analysis cache if possible.  On     */
+  /* return, `*acached' holds the mask of the dimensions whose       */
+  /* segments have been restored from the cache.                     */
+
+  FT_LOCAL_DEF( FT_Error )
+  af_glyph_hints_reload_cached( AF_GlyphHints  hints,
+                                FT_Outline*    outline,
+                                FT_UInt       *acached )
+  {
+    FT_Error          error;
+    FT_Memory         memory = hints->memory;
+    AF_GlyphAnalysis  analysis;
+    AF_Point          points;
+    FT_UInt           cached = 0;
+    FT_Int            dim;
+
+
+    analysis = af_glyph_analysis_lookup( hints, outline );
+    if ( !analysis )
+    {
+      error = af_glyph_hints_reload( hints, outline );
+      goto Exit;
+    }
+
+    error = af_glyph_hints_load_outline( hints, outline );
+    if ( error )
+      goto Exit;
+
+    points = hints->points;
+
+    {
+      AF_Point        point       = points;
+      AF_Point        point_limit = points + hints->num_points;
+      AF_CachedPoint  cpoint      = analysis->points;
+
+
+      for ( ; point < point_limit; point++, cpoint++ )
+      {
+        point->flags   = cpoint->flags;
+        point->in_dir  = cpoint->in_dir;
+        point->out_dir = cpoint->out_dir;
+      }
+    }
+
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+    {
+      AF_AxisHints      axis = &hints->axis[dim];
+      AF_Segment        segment;
+      AF_CachedSegment  csegment;
+      FT_Int            num_segments, nn;
+
+
+      axis->major_dir = (AF_Direction)analysis->major_dir[dim];
+
+      if ( !( analysis->dims & AF_DIMENSION_MASK( dim ) ) )
+        continue;
+
+      num_segments = analysis->num_segments[dim];
+      if ( num_segments > axis->max_segments )
+      {
+        if ( FT_RENEW_ARRAY( axis->segments,
+                             axis->max_segments,
+                             num_segments ) )
+          goto Exit;
+
+        axis->max_segments = num_segments;
+      }
+
+      segment  = axis->segments;
+      csegment = analysis->segments[dim];
+
+      for ( nn = 0; nn < num_segments; nn++, segment++, csegment++ )
+      {
+        segment->flags     = csegment->flags;
+        segment->dir       = csegment->dir;
+        segment->pos       = csegment->pos;
+        segment->min_coord = csegment->min_coord;
+        segment->max_coord = csegment->max_coord;
+        segment->height    = csegment->height;
+
+        segment->edge      = NULL;
+        segment->edge_next = NULL;
+
+        segment->link  = csegment->link < 0
+                           ? NULL
+                           : axis->segments + csegment->link;
+        segment->serif = csegment->serif < 0
+                           ? NULL
+                           : axis->segments + csegment->serif;
+
+        segment->num_linked = csegment->num_linked;
+        segment->score      = csegment->score;
+        segment->len        = csegment->len;
+
+        segment->first = points + csegment->first;
+        segment->last  = points + csegment->last;
+      }
+
+      axis->num_segments = num_segments;
+
+      cached |= AF_DIMENSION_MASK( dim );
+    }
+
+  Exit:
+    *acached = cached;
+    return error;
+  }
+
+
+  /* Store the segments of dimensions `dims' (a mask) in the glyph      */
+  /* analysis cache, together with the outline topology.  `cached' is   */
+  /* the mask returned by `af_glyph_hints_reload_cached'.  The segments */
+  /* must not have been modified by edge computation yet.  Allocation   */
+  /* errors are ignored; the glyph simply isn't cached then.            */
+
+  FT_LOCAL_DEF( void )
+  af_glyph_hints_cache_analysis( AF_GlyphHints  hints,
+                                 FT_UInt        cached,
+                                 FT_UInt        dims )
+  {
+    AF_StyleMetrics   metrics = hints->metrics;
+    FT_Memory         memory  = metrics->globals->face->memory;
+    FT_Error          error;
+    AF_GlyphAnalysis  analysis;
+    AF_Point          points  = hints->points;
+    FT_Int            dim, nn;
+
+
+    dims &= ~cached;
+    if ( !dims || hints->num_points == 0 )
+      return;
+
+    if ( !metrics->analyses                                           &&
+         FT_NEW_ARRAY( metrics->analyses, AF_GLYPH_ANALYSIS_CACHE_SIZE ) )
+      return;
+
+    analysis = metrics->analyses +
+                 hints->glyph_index % AF_GLYPH_ANALYSIS_CACHE_SIZE;
+
+    /* a new glyph (or a changed outline) replaces the whole entry */
+    if ( !cached )
+    {
+      AF_Point        point;
+      AF_Point        point_limit = points + hints->num_points;
+      AF_CachedPoint  cpoint;
+
+
+      af_glyph_analysis_clear( analysis, memory );
+
+      if ( FT_NEW_ARRAY( analysis->points, hints->num_points )     ||
+           FT_NEW_ARRAY( analysis->contours, hints->num_contours ) )
+        goto Fail;
+
+      cpoint = analysis->points;
+      for ( point = points; point < point_limit; point++, cpoint++ )
+      {
+        cpoint->fx      = point->fx;
+        cpoint->fy      = point->fy;
+        cpoint->flags   = point->flags;
+        cpoint->in_dir  = point->in_dir;
+        cpoint->out_dir = point->out_dir;
+      }
+
+      /* the end point of a contour precedes its first point */
+      for ( nn = 0; nn < hints->num_contours; nn++ )
+        analysis->contours[nn] = (FT_Short)( hints->contours[nn]->prev -
+                                             points );
+
+      for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+        analysis->major_dir[dim] = (FT_Char)hints->axis[dim].major_dir;
+
+      analysis->glyph_index  = hints->glyph_index;
+      analysis->num_points   = hints->num_points;
+      analysis->num_contours = hints->num_contours;
+    }
+
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
+    {
+      AF_AxisHints      axis = &hints->axis[dim];
+      AF_Segment        segment;
+      AF_Segment        segments;
+      AF_CachedSegment  csegment;
+
+
+      if ( !( dims & AF_DIMENSION_MASK( dim ) ) )
+        continue;
+
+      segments = axis->segments;
+
+      if ( FT_NEW_ARRAY( analysis->segments[dim], axis->num_segments ) )
+        goto Fail;
+
+      segment  = segments;
+      csegment = analysis->segments[dim];
+
+      for ( nn = 0; nn < axis->num_segments; nn++, segment++, csegment++ )
+      {
+        csegment->flags     = segment->flags;
+        csegment->dir       = segment->dir;
+        csegment->pos       = segment->pos;
+        csegment->min_coord = segment->min_coord;
+        csegment->max_coord = segment->max_coord;
+        csegment->height    = segment->height;
+
+        csegment->first = (FT_Short)( segment->first - points );
+        csegment->last  = (FT_Short)( segment->last - points );
+        csegment->link  = segment->link
+                            ? (FT_Short)( segment->link - segments )
+                            : -1;
+        csegment->serif = segment->serif
+                            ? (FT_Short)( segment->serif - segments )
+                            : -1;
+
+        csegment->num_linked = segment->num_linked;
+        csegment->score      = segment->score;
+        csegment->len        = segment->len;
+      }
+
+      analysis->num_segments[dim] = axis->num_segments;
+      analysis->dims             |= AF_DIMENSION_MASK( dim );
+    }
+
+    return;
+
+  Fail:
+    af_glyph_analysis_clear( analysis, memory );
+  }
+
+
+  /* Free the glyph analysis cache of a style. */
+
+  FT_LOCAL_DEF( void )
+  af_glyph_analyses_free( AF_StyleMetrics  metrics,
+                          FT_Memory        memory )
+  {
+    if ( metrics->analyses )
+    {
+      FT_UInt  nn;
+
+
+      for ( nn = 0; nn < AF_GLYPH_ANALYSIS_CACHE_SIZE; nn++ )
+        af_glyph_analysis_clear( metrics->analyses + nn, memory );
+
+      FT_FREE( metrics->analyses );
+    }
+  }
+
+
   /* Store the hinted outline in an FT_Outline structure. */
 
   FT_LOCAL_DEF( void )
@@ -932,14 +1315,16 @@
   {
     AF_Point    point = hints->points;
     AF_Point    limit = point + hints->num_points;
+    FT_Pos*     x     = hints->x;
+    FT_Pos*     y     = hints->y;
     FT_Vector*  vec   = outline->points;
     char*       tag   = outline->tags;
 
 
     for ( ; point < limit; point++, vec++, tag++ )
     {
-      vec->x = point->x;
-      vec->y = point->y;
+      vec->x = *x++;
+      vec->y = *y++;
 
       if ( point->flags & AF_FLAG_CONIC )
         tag[0] = FT_CURVE_TAG_CONIC;
@@ -969,58 +1354,43 @@
     AF_Segment    segments      = axis->segments;
     AF_Segment    segment_limit = segments + axis->num_segments;
     AF_Segment    seg;
+    AF_Point      points        = hints->points;
+    FT_Pos*       cur;
+    AF_Flags      touch_flag;
 
 
     if ( dim == AF_DIMENSION_HORZ )
     {
-      for ( seg = segments; seg < segment_limit; seg++ )
-      {
-        AF_Edge   edge = seg->edge;
-        AF_Point  point, first, last;
-
-
-        if ( edge == NULL )
-          continue;
-
-        first = seg->first;
-        last  = seg->last;
-        point = first;
-        for (;;)
-        {
-          point->x      = edge->pos;
-          point->flags |= AF_FLAG_TOUCH_X;
-
-          if ( point == last )
-            break;
-
-          point = point->next;
-        }
-      }
+      cur        = hints->x;
+      touch_flag = AF_FLAG_TOUCH_X;
     }
     else
     {
-      for ( seg = segments; seg < segment_limit; seg++ )
-      {
-        AF_Edge   edge = seg->edge;
-        AF_Point  point, first, last;
+      cur        = hints->y;
+      touch_flag = AF_FLAG_TOUCH_Y;
+    }
 
+    for ( seg = segments; seg < segment_limit; seg++ )
+    {
+      AF_Edge   edge = seg->edge;
+      AF_Point  point, first, last;
 
-        if ( edge == NULL )
-          continue;
 
-        first = seg->first;
-        last  = seg->last;
-        point = first;
-        for (;;)
-        {
-          point->y      = edge->pos;
-          point->flags |= AF_FLAG_TOUCH_Y;
+      if ( edge == NULL )
+        continue;
 
-          if ( point == last )
-            break;
+      first = seg->first;
+      last  = seg->last;
+      point = first;
+      for (;;)
+      {
+        cur[point - points] = edge->pos;
+        point->flags       |= touch_flag;
 
-          point = point->next;
-        }
+        if ( point == last )
+          break;
+
+        point = point->next;
       }
     }
   }
@@ -1041,28 +1411,39 @@
                                       AF_Dimension   dim )
   {
     AF_Point      points      = hints->points;
-    AF_Point      point_limit = points + hints->num_points;
+    FT_Int        num_points  = hints->num_points;
     AF_AxisHints  axis        = &hints->axis[dim];
     AF_Edge       edges       = axis->edges;
     AF_Edge       edge_limit  = edges + axis->num_edges;
+    FT_Pos*       cur;
+    FT_Pos*       org;
     AF_Flags      touch_flag;
 
 
     if ( dim == AF_DIMENSION_HORZ )
+    {
+      cur        = hints->x;
+      org        = hints->ox;
       touch_flag = AF_FLAG_TOUCH_X;
+    }
     else
-      touch_flag  = AF_FLAG_TOUCH_Y;
+    {
+      cur        = hints->y;
+      org        = hints->oy;
+      touch_flag = AF_FLAG_TOUCH_Y;
+    }
 
     if ( edges < edge_limit )
     {
-      AF_Point  point;
-      AF_Edge   edge;
+      FT_Int   nn;
+      AF_Edge  edge;
 
 
-      for ( point = points; point < point_limit; point++ )
+      for ( nn = 0; nn < num_points; nn++ )
       {
-        FT_Pos  u, ou, fu;  /* point position */
-        FT_Pos  delta;
+        AF_Point  point = points + nn;
+        FT_Pos    u, ou, fu;  /* point position */
+        FT_Pos    delta;
 
 
         if ( point->flags & touch_flag )
@@ -1075,16 +1456,11 @@
           continue;
 
         if ( dim == AF_DIMENSION_VERT )
-        {
-          u  = point->fy;
-          ou = point->oy;
-        }
+          u = point->fy;
         else
-        {
-          u  = point->fx;
-          ou = point->ox;
-        }
+          u = point->fx;
 
+        ou = org[nn];
         fu = u;
 
         /* is the point before the first edge? */
@@ -1118,19 +1494,19 @@
           /* for a small number of edges, a linear search is better */
           if ( max <= 8 )
           {
-            FT_PtrDist  nn;
+            FT_PtrDist  mm;
 
 
-            for ( nn = 0; nn < max; nn++ )
-              if ( edges[nn].fpos >= u )
+            for ( mm = 0; mm < max; mm++ )
+              if ( edges[mm].fpos >= u )
                 break;
 
-            if ( edges[nn].fpos == u )
+            if ( edges[mm].fpos == u )
             {
-              u = edges[nn].pos;
+              u = edges[mm].pos;
               goto Store_Point;
             }
-            min = nn;
+            min = mm;
           }
           else
 #endif
@@ -1170,10 +1546,7 @@
 
       Store_Point:
         /* save the point position */
-        if ( dim == AF_DIMENSION_HORZ )
-          point->x = u;
-        else
-          point->y = u;
+        cur[nn] = u;
 
         point->flags |= touch_flag;
       }
@@ -1190,47 +1563,54 @@
 
   /* Shift the original coordinates of all points between `p1' and */
   /* `p2' to get hinted coordinates, using the same difference as  */
-  /* given by `ref'.                                               */
+  /* given by `ref'.  `cur' and `org' are the arrays of current    */
+  /* and original coordinate values, respectively.                 */
 
   static void
-  af_iup_shift( AF_Point  p1,
-                AF_Point  p2,
-                AF_Point  ref )
+  af_iup_shift( FT_Pos*  cur,
+                FT_Pos*  org,
+                FT_Int   p1,
+                FT_Int   p2,
+                FT_Int   ref )
   {
-    AF_Point  p;
-    FT_Pos    delta = ref->u - ref->v;
+    FT_Int  p;
+    FT_Pos  delta = cur[ref] - org[ref];
 
 
     if ( delta == 0 )
       return;
 
     for ( p = p1; p < ref; p++ )
-      p->u = p->v + delta;
+      cur[p] = org[p] + delta;
 
     for ( p = ref + 1; p <= p2; p++ )
-      p->u = p->v + delta;
+      cur[p] = org[p] + delta;
   }
 
 
   /* Interpolate the original coordinates of all points between `p1' and  */
   /* `p2' to get hinted coordinates, using `ref1' and `ref2' as the       */
-  /* reference points.  The `u' and `v' members are the current and       */
+  /* reference points.  `cur' and `org' are the arrays of current and     */
   /* original coordinate values, respectively.                            */
   /*                                                                      */
   /* Details can be found in the TrueType bytecode specification.         */
 
   static void
-  af_iup_interp( AF_Point  p1,
-                 AF_Point  p2,
-                 AF_Point  ref1,
-                 AF_Point  ref2 )
+  af_iup_interp( FT_Pos*  cur,
+                 FT_Pos*  org,
+                 FT_Int   p1,
+                 FT_Int   p2,
+                 FT_Int   ref1,
+                 FT_Int   ref2 )
   {
-    AF_Point  p;
-    FT_Pos    u;
-    FT_Pos    v1 = ref1->v;
-    FT_Pos    v2 = ref2->v;
-    FT_Pos    d1 = ref1->u - v1;
-    FT_Pos    d2 = ref2->u - v2;
+    FT_Int  p;
+    FT_Pos  u;
+    FT_Pos  v1 = org[ref1];
+    FT_Pos  v2 = org[ref2];
+    FT_Pos  u1 = cur[ref1];
+    FT_Pos  u2 = cur[ref2];
+    FT_Pos  d1 = u1 - v1;
+    FT_Pos  d2 = u2 - v2;
 
 
     if ( p1 > p2 )
@@ -1240,14 +1620,14 @@
     {
       for ( p = p1; p <= p2; p++ )
       {
-        u = p->v;
+        u = org[p];
 
         if ( u <= v1 )
           u += d1;
         else
           u += d2;
 
-        p->u = u;
+        cur[p] = u;
       }
       return;
     }
@@ -1256,32 +1636,32 @@
     {
       for ( p = p1; p <= p2; p++ )
       {
-        u = p->v;
+        u = org[p];
 
         if ( u <= v1 )
           u += d1;
         else if ( u >= v2 )
           u += d2;
         else
-          u = ref1->u + FT_MulDiv( u - v1, ref2->u - ref1->u, v2 - v1 );
+          u = u1 + FT_MulDiv( u - v1, u2 - u1, v2 - v1 );
 
-        p->u = u;
+        cur[p] = u;
       }
     }
     else
     {
       for ( p = p1; p <= p2; p++ )
       {
-        u = p->v;
+        u = org[p];
 
         if ( u <= v2 )
           u += d2;
         else if ( u >= v1 )
           u += d1;
         else
-          u = ref1->u + FT_MulDiv( u - v1, ref2->u - ref1->u, v2 - v1 );
+          u = u1 + FT_MulDiv( u - v1, u2 - u1, v2 - v1 );
 
-        p->u = u;
+        cur[p] = u;
       }
     }
   }
@@ -1295,45 +1675,40 @@
                                     AF_Dimension   dim )
   {
     AF_Point   points        = hints->points;
-    AF_Point   point_limit   = points + hints->num_points;
     AF_Point*  contour       = hints->contours;
     AF_Point*  contour_limit = contour + hints->num_contours;
+    FT_Pos*    cur;
+    FT_Pos*    org;
     AF_Flags   touch_flag;
-    AF_Point   point;
-    AF_Point   end_point;
-    AF_Point   first_point;
+    FT_Int     point;
+    FT_Int     end_point;
+    FT_Int     first_point;
 
 
-    /* PASS 1: Move segment points to edge positions */
+    /* the interpolation works in place on the current coordinates; */
+    /* only untouched points get modified, and only touched points  */
+    /* are used as references                                       */
 
     if ( dim == AF_DIMENSION_HORZ )
     {
+      cur        = hints->x;
+      org        = hints->ox;
       touch_flag = AF_FLAG_TOUCH_X;
-
-      for ( point = points; point < point_limit; point++ )
-      {
-        point->u = point->x;
-        point->v = point->ox;
-      }
     }
     else
     {
+      cur        = hints->y;
+      org        = hints->oy;
       touch_flag = AF_FLAG_TOUCH_Y;
-
-      for ( point = points; point < point_limit; point++ )
-      {
-        point->u = point->y;
-        point->v = point->oy;
-      }
     }
 
     for ( ; contour < contour_limit; contour++ )
     {
-      AF_Point  first_touched, last_touched;
+      FT_Int  first_touched, last_touched;
 
 
-      point       = *contour;
-      end_point   = point->prev;
+      point       = (FT_Int)( *contour - points );
+      end_point   = (FT_Int)( (*contour)->prev - points );
       first_point = point;
 
       /* find first touched point */
@@ -1342,7 +1717,7 @@
         if ( point > end_point )  /* no touched point in contour */
           goto NextContour;
 
-        if ( point->flags & touch_flag )
+        if ( points[point].flags & touch_flag )
           break;
 
         point++;
@@ -1352,12 +1727,12 @@
 
       for (;;)
       {
-        FT_ASSERT( point <= end_point                 &&
-                   ( point->flags & touch_flag ) != 0 );
+        FT_ASSERT( point <= end_point                        &&
+                   ( points[point].flags & touch_flag ) != 0 );
 
         /* skip any touched neighbours */
-        while ( point < end_point                    &&
-                ( point[1].flags & touch_flag ) != 0 )
+        while ( point < end_point                            &&
+                ( points[point + 1].flags & touch_flag ) != 0 )
           point++;
 
         last_touched = point;
@@ -1369,48 +1744,39 @@
           if ( point > end_point )
             goto EndContour;
 
-          if ( ( point->flags & touch_flag ) != 0 )
+          if ( ( points[point].flags & touch_flag ) != 0 )
             break;
 
           point++;
         }
 
         /* interpolate between last_touched and point */
-        af_iup_interp( last_touched + 1, point - 1,
+        af_iup_interp( cur, org,
+                       last_touched + 1, point - 1,
                        last_touched, point );
       }
 
     EndContour:
       /* special case: only one point was touched */
       if ( last_touched == first_touched )
-        af_iup_shift( first_point, end_point, first_touched );
+        af_iup_shift( cur, org, first_point, end_point, first_touched );
 
       else /* interpolate the last part */
       {
         if ( last_touched < end_point )
-          af_iup_interp( last_touched + 1, end_point,
+          af_iup_interp( cur, org,
+                         last_touched + 1, end_point,
                          last_touched, first_touched );
 
-        if ( first_touched > points )
-          af_iup_interp( first_point, first_touched - 1,
+        if ( first_touched > 0 )
+          af_iup_interp( cur, org,
+                         first_point, first_touched - 1,
                          last_touched, first_touched );
       }
 
     NextContour:
       ;
     }
-
-    /* now save the interpolated values back to x/y */
-    if ( dim == AF_DIMENSION_HORZ )
-    {
-      for ( point = points; point < point_limit; point++ )
-        point->x = point->u;
-    }
-    else
-    {
-      for ( point = points; point < point_limit; point++ )
-        point->y = point->u;
-    }
   }
 
 
@@ -1424,20 +1790,26 @@
                             FT_Fixed       scale,
                             FT_Pos         delta )
   {
-    AF_Point  points       = hints->points;
-    AF_Point  points_limit = points + hints->num_points;
-    AF_Point  point;
+    AF_Point  points     = hints->points;
+    FT_Int    num_points = hints->num_points;
+    FT_Int    nn;
 
 
     if ( dim == AF_DIMENSION_HORZ )
     {
-      for ( point = points; point < points_limit; point++ )
-        point->x = FT_MulFix( point->fx, scale ) + delta;
+      FT_Pos*  x = hints->x;
+
+
+      for ( nn = 0; nn < num_points; nn++ )
+        x[nn] = FT_MulFix( points[nn].fx, scale ) + delta;
     }
     else
     {
-      for ( point = points; point < points_limit; point++ )
-        point->y = FT_MulFix( point->fy, scale ) + delta;
+      FT_Pos*  y = hints->y;
+
+
+      for ( nn = 0; nn < num_points; nn++ )
+        y[nn] = FT_MulFix( points[nn].fy, scale ) + delta;
     }
   }
 
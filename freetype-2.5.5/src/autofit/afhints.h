@@ -243,15 +243,19 @@ FT_BEGIN_HEADER
   typedef struct AF_EdgeRec_*     AF_Edge;
 
 
+  /*
+   *  The scaled coordinates of a point (original and current ones) are
+   *  not stored in this structure but in separate arrays of
+   *  AF_GlyphHintsRec, indexed like the `points' array, so that the
+   *  interpolation passes can work on contiguous data.
+   */
   typedef struct  AF_PointRec_
   {
     FT_UShort  flags;    /* point flags used by hinter   */
     FT_Char    in_dir;   /* direction of inwards vector  */
     FT_Char    out_dir;  /* direction of outwards vector */
 
-    FT_Pos     ox, oy;   /* original, scaled position                   */
     FT_Short   fx, fy;   /* original, unscaled position (in font units) */
-    FT_Pos     x, y;     /* current position                            */
     FT_Pos     u, v;     /* current (x,y) or (y,x) depending on context */
 
     AF_Point   next;     /* next point in contour     */
@@ -338,6 +342,11 @@ FT_BEGIN_HEADER
     FT_Int           num_points;    /* number of used points      */
     AF_Point         points;        /* points array               */
 
+    FT_Pos*          x;             /* current point positions,  */
+    FT_Pos*          y;             /* indexed like `points'     */
+    FT_Pos*          ox;            /* original, scaled point    */
+    FT_Pos*          oy;            /* positions                 */
+
     FT_Int           max_contours;  /* number of allocated contours */
     FT_Int           num_contours;  /* number of used contours      */
     AF_Point*        contours;      /* contours array               */
@@ -352,9 +361,76 @@ FT_BEGIN_HEADER
     FT_Pos           xmin_delta;    /* used for warping */
     FT_Pos           xmax_delta;
 
+    FT_UInt          glyph_index;   /* the glyph being hinted */
+
   } AF_GlyphHintsRec;
 
 
+  /*
+   *  The segments of a glyph and the topology of its outline (point
+   *  flags and directions) only depend on the outline in font units,
+   *  not on the scaling.  To avoid recomputing them each time a glyph
+   *  is hinted at a different size, they are cached in a small,
+   *  direct-mapped table attached to the style metrics, indexed by the
+   *  glyph index.  An entry is only used if the outline hasn't changed
+   *  (for example, due to a different MM instance).
+   *
+   *  Edges are not cached since their construction depends on the
+   *  scaling.
+   */
+
+#define AF_GLYPH_ANALYSIS_CACHE_SIZE  128
+
+#define AF_DIMENSION_MASK( dim )  ( 1U << (dim) )
+
+  typedef struct  AF_CachedPointRec_
+  {
+    FT_Short   fx, fy;   /* original position, to validate the entry */
+    FT_UShort  flags;
+    FT_Char    in_dir;
+    FT_Char    out_dir;
+
+  } AF_CachedPointRec, *AF_CachedPoint;
+
+
+  typedef struct  AF_CachedSegmentRec_
+  {
+    FT_Byte   flags;
+    FT_Char   dir;
+    FT_Short  pos;
+    FT_Short  min_coord;
+    FT_Short  max_coord;
+    FT_Short  height;
+
+    FT_Short  first;       /* point indices             */
+    FT_Short  last;
+    FT_Short  link;        /* segment indices, or -1    */
+    FT_Short  serif;
+
+    FT_Pos    num_linked;
+    FT_Pos    score;
+    FT_Pos    len;
+
+  } AF_CachedSegmentRec, *AF_CachedSegment;
+
+
+  typedef struct  AF_GlyphAnalysisRec_
+  {
+    FT_UInt           glyph_index;
+    FT_UInt           dims;          /* mask of cached dimensions */
+
+    FT_Int            num_points;    /* 0 if the entry is unused */
+    AF_CachedPoint    points;
+    FT_Int            num_contours;
+    FT_Short*         contours;      /* last point of each contour */
+
+    FT_Char           major_dir[AF_DIMENSION_MAX];
+    FT_Int            num_segments[AF_DIMENSION_MAX];
+    AF_CachedSegment  segments[AF_DIMENSION_MAX];
+
+  } AF_GlyphAnalysisRec;
+
+
 #define AF_HINTS_TEST_SCALER( h, f )  ( (h)->scaler_flags & (f) )
 #define AF_HINTS_TEST_OTHER( h, f )   ( (h)->other_flags  & (f) )
 
@@ -419,6 +495,20 @@ FT_BEGIN_HEADER
   af_glyph_hints_reload( AF_GlyphHints  hints,
                          FT_Outline*    outline );
 
+  FT_LOCAL( FT_Error )
+  af_glyph_hints_reload_cached( AF_GlyphHints  hints,
+                                FT_Outline*    outline,
+                                FT_UInt       *acached );
+
+  FT_LOCAL( void )
+  af_glyph_hints_cache_analysis( AF_GlyphHints  hints,
+                                 FT_UInt        cached,
+                                 FT_UInt        dims );
+
+  FT_LOCAL( void )
+  af_glyph_analyses_free( AF_StyleMetrics  metrics,
+                          FT_Memory        memory );
+
   FT_LOCAL( void )
   af_glyph_hints_save( AF_GlyphHints  hints,
                        FT_Outline*    outline );
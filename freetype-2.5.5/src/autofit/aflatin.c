@@ -1800,29 +1800,6 @@
   }
 
 
-  /* Detect segments and edges for given dimension. */
-
-  FT_LOCAL_DEF( FT_Error )
-  af_latin_hints_detect_features( AF_GlyphHints  hints,
-                                  FT_UInt        width_count,
-                                  AF_WidthRec*   widths,
-                                  AF_Dimension   dim )
-  {
-    FT_Error  error;
-
-
-    error = af_latin_hints_compute_segments( hints, dim );
-    if ( !error )
-    {
-      af_latin_hints_link_segments( hints, width_count, widths, dim );
-
-      error = af_latin_hints_compute_edges( hints, dim );
-    }
-
-    return error;
-  }
-
-
   /* Compute all edges which lie within blue zones. */
 
   FT_LOCAL_DEF( void )
@@ -2807,12 +2784,10 @@
     int       dim;
 
     AF_LatinAxis  axis;
+    FT_UInt       dims = 0;
+    FT_UInt       cached;
 
 
-    error = af_glyph_hints_reload( hints, outline );
-    if ( error )
-      goto Exit;
-
     /* analyze glyph outline */
 #ifdef AF_CONFIG_OPTION_USE_WARPER
     if ( metrics->root.scaler.render_mode == FT_RENDER_MODE_LIGHT ||
@@ -2820,28 +2795,47 @@
 #else
     if ( AF_HINTS_DO_HORIZONTAL( hints ) )
 #endif
+      dims |= AF_DIMENSION_MASK( AF_DIMENSION_HORZ );
+
+    if ( AF_HINTS_DO_VERTICAL( hints ) )
+      dims |= AF_DIMENSION_MASK( AF_DIMENSION_VERT );
+
+    /* segments and their links don't depend on the scaling; */
+    /* reuse them if the glyph has been analyzed before       */
+    error = af_glyph_hints_reload_cached( hints, outline, &cached );
+    if ( error )
+      goto Exit;
+
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
     {
-      axis  = &metrics->axis[AF_DIMENSION_HORZ];
-      error = af_latin_hints_detect_features( hints,
-                                              axis->width_count,
-                                              axis->widths,
-                                              AF_DIMENSION_HORZ );
+      if ( !( dims & ~cached & AF_DIMENSION_MASK( dim ) ) )
+        continue;
+
+      axis  = &metrics->axis[dim];
+      error = af_latin_hints_compute_segments( hints, (AF_Dimension)dim );
       if ( error )
         goto Exit;
+
+      af_latin_hints_link_segments( hints,
+                                    axis->width_count,
+                                    axis->widths,
+                                    (AF_Dimension)dim );
     }
 
-    if ( AF_HINTS_DO_VERTICAL( hints ) )
+    af_glyph_hints_cache_analysis( hints, cached, dims );
+
+    for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
     {
-      axis  = &metrics->axis[AF_DIMENSION_VERT];
-      error = af_latin_hints_detect_features( hints,
-                                              axis->width_count,
-                                              axis->widths,
-                                              AF_DIMENSION_VERT );
+      if ( !( dims & AF_DIMENSION_MASK( dim ) ) )
+        continue;
+
+      error = af_latin_hints_compute_edges( hints, (AF_Dimension)dim );
       if ( error )
         goto Exit;
+    }
 
+    if ( dims & AF_DIMENSION_MASK( AF_DIMENSION_VERT ) )
       af_latin_hints_compute_blue_edges( hints, metrics );
-    }
 
     /* grid-fit the outline */
     for ( dim = 0; dim < AF_DIMENSION_MAX; dim++ )
@@ -180,12 +180,6 @@ FT_BEGIN_HEADER
   af_latin_hints_compute_edges( AF_GlyphHints  hints,
                                 AF_Dimension   dim );
 
-  FT_LOCAL( FT_Error )
-  af_latin_hints_detect_features( AF_GlyphHints  hints,
-                                  FT_UInt        width_count,
-                                  AF_WidthRec*   widths,
-                                  AF_Dimension   dim );
-
 /* */
 
 FT_END_HEADER
@@ -190,6 +190,8 @@
           AF_WRITING_SYSTEM_CLASSES_GET[style_class->writing_system];
 
 
+        hints->glyph_index = glyph_index;
+
         if ( writing_system_class->style_hints_apply )
           writing_system_class->style_hints_apply( hints,
                                                    &gloader->current.outline,
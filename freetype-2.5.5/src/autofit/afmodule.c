@@ -141,6 +141,37 @@
 
       return error;
     }
+    else if ( !ft_strcmp( property_name, "globals-data" ) )
+    {
+      FT_Prop_GlobalsData*  prop = (FT_Prop_GlobalsData*)value;
+      FT_Face               face = prop->face;
+      AF_FaceGlobals        globals;
+
+
+      if ( !face )
+        return FT_THROW( Invalid_Face_Handle );
+
+      error = af_face_globals_deserialize( face, &globals, module,
+                                           prop->data, prop->length );
+      if ( error )
+        return error;
+
+      if ( face->autohint.data )
+      {
+        AF_FaceGlobals  old_globals = (AF_FaceGlobals)face->autohint.data;
+
+
+        globals->increase_x_height = old_globals->increase_x_height;
+        af_face_globals_free( old_globals );
+      }
+
+      face->autohint.data =
+        (FT_Pointer)globals;
+      face->autohint.finalizer =
+        (FT_Generic_Finalizer)af_face_globals_free;
+
+      return error;
+    }
 
     FT_TRACE0(( "af_property_set: missing property `%s'\n",
                 property_name ));
@@ -167,7 +198,7 @@
 
       error = af_property_get_face_globals( prop->face, &globals, module );
       if ( !error )
-        prop->map = globals->glyph_styles;
+        prop->map = af_face_globals_get_glyph_styles( globals );
 
       return error;
     }
@@ -203,6 +234,20 @@
 
       return error;
     }
+    else if ( !ft_strcmp( property_name, "globals-data" ) )
+    {
+      FT_Prop_GlobalsData*  prop = (FT_Prop_GlobalsData*)value;
+      AF_FaceGlobals        globals;
+
+
+      error = af_property_get_face_globals( prop->face, &globals, module );
+      if ( !error )
+        error = af_face_globals_serialize( globals,
+                                           prop->data,
+                                           &prop->length );
+
+      return error;
+    }
 
 
     FT_TRACE0(( "af_property_get: missing property `%s'\n",
@@ -154,6 +154,11 @@ extern void*  _af_debug_hints;
    */
   typedef struct AF_GlyphHintsRec_*  AF_GlyphHints;
 
+  /*  opaque handle to the cached, size-independent analysis of a glyph
+   *  outline -- see `afhints.h' for more details
+   */
+  typedef struct AF_GlyphAnalysisRec_*  AF_GlyphAnalysis;
+
 
   /*************************************************************************/
   /*************************************************************************/
@@ -464,11 +469,14 @@ extern void*  _af_debug_hints;
 
   typedef struct  AF_StyleMetricsRec_
   {
-    AF_StyleClass   style_class;
-    AF_ScalerRec    scaler;
-    FT_Bool         digits_have_same_width;
+    AF_StyleClass     style_class;
+    AF_ScalerRec      scaler;
+    FT_Bool           digits_have_same_width;
+
+    AF_FaceGlobals    globals;    /* to access properties */
 
-    AF_FaceGlobals  globals;    /* to access properties */
+    AF_GlyphAnalysis  analyses;   /* see `afhints.h'; allocated */
+                                  /* on demand                  */
 
   } AF_StyleMetricsRec;
 
@@ -361,8 +361,9 @@
       if ( idx >= (hb_codepoint_t)globals->glyph_count )
         continue;
 
-      if ( gstyles[idx] == AF_STYLE_UNASSIGNED )
-        gstyles[idx] = (FT_Byte)style_class->style;
+      if ( ( gstyles[idx] & AF_STYLE_UNASSIGNED ) == AF_STYLE_UNASSIGNED )
+        gstyles[idx] = (FT_Byte)( ( gstyles[idx] & AF_DIGIT ) |
+                                  style_class->style          );
 #ifdef FT_DEBUG_LEVEL_TRACE
       else
         FT_TRACE4(( "*" ));
@@ -21,6 +21,7 @@
 
 #include FT_ADVANCES_H
 #include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_CALC_H
 
 
   static FT_Error
@@ -30,7 +31,6 @@
                            FT_Int32   flags )
   {
     FT_Fixed  scale;
-    FT_UInt   nn;
 
 
     if ( flags & FT_LOAD_NO_SCALE )
@@ -47,8 +47,7 @@
     /* this must be the same scaling as to get linear{Hori,Vert}Advance */
     /* (see `FT_Load_Glyph' implementation in src/base/ftobjs.c)        */
 
-    for ( nn = 0; nn < count; nn++ )
-      advances[nn] = FT_MulDiv( advances[nn], scale, 64 );
+    ft_muldiv_array( advances, count, scale, 64 );
 
     return FT_Err_Ok;
   }
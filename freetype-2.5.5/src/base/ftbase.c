@@ -29,6 +29,7 @@
 #include "ftobjs.c"
 #include "ftoutln.c"
 #include "ftrfork.c"
+#include "ftsimd.c"
 #include "ftsnames.c"
 #include "ftstream.c"
 #include "fttrigon.c"
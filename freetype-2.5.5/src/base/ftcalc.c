@@ -40,9 +40,9 @@
 #include FT_INTERNAL_OBJECTS_H
 
 
-#ifdef FT_MULFIX_ASSEMBLER
-#undef FT_MulFix
-#endif
+  /* FT_MulDiv, FT_MulFix, and FT_DivFix might be macros (see     */
+  /* ftcalc.h); the function names are parenthesized below to     */
+  /* define the exported functions nevertheless.                   */
 
 /* we need to emulate a 64-bit data type if a real one isn't available */
 
@@ -173,10 +173,16 @@
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Long )
-  FT_MulDiv( FT_Long  a,
-             FT_Long  b,
-             FT_Long  c )
+  ( FT_MulDiv )( FT_Long  a,
+                 FT_Long  b,
+                 FT_Long  c )
   {
+#ifdef FT_CALC_INLINE
+
+    return FT_MulDiv_64( a, b, c );
+
+#else
+
     FT_Int   s = 1;
     FT_Long  d;
 
@@ -189,6 +195,8 @@
                          : 0x7FFFFFFFL );
 
     return s < 0 ? -d : d;
+
+#endif /* FT_CALC_INLINE */
   }
 
 
@@ -217,13 +225,17 @@
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Long )
-  FT_MulFix( FT_Long  a,
-             FT_Long  b )
+  ( FT_MulFix )( FT_Long  a,
+                 FT_Long  b )
   {
 #ifdef FT_MULFIX_ASSEMBLER
 
     return FT_MULFIX_ASSEMBLER( a, b );
 
+#elif defined( FT_CALC_INLINE )
+
+    return FT_MulFix_64( a, b );
+
 #else
 
     FT_Int   s = 1;
@@ -244,9 +256,15 @@
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Long )
-  FT_DivFix( FT_Long  a,
-             FT_Long  b )
+  ( FT_DivFix )( FT_Long  a,
+                 FT_Long  b )
   {
+#ifdef FT_CALC_INLINE
+
+    return FT_DivFix_64( a, b );
+
+#else
+
     FT_Int   s = 1;
     FT_Long  q;
 
@@ -258,6 +276,8 @@
                          : 0x7FFFFFFFL );
 
     return s < 0 ? -q : q;
+
+#endif /* FT_CALC_INLINE */
   }
 
 
@@ -401,9 +421,9 @@
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Long )
-  FT_MulDiv( FT_Long  a,
-             FT_Long  b,
-             FT_Long  c )
+  ( FT_MulDiv )( FT_Long  a,
+                 FT_Long  b,
+                 FT_Long  c )
   {
     FT_Int  s = 1;
 
@@ -483,8 +503,8 @@
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Long )
-  FT_MulFix( FT_Long  a,
-             FT_Long  b )
+  ( FT_MulFix )( FT_Long  a,
+                 FT_Long  b )
   {
 #ifdef FT_MULFIX_ASSEMBLER
 
@@ -584,8 +604,8 @@
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Long )
-  FT_DivFix( FT_Long  a,
-             FT_Long  b )
+  ( FT_DivFix )( FT_Long  a,
+                 FT_Long  b )
   {
     FT_Int   s = 1;
     FT_Long  q;
@@ -628,6 +648,59 @@
 #endif /* FT_LONG64 */
 
 
+  /* documentation is in ftcalc.h */
+
+  FT_BASE_DEF( void )
+  ft_muldiv_array( FT_Long*  values,
+                   FT_UInt   count,
+                   FT_Long   b,
+                   FT_Long   c )
+  {
+    FT_Long*  limit = values + count;
+
+#ifdef FT_LONG64
+
+    FT_Int   s = 1;
+    FT_Long  ub, uc;
+
+
+    ub = b;
+    uc = c;
+    FT_MOVE_SIGN( ub, s );
+    FT_MOVE_SIGN( uc, s );
+
+    /* With a power of two as the divisor, the division of the  */
+    /* (non-negative) rounded product can be done with a shift. */
+    if ( uc > 0 && uc <= 0x40000000L && !( uc & ( uc - 1 ) ) )
+    {
+      FT_Int64  half  = uc >> 1;
+      FT_Int    shift = FT_MSB( (FT_UInt32)uc );
+
+
+      for ( ; values < limit; values++ )
+      {
+        FT_Long  a  = *values;
+        FT_Int   sa = s;
+        FT_Long  d;
+
+
+        FT_MOVE_SIGN( a, sa );
+
+        d = (FT_Long)( ( (FT_Int64)a * ub + half ) >> shift );
+
+        *values = sa < 0 ? -d : d;
+      }
+
+      return;
+    }
+
+#endif /* FT_LONG64 */
+
+    for ( ; values < limit; values++ )
+      *values = FT_MulDiv( *values, b, c );
+  }
+
+
   /* documentation is in ftglyph.h */
 
   FT_EXPORT_DEF( void )
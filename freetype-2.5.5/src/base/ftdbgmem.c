@@ -20,9 +20,11 @@
 #include FT_CONFIG_CONFIG_H
 #include FT_INTERNAL_DEBUG_H
 #include FT_INTERNAL_MEMORY_H
+#include FT_INTERNAL_OBJECTS_H
 #include FT_SYSTEM_H
 #include FT_ERRORS_H
 #include FT_TYPES_H
+#include FT_MEMORY_PROFILER_H
 
 
 #ifdef FT_DEBUG_MEMORY
@@ -69,6 +71,12 @@
 
     FT_Long       cur_max;      /* current maximum allocated size */
 
+    FT_Long       snap_blocks;  /* `all_blocks' at the last snapshot */
+    FT_Long       snap_size;    /* `all_size' at the last snapshot   */
+
+    FT_Long       reallocs;     /* total number of reallocations */
+    FT_Long       growth[FT_MEM_PROFILE_GROWTH_BUCKETS];
+
     FT_UInt32     hash;
     FT_MemSource  link;
 
@@ -129,6 +137,7 @@
     FT_MemSource     sources[FT_MEM_SOURCE_BUCKETS];
 
     FT_Bool          keep_alive;
+    FT_Bool          profile_only;
 
     FT_Memory        memory;
     FT_Pointer       memory_user;
@@ -348,7 +357,9 @@
     FT_ULong  leaks      = 0;
 
 
-    FT_DumpMemory( table->memory );
+    /* the profiler stays silent; blocks are not tracked in this mode */
+    if ( !table->profile_only )
+      FT_DumpMemory( table->memory );
 
     /* remove all blocks from the table, revealing leaked ones */
     for ( i = 0; i < table->size; i++ )
@@ -405,6 +416,12 @@
       table->sources[i] = NULL;
     }
 
+    if ( table->profile_only )
+    {
+      ft_mem_table_free( table, table );
+      return;
+    }
+
     printf( "FreeType: total memory allocations = %ld\n",
             table->alloc_total );
     printf( "FreeType: maximum memory footprint = %ld\n",
@@ -491,6 +508,12 @@
 
     node->cur_max    = 0;
 
+    node->snap_blocks = 0;
+    node->snap_size   = 0;
+
+    node->reallocs = 0;
+    FT_ARRAY_ZERO( node->growth, FT_MEM_PROFILE_GROWTH_BUCKETS );
+
     node->link = NULL;
     node->hash = hash;
     *pnode     = node;
@@ -500,6 +523,28 @@
   }
 
 
+  static void
+  ft_mem_source_add_realloc( FT_MemSource  source,
+                             FT_Long       delta )
+  {
+    FT_UInt  bucket = 0;
+
+
+    /* bucket 0 holds shrinking reallocations, bucket n > 0 growths */
+    /* in the range [8^(n-1);8^n[                                   */
+    if ( delta > 0 )
+    {
+      for ( bucket = 1;
+            bucket < FT_MEM_PROFILE_GROWTH_BUCKETS - 1 && delta >= 8;
+            bucket++ )
+        delta >>= 3;
+    }
+
+    source->reallocs++;
+    source->growth[bucket]++;
+  }
+
+
   static void
   ft_mem_table_set( FT_MemTable  table,
                     FT_Byte*     address,
@@ -566,6 +611,8 @@
         /* we are growing or shrinking a reallocated block */
         source->cur_size     += delta;
         table->alloc_current += delta;
+
+        ft_mem_source_add_realloc( source, delta );
       }
       else
       {
@@ -815,6 +862,150 @@
   }
 
 
+  /*
+   *  In profiling mode (see `ft_mem_debug_init'), blocks are not tracked
+   *  with nodes; instead, each block is preceded by a small header that
+   *  holds its size and allocation source.  No consistency checks are
+   *  performed, making this mode cheap enough for production builds.
+   */
+  typedef struct  FT_MemHeaderRec_
+  {
+    FT_MemSource  source;
+    FT_Long       size;
+
+  } FT_MemHeaderRec, *FT_MemHeader;
+
+
+#define FT_MEM_HEADER_SIZE  FT_PAD_CEIL( sizeof ( FT_MemHeaderRec ), 16 )
+
+
+  static void
+  ft_mem_prof_account( FT_MemTable   table,
+                       FT_MemSource  source,
+                       FT_Long       delta )
+  {
+    source->cur_size     += delta;
+    table->alloc_current += (FT_ULong)delta;
+
+    if ( delta > 0 )
+    {
+      source->all_size   += delta;
+      table->alloc_total += (FT_ULong)delta;
+    }
+
+    if ( source->cur_size > source->max_size )
+      source->max_size = source->cur_size;
+
+    if ( table->alloc_current > table->alloc_max )
+      table->alloc_max = table->alloc_current;
+  }
+
+
+  extern FT_Pointer
+  ft_mem_prof_alloc( FT_Memory  memory,
+                     FT_Long    size )
+  {
+    FT_MemTable   table = (FT_MemTable)memory->user;
+    FT_MemHeader  header;
+
+
+    header = (FT_MemHeader)ft_mem_table_alloc(
+                             table,
+                             (FT_Long)FT_MEM_HEADER_SIZE + size );
+    if ( header )
+    {
+      FT_MemSource  source = ft_mem_table_get_source( table );
+
+
+      source->all_blocks++;
+      source->cur_blocks++;
+      if ( source->cur_blocks > source->max_blocks )
+        source->max_blocks = source->cur_blocks;
+
+      if ( size > source->cur_max )
+        source->cur_max = size;
+
+      ft_mem_prof_account( table, source, size );
+      table->alloc_count++;
+
+      header->source = source;
+      header->size   = size;
+    }
+
+    _ft_debug_file   = "<unknown>";
+    _ft_debug_lineno = 0;
+
+    return header ? (FT_Byte*)header + FT_MEM_HEADER_SIZE : NULL;
+  }
+
+
+  extern void
+  ft_mem_prof_free( FT_Memory   memory,
+                    FT_Pointer  block )
+  {
+    FT_MemTable   table  = (FT_MemTable)memory->user;
+    FT_MemHeader  header = (FT_MemHeader)( (FT_Byte*)block -
+                                           FT_MEM_HEADER_SIZE );
+    FT_MemSource  source = header->source;
+
+
+    source->cur_blocks--;
+    ft_mem_prof_account( table, source, -header->size );
+    table->alloc_count--;
+
+    ft_mem_table_free( table, header );
+
+    _ft_debug_file   = "<unknown>";
+    _ft_debug_lineno = 0;
+  }
+
+
+  extern FT_Pointer
+  ft_mem_prof_realloc( FT_Memory   memory,
+                       FT_Long     cur_size,
+                       FT_Long     new_size,
+                       FT_Pointer  block )
+  {
+    FT_MemTable   table = (FT_MemTable)memory->user;
+    FT_MemHeader  header;
+    FT_MemSource  source;
+    FT_Long       delta = new_size - cur_size;
+
+
+    if ( block == NULL )
+      return ft_mem_prof_alloc( memory, new_size );
+
+    header = (FT_MemHeader)( (FT_Byte*)block - FT_MEM_HEADER_SIZE );
+    source = header->source;
+
+    memory->user = table->memory_user;
+    header = (FT_MemHeader)table->realloc(
+                             memory,
+                             (FT_Long)FT_MEM_HEADER_SIZE + cur_size,
+                             (FT_Long)FT_MEM_HEADER_SIZE + new_size,
+                             header );
+    memory->user = table;
+
+    if ( header )
+    {
+      header->size = new_size;
+
+      if ( new_size > source->cur_max )
+        source->cur_max = new_size;
+
+      /* the block stays with its allocation source, */
+      /* while growth is recorded for the caller     */
+      ft_mem_prof_account( table, source, delta );
+      ft_mem_source_add_realloc( ft_mem_table_get_source( table ), delta );
+    }
+
+    _ft_debug_file   = "<unknown>";
+    _ft_debug_lineno = 0;
+
+    return header ? (FT_Byte*)header + FT_MEM_HEADER_SIZE : NULL;
+  }
+
+
   extern FT_Int
   ft_mem_debug_init( FT_Memory  memory )
   {
@@ -874,6 +1065,21 @@
         result = 1;
       }
     }
+    else if ( getenv( "FT2_DEBUG_MEMORY_PROFILE" ) )
+    {
+      table = ft_mem_table_new( memory );
+      if ( table )
+      {
+        memory->user    = table;
+        memory->alloc   = ft_mem_prof_alloc;
+        memory->realloc = ft_mem_prof_realloc;
+        memory->free    = ft_mem_prof_free;
+
+        table->profile_only = 1;
+
+        result = 1;
+      }
+    }
     return result;
   }
 
@@ -981,12 +1187,247 @@
     }
   }
 
+  static int
+  ft_mem_source_compare_all( const void*  p1,
+                             const void*  p2 )
+  {
+    FT_MemProfileSite  s1 = (FT_MemProfileSite)p1;
+    FT_MemProfileSite  s2 = (FT_MemProfileSite)p2;
+
+
+    if ( s2->all_size > s1->all_size )
+      return 1;
+    else if ( s2->all_size < s1->all_size )
+      return -1;
+    else
+      return 0;
+  }
+
+
+  /* documentation is in ftmemprf.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_MemProfile_Snapshot( FT_Library      library,
+                          FT_MemProfile  *aprofile )
+  {
+    FT_Memory          memory;
+    FT_MemTable        table;
+    FT_MemSource*      bucket;
+    FT_MemSource*      limit;
+    FT_MemProfile      profile;
+    FT_MemProfileSite  site;
+    FT_UInt            count;
+
+
+    if ( !library )
+      return FT_THROW( Invalid_Library_Handle );
+
+    if ( !aprofile )
+      return FT_THROW( Invalid_Argument );
+
+    *aprofile = NULL;
+
+    memory = library->memory;
+    if ( memory->alloc != ft_mem_debug_alloc &&
+         memory->alloc != ft_mem_prof_alloc  )
+      return FT_THROW( Unimplemented_Feature );
+
+    table  = (FT_MemTable)memory->user;
+    bucket = table->sources;
+    limit  = bucket + FT_MEM_SOURCE_BUCKETS;
+
+    count = 0;
+    for ( ; bucket < limit; bucket++ )
+    {
+      FT_MemSource  source = *bucket;
+
+
+      for ( ; source; source = source->link )
+        count++;
+    }
+
+    /* the snapshot is allocated behind the table's back */
+    profile = (FT_MemProfile)ft_mem_table_alloc(
+                               table,
+                               (FT_Long)( sizeof ( *profile ) +
+                                          count * sizeof ( *site ) ) );
+    if ( !profile )
+      return FT_THROW( Out_Of_Memory );
+
+    profile->alloc_current = table->alloc_current;
+    profile->alloc_max     = table->alloc_max;
+    profile->alloc_total   = table->alloc_total;
+    profile->alloc_count   = table->alloc_count;
+    profile->num_sites     = count;
+    profile->sites         = (FT_MemProfileSite)( profile + 1 );
+
+    site = profile->sites;
+    for ( bucket = table->sources; bucket < limit; bucket++ )
+    {
+      FT_MemSource  source = *bucket;
+
+
+      for ( ; source; source = source->link, site++ )
+      {
+        site->file_name  = FT_FILENAME( source->file_name );
+        site->line_no    = source->line_no;
+
+        site->cur_blocks = source->cur_blocks;
+        site->max_blocks = source->max_blocks;
+        site->all_blocks = source->all_blocks;
+        site->new_blocks = source->all_blocks - source->snap_blocks;
+
+        site->cur_size   = source->cur_size;
+        site->max_size   = source->max_size;
+        site->all_size   = source->all_size;
+        site->new_size   = source->all_size - source->snap_size;
+
+        site->reallocs   = source->reallocs;
+        FT_ARRAY_COPY( site->growth, source->growth,
+                       FT_MEM_PROFILE_GROWTH_BUCKETS );
+
+        source->snap_blocks = source->all_blocks;
+        source->snap_size   = source->all_size;
+      }
+    }
+
+    ft_qsort( profile->sites, count, sizeof ( *site ),
+              ft_mem_source_compare_all );
+
+    *aprofile = profile;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftmemprf.h */
+
+  FT_EXPORT_DEF( void )
+  FT_MemProfile_Done( FT_Library     library,
+                      FT_MemProfile  profile )
+  {
+    FT_Memory  memory;
+
+
+    if ( !library || !profile )
+      return;
+
+    memory = library->memory;
+    if ( memory->alloc == ft_mem_debug_alloc ||
+         memory->alloc == ft_mem_prof_alloc  )
+      ft_mem_table_free( (FT_MemTable)memory->user, profile );
+  }
+
 #else  /* !FT_DEBUG_MEMORY */
 
-  /* ANSI C doesn't like empty source files */
-  typedef int  _debug_mem_dummy;
+  /* documentation is in ftmemprf.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_MemProfile_Snapshot( FT_Library      library,
+                          FT_MemProfile  *aprofile )
+  {
+    FT_UNUSED( library );
+
+    if ( aprofile )
+      *aprofile = NULL;
+
+    return FT_THROW( Unimplemented_Feature );
+  }
+
+
+  /* documentation is in ftmemprf.h */
+
+  FT_EXPORT_DEF( void )
+  FT_MemProfile_Done( FT_Library     library,
+                      FT_MemProfile  profile )
+  {
+    FT_UNUSED( library );
+    FT_UNUSED( profile );
+  }
 
 #endif /* !FT_DEBUG_MEMORY */
 
 
+  /* documentation is in ftmemprf.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_MemProfile_Fold( FT_MemProfile           profile,
+                      FT_MemProfile_Metric    metric,
+                      FT_MemProfile_LineFunc  func,
+                      void*                   user )
+  {
+    FT_UInt  nn;
+    char     line[256];
+
+
+    if ( !profile || !func )
+      return FT_THROW( Invalid_Argument );
+
+    for ( nn = 0; nn < profile->num_sites; nn++ )
+    {
+      FT_MemProfileSite  site = profile->sites + nn;
+      FT_Long            value;
+      const char*        file;
+      const char*        base;
+      const char*        module;
+      const char*        p;
+
+
+      switch ( metric )
+      {
+      case FT_MEM_PROFILE_METRIC_ALL_SIZE:
+        value = site->all_size;
+        break;
+      case FT_MEM_PROFILE_METRIC_ALL_BLOCKS:
+        value = site->all_blocks;
+        break;
+      case FT_MEM_PROFILE_METRIC_NEW_SIZE:
+        value = site->new_size;
+        break;
+      case FT_MEM_PROFILE_METRIC_NEW_BLOCKS:
+        value = site->new_blocks;
+        break;
+      case FT_MEM_PROFILE_METRIC_CUR_SIZE:
+        value = site->cur_size;
+        break;
+      case FT_MEM_PROFILE_METRIC_REALLOCS:
+        value = site->reallocs;
+        break;
+      default:
+        return FT_THROW( Invalid_Argument );
+      }
+
+      if ( value <= 0 )
+        continue;
+
+      /* split `.../<module>/<file>' into frames */
+      file   = site->file_name ? site->file_name : "unknown";
+      base   = file;
+      module = NULL;
+
+      for ( p = file; *p; p++ )
+      {
+        if ( *p == '/' || *p == '\\' )
+        {
+          module = base;
+          base   = p + 1;
+        }
+      }
+
+      if ( module && module < base - 1 )
+        ft_sprintf( line, "freetype;%.*s;%.96s:%ld %ld\n",
+                    (int)( base - 1 - module < 96 ? base - 1 - module
+                                                  : 96 ),
+                    module, base, site->line_no, value );
+      else
+        ft_sprintf( line, "freetype;%.96s:%ld %ld\n",
+                    base, site->line_no, value );
+
+      func( line, user );
+    }
+
+    return FT_Err_Ok;
+  }
+
+
 /* END */
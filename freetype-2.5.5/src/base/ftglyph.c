@@ -35,6 +35,7 @@
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_SIMD_H
 
 #include "basepic.h"
 
@@ -222,11 +223,8 @@
     FT_OutlineGlyph  glyph = (FT_OutlineGlyph)outline_glyph;
 
 
-    if ( matrix )
-      FT_Outline_Transform( &glyph->outline, matrix );
-
-    if ( delta )
-      FT_Outline_Translate( &glyph->outline, delta->x, delta->y );
+    ft_vector_array_transform( glyph->outline.points, glyph->outline.n_points,
+                               matrix, delta );
   }
 
 
@@ -22,98 +22,890 @@
 #include FT_LCD_FILTER_H
 #include FT_IMAGE_H
 #include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_SIMD_H
 
 
 #ifdef FT_CONFIG_OPTION_SUBPIXEL_RENDERING
 
+#ifdef FT_SIMD_X86_64
+#include <immintrin.h>
+#endif
+
+#ifdef FT_SIMD_ARM64
+#include <arm_neon.h>
+#endif
+
 /* define USE_LEGACY to implement the legacy filter */
 #define  USE_LEGACY
 
-  /* FIR filter used by the default and light filters */
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The FIR filter computes the output pixel at position `x' as           */
+  /*                                                                       */
+  /*   w[0] * p[x + 2] + w[1] * p[x + 1] + w[2] * p[x] +                   */
+  /*   w[3] * p[x - 1] + w[4] * p[x - 2]                                   */
+  /*                                                                       */
+  /* shifted right by 8 bits and clamped to 255, where pixels outside of   */
+  /* the row (or column) are zero.  The vector code uses 16-bit lanes and  */
+  /* unsigned saturating additions: every product fits into 16 bits, and   */
+  /* a saturated sum yields 255, as does the exact one.  Sums of 2^17 or   */
+  /* more, however, aren't clamped to 255 by the scalar code; the vector   */
+  /* code is thus only used if the weights add up to less than 512, as     */
+  /* they do for all predefined filters.                                   */
+  /*                                                                       */
+  /* The legacy filter maps each triplet of pixels to a new triplet.  The  */
+  /* vector code treats it as a 5-tap filter whose weights depend on the   */
+  /* position within the triplet, computing exact 32-bit sums.             */
+  /*                                                                       */
+  /* Both filters work in place.  The vector code keeps the original       */
+  /* neighbours of the current block of 16 pixels in registers; within a   */
+  /* row it reads the next block before storing the current one.           */
+  /*                                                                       */
+  /*************************************************************************/
+
+
+  /* contribution of the n-th pixel of a triplet to its m-th output pixel */
+#define FT_LCD_LEGACY_00  ( 65538 * 9 / 13 )
+#define FT_LCD_LEGACY_01  ( 65538 * 1 / 6 )
+#define FT_LCD_LEGACY_02  ( 65538 * 1 / 13 )
+#define FT_LCD_LEGACY_10  ( 65538 * 3 / 13 )
+#define FT_LCD_LEGACY_11  ( 65538 * 4 / 6 )
+#define FT_LCD_LEGACY_12  ( 65538 * 3 / 13 )
+#define FT_LCD_LEGACY_20  ( 65538 * 1 / 13 )
+#define FT_LCD_LEGACY_21  ( 65538 * 1 / 6 )
+#define FT_LCD_LEGACY_22  ( 65538 * 9 / 13 )
+
+
+  /* FIR filter a row of at least 4 pixels in place */
   static void
-  _ft_lcd_filter_fir( FT_Bitmap*      bitmap,
-                      FT_Render_Mode  mode,
-                      FT_Library      library )
+  ft_lcd_fir_line( FT_Byte*        line,
+                   FT_UInt         width,
+                   const FT_Byte*  weights )
   {
-    FT_Byte*  weights = library->lcd_weights;
-    FT_UInt   width   = (FT_UInt)bitmap->width;
-    FT_UInt   height  = (FT_UInt)bitmap->rows;
+    FT_UInt  fir[4];        /* below, `pix' is used as the 5th element */
+    FT_UInt  val1, xx;
 
 
-    /* horizontal in-place FIR filter */
-    if ( mode == FT_RENDER_MODE_LCD && width >= 4 )
+    /* `fir' and `pix' must be at least 32 bit wide, since the sum of */
+    /* the values in `weights' can exceed 0xFF                        */
+
+    val1   = line[0];
+    fir[0] = weights[2] * val1;
+    fir[1] = weights[3] * val1;
+    fir[2] = weights[4] * val1;
+    fir[3] = 0;
+
+    val1    = line[1];
+    fir[0] += weights[1] * val1;
+    fir[1] += weights[2] * val1;
+    fir[2] += weights[3] * val1;
+    fir[3] += weights[4] * val1;
+
+    for ( xx = 2; xx < width; xx++ )
     {
-      FT_Byte*  line = bitmap->buffer;
+      FT_UInt  val, pix;
 
 
-      /* take care of bitmap flow */
-      if ( bitmap->pitch < 0 )
-        line -= bitmap->pitch * ( bitmap->rows - 1 );
+      val    = line[xx];
+      pix    = fir[0] + weights[0] * val;
+      fir[0] = fir[1] + weights[1] * val;
+      fir[1] = fir[2] + weights[2] * val;
+      fir[2] = fir[3] + weights[3] * val;
+      fir[3] =          weights[4] * val;
 
-      /* `fir' and `pix' must be at least 32 bit wide, since the sum of */
-      /* the values in `weights' can exceed 0xFF                        */
+      pix        >>= 8;
+      pix         |= (FT_UInt)-(FT_Int)( pix >> 8 );
+      line[xx - 2] = (FT_Byte)pix;
+    }
 
-      for ( ; height > 0; height--, line += bitmap->pitch )
-      {
-        FT_UInt  fir[4];        /* below, `pix' is used as the 5th element */
-        FT_UInt  val1, xx;
+    {
+      FT_UInt  pix;
 
 
-        val1   = line[0];
-        fir[0] = weights[2] * val1;
-        fir[1] = weights[3] * val1;
-        fir[2] = weights[4] * val1;
-        fir[3] = 0;
+      pix          = fir[0] >> 8;
+      pix         |= (FT_UInt)-(FT_Int)( pix >> 8 );
+      line[xx - 2] = (FT_Byte)pix;
 
-        val1    = line[1];
-        fir[0] += weights[1] * val1;
-        fir[1] += weights[2] * val1;
-        fir[2] += weights[3] * val1;
-        fir[3] += weights[4] * val1;
+      pix          = fir[1] >> 8;
+      pix         |= (FT_UInt)-(FT_Int)( pix >> 8 );
+      line[xx - 1] = (FT_Byte)pix;
+    }
+  }
 
-        for ( xx = 2; xx < width; xx++ )
-        {
-          FT_UInt  val, pix;
 
+#ifdef USE_LEGACY
 
-          val    = line[xx];
-          pix    = fir[0] + weights[0] * val;
-          fir[0] = fir[1] + weights[1] * val;
-          fir[1] = fir[2] + weights[2] * val;
-          fir[2] = fir[3] + weights[3] * val;
-          fir[3] =          weights[4] * val;
+  static const FT_UInt  ft_lcd_legacy_filters[3][3] =
+  {
+    { FT_LCD_LEGACY_00, FT_LCD_LEGACY_01, FT_LCD_LEGACY_02 },
+    { FT_LCD_LEGACY_10, FT_LCD_LEGACY_11, FT_LCD_LEGACY_12 },
+    { FT_LCD_LEGACY_20, FT_LCD_LEGACY_21, FT_LCD_LEGACY_22 }
+  };
 
-          pix        >>= 8;
-          pix         |= (FT_UInt)-(FT_Int)( pix >> 8 );
-          line[xx - 2] = (FT_Byte)pix;
-        }
 
+  /* legacy filter a row of triplets in place */
+  static void
+  ft_lcd_legacy_line( FT_Byte*  line,
+                      FT_UInt   width )
+  {
+    FT_UInt  xx;
+
+
+    for ( xx = 0; xx < width; xx += 3 )
+    {
+      FT_UInt  r = 0;
+      FT_UInt  g = 0;
+      FT_UInt  b = 0;
+      FT_UInt  p;
+
+
+      p  = line[xx];
+      r += ft_lcd_legacy_filters[0][0] * p;
+      g += ft_lcd_legacy_filters[0][1] * p;
+      b += ft_lcd_legacy_filters[0][2] * p;
+
+      p  = line[xx + 1];
+      r += ft_lcd_legacy_filters[1][0] * p;
+      g += ft_lcd_legacy_filters[1][1] * p;
+      b += ft_lcd_legacy_filters[1][2] * p;
+
+      p  = line[xx + 2];
+      r += ft_lcd_legacy_filters[2][0] * p;
+      g += ft_lcd_legacy_filters[2][1] * p;
+      b += ft_lcd_legacy_filters[2][2] * p;
+
+      line[xx]     = (FT_Byte)( r / 65536 );
+      line[xx + 1] = (FT_Byte)( g / 65536 );
+      line[xx + 2] = (FT_Byte)( b / 65536 );
+    }
+  }
+
+#endif /* USE_LEGACY */
+
+
+#if defined( FT_SIMD_X86_64 ) || defined( FT_SIMD_ARM64 )
+
+#define FT_LCD_VECTORS
+
+#define FT_LCD_VECTOR_WEIGHTS( w )                                  \
+          ( (w)[0] + (w)[1] + (w)[2] + (w)[3] + (w)[4] < 512 )
+
+
+  /* a triplet repeated to cover three blocks of 16 pixels */
+#define FT_LCD_REPEAT( a, b, c )                                 \
+          a, b, c, a, b, c, a, b, c, a, b, c, a, b, c, a, b, c,  \
+          a, b, c, a, b, c, a, b, c, a, b, c, a, b, c, a, b, c,  \
+          a, b, c, a, b, c, a, b, c, a, b, c
+
+  /* The legacy filter weights for the pixels at offsets +2, +1, 0, -1, */
+  /* and -2, per output pixel.  The n-th block of 16 pixels in a row    */
+  /* uses the 16 entries starting at index `16 * ( n % 3 )'.            */
+  static const FT_UShort  ft_lcd_legacy_taps[5][48] =
+  {
+    { FT_LCD_REPEAT( FT_LCD_LEGACY_20, 0, 0 ) },
+    { FT_LCD_REPEAT( FT_LCD_LEGACY_10, FT_LCD_LEGACY_21, 0 ) },
+    { FT_LCD_REPEAT( FT_LCD_LEGACY_00, FT_LCD_LEGACY_11,
+                     FT_LCD_LEGACY_22 ) },
+    { FT_LCD_REPEAT( 0, FT_LCD_LEGACY_01, FT_LCD_LEGACY_12 ) },
+    { FT_LCD_REPEAT( 0, 0, FT_LCD_LEGACY_02 ) }
+  };
+
+
+  /* Set up the legacy filter weights for columns: `taps[m][k][i]' is */
+  /* the weight of the pixel at offset 2 - k for the m-th output of a */
+  /* triplet, repeated for all 16 lanes `i'.                          */
+  static void
+  ft_lcd_legacy_column_taps( FT_UShort  taps[3][5][16] )
+  {
+    int  m, k, i;
+
+
+    for ( m = 0; m < 3; m++ )
+      for ( k = 0; k < 5; k++ )
+        for ( i = 0; i < 16; i++ )
+          taps[m][k][i] = ft_lcd_legacy_taps[k][m];
+  }
+
+
+  /* copy the last `count' < 16 pixels of a row to a zero-padded block */
+  static void
+  ft_lcd_load_partial( FT_Byte*        block,
+                       const FT_Byte*  p,
+                       FT_UInt         count )
+  {
+    FT_MEM_ZERO( block, 16 );
+    FT_MEM_COPY( block, p, count );
+  }
+
+#endif /* FT_SIMD_X86_64 || FT_SIMD_ARM64 */
+
+
+#ifdef FT_SIMD_X86_64
+
+  /* Compute 16 FIR filtered pixels; `in[k]' holds the original pixels */
+  /* at offset 2 - k, and `w[k]' the corresponding weight in all lanes. */
+
+  static __m128i
+  ft_lcd_fir_sse2( const __m128i*  in,
+                   const __m128i*  w )
+  {
+    __m128i  zero = _mm_setzero_si128();
+    __m128i  lo   = zero;
+    __m128i  hi   = zero;
+    int      k;
+
+
+    for ( k = 0; k < 5; k++ )
+    {
+      lo = _mm_adds_epu16( lo,
+                           _mm_mullo_epi16( _mm_unpacklo_epi8( in[k], zero ),
+                                            w[k] ) );
+      hi = _mm_adds_epu16( hi,
+                           _mm_mullo_epi16( _mm_unpackhi_epi8( in[k], zero ),
+                                            w[k] ) );
+    }
+
+    return _mm_packus_epi16( _mm_srli_epi16( lo, 8 ),
+                             _mm_srli_epi16( hi, 8 ) );
+  }
+
+
+  /* Compute 16 legacy filtered pixels; the weights for `in[k]' are */
+  /* `taps[k * stride]' to `taps[k * stride + 15]'.                 */
+
+  static __m128i
+  ft_lcd_legacy_sse2( const __m128i*    in,
+                      const FT_UShort*  taps,
+                      FT_UInt           stride )
+  {
+    __m128i  zero = _mm_setzero_si128();
+    __m128i  s0   = zero;
+    __m128i  s1   = zero;
+    __m128i  s2   = zero;
+    __m128i  s3   = zero;
+    int      k;
+
+
+    for ( k = 0; k < 5; k++, taps += stride )
+    {
+      __m128i  p, w, l, h;
+
+
+      /* 32-bit products from their low and high 16 bits */
+      p  = _mm_unpacklo_epi8( in[k], zero );
+      w  = _mm_loadu_si128( (const __m128i*)taps );
+      l  = _mm_mullo_epi16( p, w );
+      h  = _mm_mulhi_epu16( p, w );
+      s0 = _mm_add_epi32( s0, _mm_unpacklo_epi16( l, h ) );
+      s1 = _mm_add_epi32( s1, _mm_unpackhi_epi16( l, h ) );
+
+      p  = _mm_unpackhi_epi8( in[k], zero );
+      w  = _mm_loadu_si128( (const __m128i*)( taps + 8 ) );
+      l  = _mm_mullo_epi16( p, w );
+      h  = _mm_mulhi_epu16( p, w );
+      s2 = _mm_add_epi32( s2, _mm_unpacklo_epi16( l, h ) );
+      s3 = _mm_add_epi32( s3, _mm_unpackhi_epi16( l, h ) );
+    }
+
+    /* the results don't exceed 255 */
+    return _mm_packus_epi16( _mm_packs_epi32( _mm_srli_epi32( s0, 16 ),
+                                              _mm_srli_epi32( s1, 16 ) ),
+                             _mm_packs_epi32( _mm_srli_epi32( s2, 16 ),
+                                              _mm_srli_epi32( s3, 16 ) ) );
+  }
+
+
+  static FT_SIMD_TARGET( "avx2" ) __m128i
+  ft_lcd_fir_avx2( const __m128i*  in,
+                   const __m256i*  w )
+  {
+    __m256i  s = _mm256_setzero_si256();
+    int      k;
+
+
+    for ( k = 0; k < 5; k++ )
+      s = _mm256_adds_epu16( s,
+                             _mm256_mullo_epi16( _mm256_cvtepu8_epi16( in[k] ),
+                                                 w[k] ) );
+
+    s = _mm256_srli_epi16( s, 8 );
+
+    return _mm_packus_epi16( _mm256_castsi256_si128( s ),
+                             _mm256_extracti128_si256( s, 1 ) );
+  }
+
+
+  static FT_SIMD_TARGET( "avx2" ) __m128i
+  ft_lcd_legacy_avx2( const __m128i*    in,
+                      const FT_UShort*  taps,
+                      FT_UInt           stride )
+  {
+    __m256i  s0 = _mm256_setzero_si256();
+    __m256i  s1 = _mm256_setzero_si256();
+    int      k;
+
+
+    for ( k = 0; k < 5; k++, taps += stride )
+    {
+      __m256i  w0, w1;
+
+
+      w0 = _mm256_cvtepu16_epi32(
+             _mm_loadu_si128( (const __m128i*)taps ) );
+      w1 = _mm256_cvtepu16_epi32(
+             _mm_loadu_si128( (const __m128i*)( taps + 8 ) ) );
+
+      s0 = _mm256_add_epi32(
+             s0,
+             _mm256_mullo_epi32( _mm256_cvtepu8_epi32( in[k] ), w0 ) );
+      s1 = _mm256_add_epi32(
+             s1,
+             _mm256_mullo_epi32(
+               _mm256_cvtepu8_epi32( _mm_srli_si128( in[k], 8 ) ), w1 ) );
+    }
+
+    /* the results don't exceed 255; packing interleaves 64-bit units */
+    s0 = _mm256_packus_epi32( _mm256_srli_epi32( s0, 16 ),
+                              _mm256_srli_epi32( s1, 16 ) );
+    s0 = _mm256_permute4x64_epi64( s0, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+
+    return _mm_packus_epi16( _mm256_castsi256_si128( s0 ),
+                             _mm256_extracti128_si256( s0, 1 ) );
+  }
+
+
+  /* Set up `in' for the block `cur' of a row, with `prev' and `next' */
+  /* holding the original pixels of the adjacent blocks.              */
+
+  static void
+  ft_lcd_shift_sse2( __m128i*  in,
+                     __m128i   prev,
+                     __m128i   cur,
+                     __m128i   next )
+  {
+    in[0] = _mm_or_si128( _mm_srli_si128( cur, 2 ),
+                          _mm_slli_si128( next, 14 ) );
+    in[1] = _mm_or_si128( _mm_srli_si128( cur, 1 ),
+                          _mm_slli_si128( next, 15 ) );
+    in[2] = cur;
+    in[3] = _mm_or_si128( _mm_slli_si128( cur, 1 ),
+                          _mm_srli_si128( prev, 15 ) );
+    in[4] = _mm_or_si128( _mm_slli_si128( cur, 2 ),
+                          _mm_srli_si128( prev, 14 ) );
+  }
+
+
+  /* load the block of a row starting at `xx' */
+
+  static __m128i
+  ft_lcd_load_sse2( const FT_Byte*  line,
+                    FT_UInt         xx,
+                    FT_UInt         width )
+  {
+    FT_Byte  block[16];
+
+
+    if ( xx + 16 <= width )
+      return _mm_loadu_si128( (const __m128i*)( line + xx ) );
+
+    if ( xx >= width )
+      return _mm_setzero_si128();
+
+    ft_lcd_load_partial( block, line + xx, width - xx );
+
+    return _mm_loadu_si128( (const __m128i*)block );
+  }
+
+
+  /* store the block of a row starting at `xx' */
+
+  static void
+  ft_lcd_store_sse2( FT_Byte*  line,
+                     FT_UInt   xx,
+                     FT_UInt   width,
+                     __m128i   out )
+  {
+    FT_Byte  block[16];
+
+
+    if ( xx + 16 <= width )
+      _mm_storeu_si128( (__m128i*)( line + xx ), out );
+    else
+    {
+      _mm_storeu_si128( (__m128i*)block, out );
+      FT_MEM_COPY( line + xx, block, width - xx );
+    }
+  }
+
+
+  /* Filter a row in place; the legacy filter is used if `weights' is */
+  /* NULL.                                                            */
+
+  static void
+  ft_lcd_line_sse2( FT_Byte*        line,
+                    FT_UInt         width,
+                    const FT_Byte*  weights )
+  {
+    __m128i  w[5], in[5], prev, cur, next, out;
+    FT_UInt  xx, n;
+
+
+    if ( weights )
+      for ( n = 0; n < 5; n++ )
+        w[n] = _mm_set1_epi16( weights[n] );
+
+    prev = _mm_setzero_si128();
+    cur  = ft_lcd_load_sse2( line, 0, width );
+
+    for ( xx = 0, n = 0; xx < width; xx += 16, n = ( n + 16 ) % 48 )
+    {
+      next = ft_lcd_load_sse2( line, xx + 16, width );
+
+      ft_lcd_shift_sse2( in, prev, cur, next );
+
+      if ( weights )
+        out = ft_lcd_fir_sse2( in, w );
+      else
+        out = ft_lcd_legacy_sse2( in, ft_lcd_legacy_taps[0] + n, 48 );
+
+      ft_lcd_store_sse2( line, xx, width, out );
+
+      prev = cur;
+      cur  = next;
+    }
+  }
+
+
+  static FT_SIMD_TARGET( "avx2" ) void
+  ft_lcd_line_avx2( FT_Byte*        line,
+                    FT_UInt         width,
+                    const FT_Byte*  weights )
+  {
+    __m256i  w[5];
+    __m128i  in[5], prev, cur, next, out;
+    FT_UInt  xx, n;
+
+
+    if ( weights )
+      for ( n = 0; n < 5; n++ )
+        w[n] = _mm256_set1_epi16( weights[n] );
+
+    prev = _mm_setzero_si128();
+    cur  = ft_lcd_load_sse2( line, 0, width );
+
+    for ( xx = 0, n = 0; xx < width; xx += 16, n = ( n + 16 ) % 48 )
+    {
+      next = ft_lcd_load_sse2( line, xx + 16, width );
+
+      ft_lcd_shift_sse2( in, prev, cur, next );
+
+      if ( weights )
+        out = ft_lcd_fir_avx2( in, w );
+      else
+        out = ft_lcd_legacy_avx2( in, ft_lcd_legacy_taps[0] + n, 48 );
+
+      ft_lcd_store_sse2( line, xx, width, out );
+
+      prev = cur;
+      cur  = next;
+    }
+  }
+
+
+  /* Filter blocks of 16 columns in place, stepping by `pitch' from row */
+  /* to row, and return the number of columns done.  For the legacy     */
+  /* filter, `height' must be a multiple of 3.                          */
+
+  static FT_UInt
+  ft_lcd_columns_sse2( FT_Byte*        column,
+                       FT_Int          pitch,
+                       FT_UInt         width,
+                       FT_UInt         height,
+                       const FT_Byte*  weights )
+  {
+    FT_UShort  taps[3][5][16];
+    __m128i    w[5], in[7];
+    FT_UInt    xx, yy, k;
+
+
+    if ( weights )
+      for ( k = 0; k < 5; k++ )
+        w[k] = _mm_set1_epi16( weights[k] );
+    else
+      ft_lcd_legacy_column_taps( taps );
+
+    for ( xx = 0; xx + 16 <= width; xx += 16, column += 16 )
+    {
+      FT_Byte*  col = column;
+
+
+      if ( weights )
+      {
+        /* a window over rows yy + 2 to yy - 2; `height' is at least 4 */
+        in[4] = _mm_setzero_si128();
+        in[3] = _mm_setzero_si128();
+        in[2] = _mm_loadu_si128( (const __m128i*)col );
+        in[1] = _mm_loadu_si128( (const __m128i*)( col + pitch ) );
+        in[0] = _mm_loadu_si128( (const __m128i*)( col + 2 * pitch ) );
+
+        for ( yy = 0; yy < height; yy++, col += pitch )
         {
-          FT_UInt  pix;
+          _mm_storeu_si128( (__m128i*)col, ft_lcd_fir_sse2( in, w ) );
+
+          in[4] = in[3];
+          in[3] = in[2];
+          in[2] = in[1];
+          in[1] = in[0];
+          in[0] = yy + 3 < height
+                    ? _mm_loadu_si128( (const __m128i*)( col + 3 * pitch ) )
+                    : _mm_setzero_si128();
+        }
+      }
+      else
+      {
+        /* the triplet rows are placed so that `in + 2 - m' */
+        /* gives the inputs of the m-th output row          */
+        in[0] = _mm_setzero_si128();
+        in[1] = _mm_setzero_si128();
+        in[5] = _mm_setzero_si128();
+        in[6] = _mm_setzero_si128();
+
+        for ( yy = 0; yy + 3 <= height; yy += 3, col += 3 * pitch )
+        {
+          in[4] = _mm_loadu_si128( (const __m128i*)col );
+          in[3] = _mm_loadu_si128( (const __m128i*)( col + pitch ) );
+          in[2] = _mm_loadu_si128( (const __m128i*)( col + 2 * pitch ) );
+
+          _mm_storeu_si128( (__m128i*)col,
+                            ft_lcd_legacy_sse2( in + 2, taps[0][0], 16 ) );
+          _mm_storeu_si128( (__m128i*)( col + pitch ),
+                            ft_lcd_legacy_sse2( in + 1, taps[1][0], 16 ) );
+          _mm_storeu_si128( (__m128i*)( col + 2 * pitch ),
+                            ft_lcd_legacy_sse2( in, taps[2][0], 16 ) );
+        }
+      }
+    }
 
+    return xx;
+  }
 
-          pix          = fir[0] >> 8;
-          pix         |= (FT_UInt)-(FT_Int)( pix >> 8 );
-          line[xx - 2] = (FT_Byte)pix;
+#endif /* FT_SIMD_X86_64 */
 
-          pix          = fir[1] >> 8;
-          pix         |= (FT_UInt)-(FT_Int)( pix >> 8 );
-          line[xx - 1] = (FT_Byte)pix;
+
+#ifdef FT_SIMD_ARM64
+
+  static uint8x16_t
+  ft_lcd_fir_neon( const uint8x16_t*  in,
+                   const uint8x8_t*   w )
+  {
+    uint16x8_t  lo = vdupq_n_u16( 0 );
+    uint16x8_t  hi = vdupq_n_u16( 0 );
+    int         k;
+
+
+    for ( k = 0; k < 5; k++ )
+    {
+      lo = vqaddq_u16( lo, vmull_u8( vget_low_u8( in[k] ), w[k] ) );
+      hi = vqaddq_u16( hi, vmull_u8( vget_high_u8( in[k] ), w[k] ) );
+    }
+
+    return vcombine_u8( vshrn_n_u16( lo, 8 ), vshrn_n_u16( hi, 8 ) );
+  }
+
+
+  static uint8x16_t
+  ft_lcd_legacy_neon( const uint8x16_t*  in,
+                      const FT_UShort*   taps,
+                      FT_UInt            stride )
+  {
+    uint32x4_t  s0 = vdupq_n_u32( 0 );
+    uint32x4_t  s1 = vdupq_n_u32( 0 );
+    uint32x4_t  s2 = vdupq_n_u32( 0 );
+    uint32x4_t  s3 = vdupq_n_u32( 0 );
+    int         k;
+
+
+    for ( k = 0; k < 5; k++, taps += stride )
+    {
+      uint16x8_t  p, w;
+
+
+      p  = vmovl_u8( vget_low_u8( in[k] ) );
+      w  = vld1q_u16( taps );
+      s0 = vmlal_u16( s0, vget_low_u16( p ), vget_low_u16( w ) );
+      s1 = vmlal_u16( s1, vget_high_u16( p ), vget_high_u16( w ) );
+
+      p  = vmovl_u8( vget_high_u8( in[k] ) );
+      w  = vld1q_u16( taps + 8 );
+      s2 = vmlal_u16( s2, vget_low_u16( p ), vget_low_u16( w ) );
+      s3 = vmlal_u16( s3, vget_high_u16( p ), vget_high_u16( w ) );
+    }
+
+    /* the results don't exceed 255 */
+    return vcombine_u8(
+             vmovn_u16( vcombine_u16( vshrn_n_u32( s0, 16 ),
+                                      vshrn_n_u32( s1, 16 ) ) ),
+             vmovn_u16( vcombine_u16( vshrn_n_u32( s2, 16 ),
+                                      vshrn_n_u32( s3, 16 ) ) ) );
+  }
+
+
+  static uint8x16_t
+  ft_lcd_load_neon( const FT_Byte*  line,
+                    FT_UInt         xx,
+                    FT_UInt         width )
+  {
+    FT_Byte  block[16];
+
+
+    if ( xx + 16 <= width )
+      return vld1q_u8( line + xx );
+
+    if ( xx >= width )
+      return vdupq_n_u8( 0 );
+
+    ft_lcd_load_partial( block, line + xx, width - xx );
+
+    return vld1q_u8( block );
+  }
+
+
+  static void
+  ft_lcd_line_neon( FT_Byte*        line,
+                    FT_UInt         width,
+                    const FT_Byte*  weights )
+  {
+    FT_Byte     block[16];
+    uint8x8_t   w[5];
+    uint8x16_t  in[5], prev, cur, next, out;
+    FT_UInt     xx, n;
+
+
+    if ( weights )
+      for ( n = 0; n < 5; n++ )
+        w[n] = vdup_n_u8( weights[n] );
+
+    prev = vdupq_n_u8( 0 );
+    cur  = ft_lcd_load_neon( line, 0, width );
+
+    for ( xx = 0, n = 0; xx < width; xx += 16, n = ( n + 16 ) % 48 )
+    {
+      next = ft_lcd_load_neon( line, xx + 16, width );
+
+      in[0] = vextq_u8( cur, next, 2 );
+      in[1] = vextq_u8( cur, next, 1 );
+      in[2] = cur;
+      in[3] = vextq_u8( prev, cur, 15 );
+      in[4] = vextq_u8( prev, cur, 14 );
+
+      if ( weights )
+        out = ft_lcd_fir_neon( in, w );
+      else
+        out = ft_lcd_legacy_neon( in, ft_lcd_legacy_taps[0] + n, 48 );
+
+      if ( xx + 16 <= width )
+        vst1q_u8( line + xx, out );
+      else
+      {
+        vst1q_u8( block, out );
+        FT_MEM_COPY( line + xx, block, width - xx );
+      }
+
+      prev = cur;
+      cur  = next;
+    }
+  }
+
+
+  static FT_UInt
+  ft_lcd_columns_neon( FT_Byte*        column,
+                       FT_Int          pitch,
+                       FT_UInt         width,
+                       FT_UInt         height,
+                       const FT_Byte*  weights )
+  {
+    FT_UShort   taps[3][5][16];
+    uint8x8_t   w[5];
+    uint8x16_t  in[7];
+    FT_UInt     xx, yy, k;
+
+
+    if ( weights )
+      for ( k = 0; k < 5; k++ )
+        w[k] = vdup_n_u8( weights[k] );
+    else
+      ft_lcd_legacy_column_taps( taps );
+
+    for ( xx = 0; xx + 16 <= width; xx += 16, column += 16 )
+    {
+      FT_Byte*  col = column;
+
+
+      if ( weights )
+      {
+        in[4] = vdupq_n_u8( 0 );
+        in[3] = vdupq_n_u8( 0 );
+        in[2] = vld1q_u8( col );
+        in[1] = vld1q_u8( col + pitch );
+        in[0] = vld1q_u8( col + 2 * pitch );
+
+        for ( yy = 0; yy < height; yy++, col += pitch )
+        {
+          vst1q_u8( col, ft_lcd_fir_neon( in, w ) );
+
+          in[4] = in[3];
+          in[3] = in[2];
+          in[2] = in[1];
+          in[1] = in[0];
+          in[0] = yy + 3 < height ? vld1q_u8( col + 3 * pitch )
+                                  : vdupq_n_u8( 0 );
+        }
+      }
+      else
+      {
+        in[0] = vdupq_n_u8( 0 );
+        in[1] = vdupq_n_u8( 0 );
+        in[5] = vdupq_n_u8( 0 );
+        in[6] = vdupq_n_u8( 0 );
+
+        for ( yy = 0; yy + 3 <= height; yy += 3, col += 3 * pitch )
+        {
+          in[4] = vld1q_u8( col );
+          in[3] = vld1q_u8( col + pitch );
+          in[2] = vld1q_u8( col + 2 * pitch );
+
+          vst1q_u8( col, ft_lcd_legacy_neon( in + 2, taps[0][0], 16 ) );
+          vst1q_u8( col + pitch,
+                    ft_lcd_legacy_neon( in + 1, taps[1][0], 16 ) );
+          vst1q_u8( col + 2 * pitch,
+                    ft_lcd_legacy_neon( in, taps[2][0], 16 ) );
         }
       }
     }
 
+    return xx;
+  }
+
+#endif /* FT_SIMD_ARM64 */
+
+
+  /* Filter a row of a horizontal LCD bitmap in place, using the legacy */
+  /* filter if `weights' is NULL.                                       */
+  static void
+  ft_lcd_line( FT_Byte*        line,
+               FT_UInt         width,
+               const FT_Byte*  weights )
+  {
+#ifdef FT_LCD_VECTORS
+    FT_UInt  features = 0;
+
+
+    if ( !weights || FT_LCD_VECTOR_WEIGHTS( weights ) )
+      features = ft_simd_get_features();
+
+#ifdef FT_SIMD_X86_64
+    if ( features & FT_SIMD_AVX2 )
+    {
+      ft_lcd_line_avx2( line, width, weights );
+      return;
+    }
+
+    if ( features & FT_SIMD_SSE2 )
+    {
+      ft_lcd_line_sse2( line, width, weights );
+      return;
+    }
+#endif
+#ifdef FT_SIMD_ARM64
+    if ( features & FT_SIMD_NEON )
+    {
+      ft_lcd_line_neon( line, width, weights );
+      return;
+    }
+#endif
+#endif /* FT_LCD_VECTORS */
+
+#ifdef USE_LEGACY
+    if ( !weights )
+      ft_lcd_legacy_line( line, width );
+    else
+#endif
+      ft_lcd_fir_line( line, width, weights );
+  }
+
+
+  /* Filter blocks of columns of a vertical LCD bitmap in place and */
+  /* return the number of columns done; see `ft_lcd_columns_sse2'.  */
+  static FT_UInt
+  ft_lcd_columns( FT_Byte*        column,
+                  FT_Int          pitch,
+                  FT_UInt         width,
+                  FT_UInt         height,
+                  const FT_Byte*  weights )
+  {
+#ifdef FT_LCD_VECTORS
+    if ( weights && !FT_LCD_VECTOR_WEIGHTS( weights ) )
+      return 0;
+#endif
+
+#if defined( FT_SIMD_X86_64 )
+    return ft_lcd_columns_sse2( column, pitch, width, height, weights );
+#elif defined( FT_SIMD_ARM64 )
+    return ft_lcd_columns_neon( column, pitch, width, height, weights );
+#else
+    FT_UNUSED( column );
+    FT_UNUSED( pitch );
+    FT_UNUSED( width );
+    FT_UNUSED( height );
+    FT_UNUSED( weights );
+
+    return 0;
+#endif
+  }
+
+
+  /* FIR filter used by the default and light filters */
+  static void
+  _ft_lcd_filter_fir( FT_Bitmap*      bitmap,
+                      FT_Render_Mode  mode,
+                      FT_Library      library )
+  {
+    FT_Byte*  weights = library->lcd_weights;
+    FT_UInt   width   = (FT_UInt)bitmap->width;
+    FT_UInt   height  = (FT_UInt)bitmap->rows;
+
+
+    /* horizontal in-place FIR filter */
+    if ( mode == FT_RENDER_MODE_LCD && width >= 4 )
+    {
+      FT_Byte*  line = bitmap->buffer;
+
+
+      /* take care of bitmap flow */
+      if ( bitmap->pitch < 0 )
+        line -= bitmap->pitch * ( bitmap->rows - 1 );
+
+      for ( ; height > 0; height--, line += bitmap->pitch )
+        ft_lcd_line( line, width, weights );
+    }
+
     /* vertical in-place FIR filter */
     else if ( mode == FT_RENDER_MODE_LCD_V && height >= 4 )
     {
       FT_Byte*  column = bitmap->buffer;
       FT_Int    pitch  = bitmap->pitch;
+      FT_UInt   done;
 
 
       /* take care of bitmap flow */
       if ( bitmap->pitch < 0 )
         column -= bitmap->pitch * ( bitmap->rows - 1 );
 
+      done    = ft_lcd_columns( column, pitch, width, height, weights );
+      column += done;
+      width  -= done;
+
       for ( ; width > 0; width--, column++ )
       {
         FT_Byte*  col = column;
@@ -182,13 +974,6 @@
     FT_UInt  height = (FT_UInt)bitmap->rows;
     FT_Int   pitch  = bitmap->pitch;
 
-    static const int  filters[3][3] =
-    {
-      { 65538 * 9/13, 65538 * 1/6, 65538 * 1/13 },
-      { 65538 * 3/13, 65538 * 4/6, 65538 * 3/13 },
-      { 65538 * 1/13, 65538 * 1/6, 65538 * 9/13 }
-    };
-
     FT_UNUSED( library );
 
 
@@ -203,48 +988,22 @@
         line -= bitmap->pitch * ( bitmap->rows - 1 );
 
       for ( ; height > 0; height--, line += pitch )
-      {
-        FT_UInt  xx;
-
-
-        for ( xx = 0; xx < width; xx += 3 )
-        {
-          FT_UInt  r = 0;
-          FT_UInt  g = 0;
-          FT_UInt  b = 0;
-          FT_UInt  p;
-
-
-          p  = line[xx];
-          r += filters[0][0] * p;
-          g += filters[0][1] * p;
-          b += filters[0][2] * p;
-
-          p  = line[xx + 1];
-          r += filters[1][0] * p;
-          g += filters[1][1] * p;
-          b += filters[1][2] * p;
-
-          p  = line[xx + 2];
-          r += filters[2][0] * p;
-          g += filters[2][1] * p;
-          b += filters[2][2] * p;
-
-          line[xx]     = (FT_Byte)( r / 65536 );
-          line[xx + 1] = (FT_Byte)( g / 65536 );
-          line[xx + 2] = (FT_Byte)( b / 65536 );
-        }
-      }
+        ft_lcd_line( line, width, NULL );
     }
     else if ( mode == FT_RENDER_MODE_LCD_V && height >= 3 )
     {
       FT_Byte*  column = bitmap->buffer;
+      FT_UInt   done;
 
 
       /* take care of bitmap flow */
       if ( bitmap->pitch < 0 )
         column -= bitmap->pitch * ( bitmap->rows - 1 );
 
+      done    = ft_lcd_columns( column, pitch, width, height, NULL );
+      column += done;
+      width  -= done;
+
       for ( ; width > 0; width--, column++ )
       {
         FT_Byte*  col     = column;
@@ -260,19 +1019,19 @@
 
 
           p  = col[0];
-          r += filters[0][0] * p;
-          g += filters[0][1] * p;
-          b += filters[0][2] * p;
+          r += ft_lcd_legacy_filters[0][0] * p;
+          g += ft_lcd_legacy_filters[0][1] * p;
+          b += ft_lcd_legacy_filters[0][2] * p;
 
           p  = col[pitch];
-          r += filters[1][0] * p;
-          g += filters[1][1] * p;
-          b += filters[1][2] * p;
+          r += ft_lcd_legacy_filters[1][0] * p;
+          g += ft_lcd_legacy_filters[1][1] * p;
+          b += ft_lcd_legacy_filters[1][2] * p;
 
           p  = col[pitch * 2];
-          r += filters[2][0] * p;
-          g += filters[2][1] * p;
-          b += filters[2][2] * p;
+          r += ft_lcd_legacy_filters[2][0] * p;
+          g += ft_lcd_legacy_filters[2][1] * p;
+          b += ft_lcd_legacy_filters[2][2] * p;
 
           col[0]         = (FT_Byte)( r / 65536 );
           col[pitch]     = (FT_Byte)( g / 65536 );
@@ -285,6 +1044,24 @@
 #endif /* USE_LEGACY */
 
 
+  /* documentation is in ftobjs.h */
+
+  FT_BASE_DEF( void )
+  ft_lcd_filter_line( FT_Library  library,
+                      FT_Byte*    line,
+                      FT_UInt     width )
+  {
+    if ( library->lcd_filter_func == _ft_lcd_filter_fir && width >= 4 )
+      ft_lcd_line( line, width, library->lcd_weights );
+
+#ifdef USE_LEGACY
+    else if ( library->lcd_filter_func == _ft_lcd_filter_legacy &&
+              width >= 3                                        )
+      ft_lcd_line( line, width, NULL );
+#endif
+  }
+
+
   FT_EXPORT_DEF( FT_Error )
   FT_Library_SetLcdFilterWeights( FT_Library      library,
                                   unsigned char  *weights )
@@ -340,6 +340,9 @@
     /* free bitmap if needed */
     ft_glyphslot_free_bitmap( slot );
 
+    /* forget the orientation of the previous outline */
+    slot->internal->flags &= ~FT_GLYPH_HAS_ORIENTATION;
+
     /* clear all public fields in the glyph slot */
     FT_ZERO( &slot->metrics );
     FT_ZERO( &slot->outline );
@@ -602,6 +605,8 @@
     FT_Module     hinter;
     TT_Face       ttface = (TT_Face)face;
 
+    FT_TIMER_VAR( start )
+
 
     if ( !face || !face->size || !face->glyph )
       return FT_THROW( Invalid_Face_Handle );
@@ -719,19 +724,33 @@
         /* load auto-hinted outline */
         hinting = (FT_AutoHinter_Interface)hinter->clazz->module_interface;
 
+        FT_COUNTER_INC( library, FT_COUNTER_AUTOHINT_LOADS );
+        FT_TIMER_START( library, start );
+
         error   = hinting->load_glyph( (FT_AutoHinter)hinter,
                                        slot, face->size,
                                        glyph_index, load_flags );
 
+        FT_TIMER_STOP( library, FT_COUNTER_HINTING_TIME, start );
+
         internal->transform_flags = transform_flags;
       }
     }
     else
     {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+      FT_ATOMIC_ADD( driver->glyph_loads, 1 );
+#endif
+      FT_COUNTER_INC( library, FT_COUNTER_GLYPH_LOADS );
+      FT_TIMER_START( library, start );
+
       error = driver->clazz->load_glyph( slot,
                                          face->size,
                                          glyph_index,
                                          load_flags );
+
+      FT_TIMER_STOP( library, FT_COUNTER_LOAD_TIME, start );
+
       if ( error )
         goto Exit;
 
@@ -4690,6 +4709,10 @@
 
     library->refcount = 1;
 
+#ifdef FT_CONFIG_OPTION_COUNTERS
+    FT_Reset_Counters( library );
+#endif
+
     /* That's ok now */
     *alibrary = library;
 
@@ -4861,6 +4884,167 @@
   }
 
 
+#if defined( FT_CONFIG_OPTION_COUNTERS ) && !defined( FT_CONFIG_OPTION_PIC )
+
+  FT_BASE_DEF( FT_ULong )  ft_global_counters[FT_COUNTER_MAX];
+
+#define FT_IS_GLOBAL_COUNTER( c )                 \
+          ( (c) == FT_COUNTER_STREAM_BYTES ||     \
+            (c) == FT_COUNTER_ALLOCATIONS  )
+
+#endif
+
+
+  /* documentation is in ftcountr.h */
+
+  FT_EXPORT_DEF( FT_ULong )
+  FT_Get_Counter( FT_Library  library,
+                  FT_UInt     counter )
+  {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+
+    if ( !library || counter >= FT_COUNTER_MAX )
+      return 0;
+
+#ifndef FT_CONFIG_OPTION_PIC
+    if ( FT_IS_GLOBAL_COUNTER( counter ) )
+      return ft_global_counters[counter] - library->counters[counter];
+#endif
+
+    return library->counters[counter];
+
+#else /* !FT_CONFIG_OPTION_COUNTERS */
+
+    FT_UNUSED( library );
+    FT_UNUSED( counter );
+
+    return 0;
+
+#endif /* !FT_CONFIG_OPTION_COUNTERS */
+  }
+
+
+  /* documentation is in ftcountr.h */
+
+  FT_EXPORT_DEF( const char* )
+  FT_Get_Counter_Name( FT_UInt  counter )
+  {
+    static const char* const  counter_names[FT_COUNTER_MAX] =
+    {
+      "glyph_loads",
+      "autohint_loads",
+      "load_time",
+      "hinting_time",
+      "instructions",
+      "raster_cells",
+      "band_splits",
+      "cache_hits",
+      "cache_misses",
+      "stream_bytes",
+      "allocations"
+    };
+
+
+    if ( counter >= FT_COUNTER_MAX )
+      return NULL;
+
+    return counter_names[counter];
+  }
+
+
+  /* documentation is in ftcountr.h */
+
+  FT_EXPORT_DEF( FT_ULong )
+  FT_Get_Driver_Glyph_Loads( FT_Library   library,
+                             const char*  driver_name )
+  {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+
+    FT_Module  module = FT_Get_Module( library, driver_name );
+
+
+    if ( !module || !FT_MODULE_IS_DRIVER( module ) )
+      return 0;
+
+    return FT_DRIVER( module )->glyph_loads;
+
+#else /* !FT_CONFIG_OPTION_COUNTERS */
+
+    FT_UNUSED( library );
+    FT_UNUSED( driver_name );
+
+    return 0;
+
+#endif /* !FT_CONFIG_OPTION_COUNTERS */
+  }
+
+
+  /* documentation is in ftcountr.h */
+
+  FT_EXPORT_DEF( void )
+  FT_Reset_Counters( FT_Library  library )
+  {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+
+    FT_UInt  n;
+
+
+    if ( !library )
+      return;
+
+    for ( n = 0; n < FT_COUNTER_MAX; n++ )
+    {
+#ifndef FT_CONFIG_OPTION_PIC
+      if ( FT_IS_GLOBAL_COUNTER( n ) )
+        library->counters[n] = ft_global_counters[n];
+      else
+#endif
+        library->counters[n] = 0;
+    }
+
+    for ( n = 0; n < library->num_modules; n++ )
+    {
+      FT_Module  module = library->modules[n];
+
+
+      if ( FT_MODULE_IS_DRIVER( module ) )
+        FT_DRIVER( module )->glyph_loads = 0;
+    }
+
+#else /* !FT_CONFIG_OPTION_COUNTERS */
+
+    FT_UNUSED( library );
+
+#endif /* !FT_CONFIG_OPTION_COUNTERS */
+  }
+
+
+  /* documentation is in ftcountr.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Set_Counter_Clock( FT_Library            library,
+                        FT_Counter_ClockFunc  clock )
+  {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+
+    if ( !library )
+      return FT_THROW( Invalid_Library_Handle );
+
+    library->counter_clock = clock;
+
+    return FT_Err_Ok;
+
+#else /* !FT_CONFIG_OPTION_COUNTERS */
+
+    FT_UNUSED( library );
+    FT_UNUSED( clock );
+
+    return FT_THROW( Unimplemented_Feature );
+
+#endif /* !FT_CONFIG_OPTION_COUNTERS */
+  }
+
+
   /* documentation is in ftmodapi.h */
 
   FT_EXPORT_DEF( FT_TrueTypeEngineType )
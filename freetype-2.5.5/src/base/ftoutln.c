@@ -27,6 +27,7 @@
 #include FT_OUTLINE_H
 #include FT_INTERNAL_OBJECTS_H
 #include FT_INTERNAL_CALC_H
+#include FT_INTERNAL_SIMD_H
 #include FT_INTERNAL_DEBUG_H
 #include FT_TRIGONOMETRY_H
 
@@ -474,47 +475,8 @@
   FT_Outline_Get_CBox( const FT_Outline*  outline,
                        FT_BBox           *acbox )
   {
-    FT_Pos  xMin, yMin, xMax, yMax;
-
-
     if ( outline && acbox )
-    {
-      if ( outline->n_points == 0 )
-      {
-        xMin = 0;
-        yMin = 0;
-        xMax = 0;
-        yMax = 0;
-      }
-      else
-      {
-        FT_Vector*  vec   = outline->points;
-        FT_Vector*  limit = vec + outline->n_points;
-
-
-        xMin = xMax = vec->x;
-        yMin = yMax = vec->y;
-        vec++;
-
-        for ( ; vec < limit; vec++ )
-        {
-          FT_Pos  x, y;
-
-
-          x = vec->x;
-          if ( x < xMin ) xMin = x;
-          if ( x > xMax ) xMax = x;
-
-          y = vec->y;
-          if ( y < yMin ) yMin = y;
-          if ( y > yMax ) yMax = y;
-        }
-      }
-      acbox->xMin = xMin;
-      acbox->xMax = xMax;
-      acbox->yMin = yMin;
-      acbox->yMax = yMax;
-    }
+      ft_vector_array_get_cbox( outline->points, outline->n_points, acbox );
   }
 
 
@@ -525,21 +487,17 @@
                         FT_Pos             xOffset,
                         FT_Pos             yOffset )
   {
-    FT_UShort   n;
-    FT_Vector*  vec;
+    FT_Vector  delta;
 
 
     if ( !outline )
       return;
 
-    vec = outline->points;
+    delta.x = xOffset;
+    delta.y = yOffset;
 
-    for ( n = 0; n < outline->n_points; n++ )
-    {
-      vec->x += xOffset;
-      vec->y += yOffset;
-      vec++;
-    }
+    ft_vector_array_transform( outline->points, outline->n_points,
+                               NULL, &delta );
   }
 
 
@@ -714,18 +672,11 @@
   FT_Outline_Transform( const FT_Outline*  outline,
                         const FT_Matrix*   matrix )
   {
-    FT_Vector*  vec;
-    FT_Vector*  limit;
-
-
     if ( !outline || !matrix )
       return;
 
-    vec   = outline->points;
-    limit = vec + outline->n_points;
-
-    for ( ; vec < limit; vec++ )
-      FT_Vector_Transform( vec, matrix );
+    ft_vector_array_transform( outline->points, outline->n_points,
+                               matrix, NULL );
   }
 
 
@@ -906,17 +857,41 @@
   }
 
 
-  /* documentation is in ftoutln.h */
+  /* apply the slant and transformation of `ft_outline_synthesize' */
+  static void
+  ft_outline_transform_point( FT_Vector*        vec,
+                              FT_Fixed          slant,
+                              const FT_Matrix*  matrix,
+                              const FT_Vector*  delta )
+  {
+    if ( slant )
+      vec->x += FT_MulFix( vec->y, slant );
 
-  FT_EXPORT_DEF( FT_Error )
-  FT_Outline_EmboldenXY( FT_Outline*  outline,
-                         FT_Pos       xstrength,
-                         FT_Pos       ystrength )
+    if ( matrix )
+      FT_Vector_Transform( vec, matrix );
+
+    if ( delta )
+    {
+      vec->x += delta->x;
+      vec->y += delta->y;
+    }
+  }
+
+
+  /* documentation is in ftobjs.h */
+
+  FT_BASE_DEF( FT_Error )
+  ft_outline_synthesize( FT_Outline*       outline,
+                         FT_Pos            xstrength,
+                         FT_Pos            ystrength,
+                         FT_Int            orientation,
+                         FT_Fixed          slant,
+                         const FT_Matrix*  matrix,
+                         const FT_Vector*  delta )
   {
     FT_Vector*  points;
     FT_Vector   v_prev, v_first, v_next, v_cur;
     FT_Int      c, n, first;
-    FT_Int      orientation;
 
 
     if ( !outline )
@@ -924,19 +899,21 @@
 
     xstrength /= 2;
     ystrength /= 2;
-    if ( xstrength == 0 && ystrength == 0 )
-      return FT_Err_Ok;
 
-    orientation = FT_Outline_Get_Orientation( outline );
-    if ( orientation == FT_ORIENTATION_NONE )
+    points = outline->points;
+
+    if ( ( xstrength == 0 && ystrength == 0 ) ||
+         orientation == FT_ORIENTATION_NONE   )
     {
-      if ( outline->n_contours )
-        return FT_THROW( Invalid_Argument );
+      if ( !slant )
+        ft_vector_array_transform( points, outline->n_points,
+                                   matrix, delta );
       else
-        return FT_Err_Ok;
-    }
+        for ( n = 0; n < outline->n_points; n++ )
+          ft_outline_transform_point( points + n, slant, matrix, delta );
 
-    points = outline->points;
+      return FT_Err_Ok;
+    }
 
     first = 0;
     for ( c = 0; c < outline->n_contours; c++ )
@@ -1016,8 +993,12 @@
         else
           shift.x = shift.y = 0;
 
-        outline->points[n].x = v_cur.x + xstrength + shift.x;
-        outline->points[n].y = v_cur.y + ystrength + shift.y;
+        /* the next point has already been read, so we can */
+        /* transform the current one in place              */
+        points[n].x = v_cur.x + xstrength + shift.x;
+        points[n].y = v_cur.y + ystrength + shift.y;
+
+        ft_outline_transform_point( points + n, slant, matrix, delta );
 
         in    = out;
         l_in  = l_out;
@@ -1031,6 +1012,36 @@
   }
 
 
+  /* documentation is in ftoutln.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Outline_EmboldenXY( FT_Outline*  outline,
+                         FT_Pos       xstrength,
+                         FT_Pos       ystrength )
+  {
+    FT_Int  orientation;
+
+
+    if ( !outline )
+      return FT_THROW( Invalid_Outline );
+
+    if ( xstrength / 2 == 0 && ystrength / 2 == 0 )
+      return FT_Err_Ok;
+
+    orientation = FT_Outline_Get_Orientation( outline );
+    if ( orientation == FT_ORIENTATION_NONE )
+    {
+      if ( outline->n_contours )
+        return FT_THROW( Invalid_Argument );
+      else
+        return FT_Err_Ok;
+    }
+
+    return ft_outline_synthesize( outline, xstrength, ystrength,
+                                  orientation, 0, NULL, NULL );
+  }
+
+
   /* documentation is in ftoutln.h */
 
   FT_EXPORT_DEF( FT_Orientation )
@@ -0,0 +1,602 @@
+/***************************************************************************/
+/*                                                                         */
+/*  ftsimd.c                                                               */
+/*                                                                         */
+/*    Vectorized computations (body).                                      */
+/*                                                                         */
+/*  Copyright 2026 by                                                      */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* All vectorized functions compute exactly the same results as their    */
+  /* scalar counterparts.  Fixed-point multiplications are only done with  */
+  /* SIMD instructions if the ranges of the input values guarantee that    */
+  /* all variants of `FT_MulFix' (see `ftcalc.h') agree and that no        */
+  /* intermediate value overflows; otherwise the scalar code is used.      */
+  /*                                                                       */
+  /*************************************************************************/
+
+
+#include <ft2build.h>
+#include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_CALC_H
+#include FT_INTERNAL_SIMD_H
+
+#ifdef FT_SIMD_X86_64
+#include <immintrin.h>
+#endif
+
+#ifdef FT_SIMD_ARM64
+#include <arm_neon.h>
+#endif
+
+
+  /* the vector kernels handle `FT_Pos' values as 64-bit integers */
+#if ( defined( FT_SIMD_X86_64 ) || defined( FT_SIMD_ARM64 ) ) && \
+    FT_SIZEOF_LONG == ( 64 / FT_CHAR_BIT )
+#define FT_SIMD_VECTORS
+#endif
+
+
+  /* set in `ft_simd_features' after the CPU has been queried */
+#define FT_SIMD_DETECTED  0x80000000UL
+
+  /* Transforming fewer vectors is done by the scalar code since the */
+  /* range check needs an additional pass.                           */
+#define FT_SIMD_MIN_TRANSFORM  8
+
+
+  /* Concurrent first calls of `ft_simd_get_features' all store the */
+  /* same value, so this variable doesn't need a lock.              */
+  static FT_UInt32  ft_simd_features;
+
+
+  /* documentation is in ftsimd.h */
+
+  FT_BASE_DEF( FT_UInt )
+  ft_simd_get_features( void )
+  {
+    FT_UInt32  features = ft_simd_features;
+
+
+    if ( !features )
+    {
+      features = FT_SIMD_DETECTED;
+
+#ifdef FT_SIMD_X86_64
+      features |= FT_SIMD_SSE2;
+      if ( __builtin_cpu_supports( "avx2" ) )
+        features |= FT_SIMD_AVX2;
+#endif
+#ifdef FT_SIMD_ARM64
+      features |= FT_SIMD_NEON;
+#endif
+
+      ft_simd_features = features;
+    }
+
+    return (FT_UInt)( features & ~FT_SIMD_DETECTED );
+  }
+
+
+#ifdef FT_SIMD_VECTORS
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* If all input values of a transformation fit into 32 bits and all      */
+  /* products are less than 2^45 in magnitude, the rounded products are    */
+  /* less than 2^29.  All variants of `FT_MulFix', including the ones that */
+  /* truncate to 32 bits, then return the same values, and their sums      */
+  /* don't overflow.  `ft_simd_transform_limit' returns the largest        */
+  /* coordinate magnitude satisfying these conditions (rounded down to a   */
+  /* power of two minus one).                                              */
+  /*                                                                       */
+  /* The vector code rounds a product `p' with                             */
+  /*                                                                       */
+  /*   (p + 0x8000 - s + 2^47) >> 16                                       */
+  /*                                                                       */
+  /* where `s' is 1 if the signs of the factors differ and 0 otherwise     */
+  /* (making no difference if `p' is zero), which is the rounding of       */
+  /* `FT_MulFix' plus 2^31.  The bias ensures a positive operand for the   */
+  /* logical shift; it is subtracted together with the translation.        */
+  /*                                                                       */
+  /*************************************************************************/
+
+#define FT_SIMD_BIAS  ( (FT_Pos)1 << 32 )
+
+
+  static FT_Pos
+  ft_simd_transform_limit( FT_Fixed  a,
+                           FT_Fixed  b )
+  {
+    FT_ULong  ua = a < 0 ? 0UL - (FT_ULong)a : (FT_ULong)a;
+    FT_ULong  ub = b < 0 ? 0UL - (FT_ULong)b : (FT_ULong)b;
+    FT_ULong  s  = FT_MAX( ua, ub );
+    FT_Int    k;
+
+
+    /* only zero coordinates keep the products exact */
+    if ( s > 0x7FFFFFFFUL )
+      return 0;
+
+    if ( s < 0x4000 )
+      return 0x7FFFFFFFL;
+
+    /* s < 2^(k+1) */
+    k = FT_MSB( (FT_UInt32)s );
+
+    return ( (FT_Pos)1 << ( 44 - k ) ) - 1;
+  }
+
+
+#ifdef FT_SIMD_X86_64
+
+  static FT_SIMD_TARGET( "avx2" ) void
+  ft_vector_array_translate_avx2( FT_Vector*        vec,
+                                  FT_Int            count,
+                                  const FT_Vector*  delta )
+  {
+    __m256i  d = _mm256_set_epi64x( delta->y, delta->x,
+                                    delta->y, delta->x );
+
+
+    for ( ; count >= 2; count -= 2, vec += 2 )
+      _mm256_storeu_si256( (__m256i*)vec,
+                           _mm256_add_epi64(
+                             _mm256_loadu_si256( (__m256i*)vec ), d ) );
+
+    if ( count )
+    {
+      vec->x += delta->x;
+      vec->y += delta->y;
+    }
+  }
+
+
+  /* The loop uses two sets of accumulators to hide the latency of */
+  /* the comparisons.                                              */
+
+  static FT_SIMD_TARGET( "avx2" ) void
+  ft_vector_array_get_cbox_avx2( const FT_Vector*  vec,
+                                 FT_Int            count,
+                                 FT_BBox          *acbox )
+  {
+    __m256i    min0, max0, min1, max1, p, q;
+    __m128i    lmin, lmax, hmin, hmax;
+    FT_Vector  v;
+
+
+    /* a single vector is loaded into both lanes */
+    p    = _mm256_broadcastsi128_si256(
+             _mm_loadu_si128( (const __m128i*)( vec + count - 1 ) ) );
+    min0 = p;
+    max0 = p;
+    min1 = p;
+    max1 = p;
+
+    for ( ; count >= 4; count -= 4, vec += 4 )
+    {
+      p    = _mm256_loadu_si256( (const __m256i*)vec );
+      q    = _mm256_loadu_si256( (const __m256i*)( vec + 2 ) );
+      min0 = _mm256_blendv_epi8( min0, p, _mm256_cmpgt_epi64( min0, p ) );
+      max0 = _mm256_blendv_epi8( max0, p, _mm256_cmpgt_epi64( p, max0 ) );
+      min1 = _mm256_blendv_epi8( min1, q, _mm256_cmpgt_epi64( min1, q ) );
+      max1 = _mm256_blendv_epi8( max1, q, _mm256_cmpgt_epi64( q, max1 ) );
+    }
+
+    if ( count >= 2 )
+    {
+      p    = _mm256_loadu_si256( (const __m256i*)vec );
+      min0 = _mm256_blendv_epi8( min0, p, _mm256_cmpgt_epi64( min0, p ) );
+      max0 = _mm256_blendv_epi8( max0, p, _mm256_cmpgt_epi64( p, max0 ) );
+    }
+
+    min0 = _mm256_blendv_epi8( min0, min1, _mm256_cmpgt_epi64( min0, min1 ) );
+    max0 = _mm256_blendv_epi8( max0, max1, _mm256_cmpgt_epi64( max1, max0 ) );
+
+    lmin = _mm256_castsi256_si128( min0 );
+    hmin = _mm256_extracti128_si256( min0, 1 );
+    lmin = _mm_blendv_epi8( lmin, hmin, _mm_cmpgt_epi64( lmin, hmin ) );
+
+    lmax = _mm256_castsi256_si128( max0 );
+    hmax = _mm256_extracti128_si256( max0, 1 );
+    lmax = _mm_blendv_epi8( lmax, hmax, _mm_cmpgt_epi64( hmax, lmax ) );
+
+    _mm_storeu_si128( (__m128i*)&v, lmin );
+    acbox->xMin = v.x;
+    acbox->yMin = v.y;
+
+    _mm_storeu_si128( (__m128i*)&v, lmax );
+    acbox->xMax = v.x;
+    acbox->yMax = v.y;
+  }
+
+
+  /* return TRUE if all coordinates are within the given limits */
+
+  static FT_SIMD_TARGET( "avx2" ) FT_Bool
+  ft_vector_array_check_avx2( const FT_Vector*  vec,
+                              FT_Int            count,
+                              FT_Pos            xlimit,
+                              FT_Pos            ylimit )
+  {
+    __m256i  hi  = _mm256_set_epi64x( ylimit, xlimit, ylimit, xlimit );
+    __m256i  lo  = _mm256_sub_epi64( _mm256_setzero_si256(), hi );
+    __m256i  out = _mm256_setzero_si256();
+    __m256i  p;
+
+
+    for ( ; count >= 2; count -= 2, vec += 2 )
+    {
+      p   = _mm256_loadu_si256( (const __m256i*)vec );
+      out = _mm256_or_si256( out,
+                             _mm256_or_si256( _mm256_cmpgt_epi64( p, hi ),
+                                              _mm256_cmpgt_epi64( lo, p ) ) );
+    }
+
+    if ( count )
+    {
+      p   = _mm256_broadcastsi128_si256(
+              _mm_loadu_si128( (const __m128i*)vec ) );
+      out = _mm256_or_si256( out,
+                             _mm256_or_si256( _mm256_cmpgt_epi64( p, hi ),
+                                              _mm256_cmpgt_epi64( lo, p ) ) );
+    }
+
+    return FT_BOOL( _mm256_testz_si256( out, out ) );
+  }
+
+
+  /* the coordinates must be checked with `ft_vector_array_check_avx2' */
+
+  static FT_SIMD_TARGET( "avx2" ) void
+  ft_vector_array_transform_avx2( FT_Vector*        vec,
+                                  FT_Int            count,
+                                  const FT_Matrix*  matrix,
+                                  const FT_Vector*  delta )
+  {
+    __m256i  mx   = _mm256_set_epi64x( matrix->yx, matrix->xx,
+                                       matrix->yx, matrix->xx );
+    __m256i  my   = _mm256_set_epi64x( matrix->yy, matrix->xy,
+                                       matrix->yy, matrix->xy );
+    __m256i  d    = _mm256_set_epi64x( delta->y - FT_SIMD_BIAS,
+                                       delta->x - FT_SIMD_BIAS,
+                                       delta->y - FT_SIMD_BIAS,
+                                       delta->x - FT_SIMD_BIAS );
+    __m256i  half = _mm256_set1_epi64x( 0x8000 + ( (FT_Pos)1 << 47 ) );
+    __m256i  sx   = _mm256_srai_epi32( mx, 31 );
+    __m256i  sy   = _mm256_srai_epi32( my, 31 );
+
+
+    /* `_mm256_srai_epi32' gives the signs of the 64-bit lanes since */
+    /* bit 31 is a sign bit for all values that fit into 32 bits     */
+    sx = _mm256_shuffle_epi32( sx, _MM_SHUFFLE( 2, 2, 0, 0 ) );
+    sy = _mm256_shuffle_epi32( sy, _MM_SHUFFLE( 2, 2, 0, 0 ) );
+
+    for ( ; count >= 2; count -= 2, vec += 2 )
+    {
+      __m256i  p, x, y, a, b;
+
+
+      p = _mm256_loadu_si256( (__m256i*)vec );
+      x = _mm256_unpacklo_epi64( p, p );
+      y = _mm256_unpackhi_epi64( p, p );
+
+      /* (x0 * xx, x0 * yx, x1 * xx, x1 * yx) */
+      a = _mm256_mul_epi32( x, mx );
+      /* (y0 * xy, y0 * yy, y1 * xy, y1 * yy) */
+      b = _mm256_mul_epi32( y, my );
+
+      a = _mm256_add_epi64( _mm256_add_epi64( a, half ),
+                            _mm256_xor_si256( _mm256_srai_epi32( x, 31 ),
+                                              sx ) );
+      b = _mm256_add_epi64( _mm256_add_epi64( b, half ),
+                            _mm256_xor_si256( _mm256_srai_epi32( y, 31 ),
+                                              sy ) );
+
+      p = _mm256_add_epi64( _mm256_srli_epi64( a, 16 ),
+                            _mm256_srli_epi64( b, 16 ) );
+
+      _mm256_storeu_si256( (__m256i*)vec, _mm256_add_epi64( p, d ) );
+    }
+
+    if ( count )
+    {
+      FT_Vector_Transform( vec, matrix );
+      vec->x += delta->x;
+      vec->y += delta->y;
+    }
+  }
+
+#endif /* FT_SIMD_X86_64 */
+
+
+#ifdef FT_SIMD_ARM64
+
+  static void
+  ft_vector_array_translate_neon( FT_Vector*        vec,
+                                  FT_Int            count,
+                                  const FT_Vector*  delta )
+  {
+    int64x2_t  d = vcombine_s64( vcreate_s64( (uint64_t)delta->x ),
+                                 vcreate_s64( (uint64_t)delta->y ) );
+
+
+    for ( ; count > 0; count--, vec++ )
+      vst1q_s64( (int64_t*)vec, vaddq_s64( vld1q_s64( (int64_t*)vec ), d ) );
+  }
+
+
+  static void
+  ft_vector_array_get_cbox_neon( const FT_Vector*  vec,
+                                 FT_Int            count,
+                                 FT_BBox          *acbox )
+  {
+    int64x2_t  vmin, vmax, p;
+
+
+    vmin = vld1q_s64( (const int64_t*)vec );
+    vmax = vmin;
+
+    for ( vec++, count--; count > 0; count--, vec++ )
+    {
+      p    = vld1q_s64( (const int64_t*)vec );
+      vmin = vbslq_s64( vcgtq_s64( vmin, p ), p, vmin );
+      vmax = vbslq_s64( vcgtq_s64( p, vmax ), p, vmax );
+    }
+
+    acbox->xMin = (FT_Pos)vgetq_lane_s64( vmin, 0 );
+    acbox->yMin = (FT_Pos)vgetq_lane_s64( vmin, 1 );
+    acbox->xMax = (FT_Pos)vgetq_lane_s64( vmax, 0 );
+    acbox->yMax = (FT_Pos)vgetq_lane_s64( vmax, 1 );
+  }
+
+
+  /* return TRUE if all coordinates are within the given limits */
+
+  static FT_Bool
+  ft_vector_array_check_neon( const FT_Vector*  vec,
+                              FT_Int            count,
+                              FT_Pos            xlimit,
+                              FT_Pos            ylimit )
+  {
+    int64x2_t   hi  = vcombine_s64( vcreate_s64( (uint64_t)xlimit ),
+                                    vcreate_s64( (uint64_t)ylimit ) );
+    int64x2_t   lo  = vnegq_s64( hi );
+    uint64x2_t  out = vdupq_n_u64( 0 );
+    int64x2_t   p;
+
+
+    for ( ; count > 0; count--, vec++ )
+    {
+      p   = vld1q_s64( (const int64_t*)vec );
+      out = vorrq_u64( out, vorrq_u64( vcgtq_s64( p, hi ),
+                                       vcltq_s64( p, lo ) ) );
+    }
+
+    return FT_BOOL( ( vgetq_lane_u64( out, 0 ) |
+                      vgetq_lane_u64( out, 1 ) ) == 0 );
+  }
+
+
+  /* The coordinates must be checked with `ft_vector_array_check_neon'. */
+  /* NEON has 64-bit arithmetic shifts, so we don't need the bias.      */
+
+  static void
+  ft_vector_array_transform_neon( FT_Vector*        vec,
+                                  FT_Int            count,
+                                  const FT_Matrix*  matrix,
+                                  const FT_Vector*  delta )
+  {
+    int32x2_t  mx   = vcreate_s32( (FT_UInt32)matrix->xx            |
+                                   (uint64_t)(FT_UInt32)matrix->yx << 32 );
+    int32x2_t  my   = vcreate_s32( (FT_UInt32)matrix->xy            |
+                                   (uint64_t)(FT_UInt32)matrix->yy << 32 );
+    int64x2_t  d    = vcombine_s64( vcreate_s64( (uint64_t)delta->x ),
+                                    vcreate_s64( (uint64_t)delta->y ) );
+    int64x2_t  half = vdupq_n_s64( 0x8000 );
+
+
+    for ( ; count > 0; count--, vec++ )
+    {
+      int32x2_t  p;
+      int64x2_t  a, b;
+
+
+      p = vmovn_s64( vld1q_s64( (int64_t*)vec ) );
+
+      /* (x * xx, x * yx) and (y * xy, y * yy) */
+      a = vmull_lane_s32( mx, p, 0 );
+      b = vmull_lane_s32( my, p, 1 );
+
+      /* add 0x8000, or 0x7FFF for negative products */
+      a = vshrq_n_s64( vaddq_s64( vaddq_s64( a, half ),
+                                  vshrq_n_s64( a, 63 ) ), 16 );
+      b = vshrq_n_s64( vaddq_s64( vaddq_s64( b, half ),
+                                  vshrq_n_s64( b, 63 ) ), 16 );
+
+      vst1q_s64( (int64_t*)vec, vaddq_s64( vaddq_s64( a, b ), d ) );
+    }
+  }
+
+#endif /* FT_SIMD_ARM64 */
+
+#endif /* FT_SIMD_VECTORS */
+
+
+  /* documentation is in ftsimd.h */
+
+  FT_BASE_DEF( void )
+  ft_vector_array_transform( FT_Vector*        vectors,
+                             FT_Int            count,
+                             const FT_Matrix*  matrix,
+                             const FT_Vector*  delta )
+  {
+    FT_Vector*  vec;
+    FT_Vector*  limit;
+    FT_Vector   zero;
+
+
+    if ( count <= 0 || ( !matrix && !delta ) )
+      return;
+
+    if ( !delta )
+    {
+      zero.x = 0;
+      zero.y = 0;
+      delta  = &zero;
+    }
+
+#ifdef FT_SIMD_VECTORS
+    {
+      FT_UInt  features = ft_simd_get_features();
+
+
+#ifdef FT_SIMD_X86_64
+      if ( features & FT_SIMD_AVX2 )
+      {
+        if ( !matrix )
+        {
+          ft_vector_array_translate_avx2( vectors, count, delta );
+          return;
+        }
+
+        if ( count >= FT_SIMD_MIN_TRANSFORM                             &&
+             ft_vector_array_check_avx2(
+               vectors, count,
+               ft_simd_transform_limit( matrix->xx, matrix->yx ),
+               ft_simd_transform_limit( matrix->xy, matrix->yy ) ) )
+        {
+          ft_vector_array_transform_avx2( vectors, count, matrix, delta );
+          return;
+        }
+      }
+#endif
+#ifdef FT_SIMD_ARM64
+      FT_UNUSED( features );
+
+      if ( !matrix )
+      {
+        ft_vector_array_translate_neon( vectors, count, delta );
+        return;
+      }
+
+      if ( count >= FT_SIMD_MIN_TRANSFORM                             &&
+           ft_vector_array_check_neon(
+             vectors, count,
+             ft_simd_transform_limit( matrix->xx, matrix->yx ),
+             ft_simd_transform_limit( matrix->xy, matrix->yy ) ) )
+      {
+        ft_vector_array_transform_neon( vectors, count, matrix, delta );
+        return;
+      }
+#endif
+    }
+#endif /* FT_SIMD_VECTORS */
+
+    vec   = vectors;
+    limit = vectors + count;
+
+    if ( matrix )
+    {
+      /* this is `FT_Vector_Transform', inlined */
+      for ( ; vec < limit; vec++ )
+      {
+        FT_Pos  xz, yz;
+
+
+        xz = FT_MulFix( vec->x, matrix->xx ) +
+             FT_MulFix( vec->y, matrix->xy );
+        yz = FT_MulFix( vec->x, matrix->yx ) +
+             FT_MulFix( vec->y, matrix->yy );
+
+        vec->x = xz + delta->x;
+        vec->y = yz + delta->y;
+      }
+    }
+    else
+    {
+      for ( ; vec < limit; vec++ )
+      {
+        vec->x += delta->x;
+        vec->y += delta->y;
+      }
+    }
+  }
+
+
+  /* documentation is in ftsimd.h */
+
+  FT_BASE_DEF( void )
+  ft_vector_array_get_cbox( const FT_Vector*  vectors,
+                            FT_Int            count,
+                            FT_BBox          *acbox )
+  {
+    const FT_Vector*  vec;
+    const FT_Vector*  limit;
+    FT_Pos            xMin, yMin, xMax, yMax;
+
+
+    if ( count <= 0 )
+    {
+      acbox->xMin = 0;
+      acbox->yMin = 0;
+      acbox->xMax = 0;
+      acbox->yMax = 0;
+
+      return;
+    }
+
+#ifdef FT_SIMD_VECTORS
+#ifdef FT_SIMD_X86_64
+    if ( ft_simd_get_features() & FT_SIMD_AVX2 )
+    {
+      ft_vector_array_get_cbox_avx2( vectors, count, acbox );
+      return;
+    }
+#endif
+#ifdef FT_SIMD_ARM64
+    ft_vector_array_get_cbox_neon( vectors, count, acbox );
+    return;
+#endif
+#endif /* FT_SIMD_VECTORS */
+
+    vec   = vectors;
+    limit = vectors + count;
+
+    xMin = xMax = vec->x;
+    yMin = yMax = vec->y;
+    vec++;
+
+    for ( ; vec < limit; vec++ )
+    {
+      FT_Pos  x, y;
+
+
+      x = vec->x;
+      if ( x < xMin ) xMin = x;
+      if ( x > xMax ) xMax = x;
+
+      y = vec->y;
+      if ( y < yMin ) yMin = y;
+      if ( y > yMax ) yMax = y;
+    }
+
+    acbox->xMin = xMin;
+    acbox->xMax = xMax;
+    acbox->yMin = yMin;
+    acbox->yMax = yMax;
+  }
+
+
+/* END */
@@ -19,6 +19,7 @@
 #include <ft2build.h>
 #include FT_INTERNAL_STREAM_H
 #include FT_INTERNAL_DEBUG_H
+#include FT_INTERNAL_OBJECTS_H    /* for FT_GLOBAL_COUNTER_ADD */
 
 
   /*************************************************************************/
@@ -147,6 +148,8 @@
 
     stream->pos = pos + read_bytes;
 
+    FT_GLOBAL_COUNTER_ADD( FT_COUNTER_STREAM_BYTES, read_bytes );
+
     if ( read_bytes < count )
     {
       FT_ERROR(( "FT_Stream_ReadAt:"
@@ -184,6 +187,8 @@
 
     stream->pos += read_bytes;
 
+    FT_GLOBAL_COUNTER_ADD( FT_COUNTER_STREAM_BYTES, read_bytes );
+
   Exit:
     return read_bytes;
   }
@@ -282,6 +287,8 @@
       stream->cursor = stream->base;
       stream->limit  = stream->cursor + count;
       stream->pos   += read_bytes;
+
+      FT_GLOBAL_COUNTER_ADD( FT_COUNTER_STREAM_BYTES, read_bytes );
     }
     else
     {
@@ -301,6 +308,8 @@
       stream->cursor = stream->base + stream->pos;
       stream->limit  = stream->cursor + count;
       stream->pos   += count;
+
+      FT_GLOBAL_COUNTER_ADD( FT_COUNTER_STREAM_BYTES, count );
     }
 
   Exit:
@@ -99,9 +99,10 @@
                             FT_Angle   *angle_in,
                             FT_Angle   *angle_out )
   {
-    FT_Vector  d1, d2;
-    FT_Angle   theta;
+    FT_Vector  d1, d2, d[2];
+    FT_Angle   theta, a[2], a1 = 0, a2 = 0;
     FT_Int     close1, close2;
+    FT_UInt    n;
 
 
     d1.x = base[1].x - base[2].x;
@@ -112,6 +113,21 @@
     close1 = FT_IS_SMALL( d1.x ) && FT_IS_SMALL( d1.y );
     close2 = FT_IS_SMALL( d2.x ) && FT_IS_SMALL( d2.y );
 
+    /* compute the needed directions in a single call */
+    n = 0;
+    if ( !close1 )
+      d[n++] = d1;
+    if ( !close2 )
+      d[n++] = d2;
+
+    FT_Vector_Polarize_Array( d, n, NULL, a );
+
+    n = 0;
+    if ( !close1 )
+      a1 = a[n++];
+    if ( !close2 )
+      a2 = a[n++];
+
     if ( close1 )
     {
       if ( close2 )
@@ -122,7 +138,7 @@
       else
       {
         *angle_in  =
-        *angle_out = FT_Atan2( d2.x, d2.y );
+        *angle_out = a2;
       }
     }
     else /* !close1 */
@@ -130,12 +146,12 @@
       if ( close2 )
       {
         *angle_in  =
-        *angle_out = FT_Atan2( d1.x, d1.y );
+        *angle_out = a1;
       }
       else
       {
-        *angle_in  = FT_Atan2( d1.x, d1.y );
-        *angle_out = FT_Atan2( d2.x, d2.y );
+        *angle_in  = a1;
+        *angle_out = a2;
       }
     }
 
@@ -190,9 +206,10 @@
                             FT_Angle   *angle_mid,
                             FT_Angle   *angle_out )
   {
-    FT_Vector  d1, d2, d3;
-    FT_Angle   theta1, theta2;
+    FT_Vector  d1, d2, d3, d[3];
+    FT_Angle   theta1, theta2, a[3], a1 = 0, a2 = 0, a3 = 0;
     FT_Int     close1, close2, close3;
+    FT_UInt    n;
 
 
     d1.x = base[2].x - base[3].x;
@@ -206,6 +223,25 @@
     close2 = FT_IS_SMALL( d2.x ) && FT_IS_SMALL( d2.y );
     close3 = FT_IS_SMALL( d3.x ) && FT_IS_SMALL( d3.y );
 
+    /* compute the needed directions in a single call */
+    n = 0;
+    if ( !close1 )
+      d[n++] = d1;
+    if ( !close2 )
+      d[n++] = d2;
+    if ( !close3 )
+      d[n++] = d3;
+
+    FT_Vector_Polarize_Array( d, n, NULL, a );
+
+    n = 0;
+    if ( !close1 )
+      a1 = a[n++];
+    if ( !close2 )
+      a2 = a[n++];
+    if ( !close3 )
+      a3 = a[n++];
+
     if ( close1 )
     {
       if ( close2 )
@@ -219,7 +255,7 @@
         {
           *angle_in  =
           *angle_mid =
-          *angle_out = FT_Atan2( d3.x, d3.y );
+          *angle_out = a3;
         }
       }
       else /* !close2 */
@@ -228,13 +264,13 @@
         {
           *angle_in  =
           *angle_mid =
-          *angle_out = FT_Atan2( d2.x, d2.y );
+          *angle_out = a2;
         }
         else /* !close3 */
         {
           *angle_in  =
-          *angle_mid = FT_Atan2( d2.x, d2.y );
-          *angle_out = FT_Atan2( d3.x, d3.y );
+          *angle_mid = a2;
+          *angle_out = a3;
         }
       }
     }
@@ -246,12 +282,12 @@
         {
           *angle_in  =
           *angle_mid =
-          *angle_out = FT_Atan2( d1.x, d1.y );
+          *angle_out = a1;
         }
         else /* !close3 */
         {
-          *angle_in  = FT_Atan2( d1.x, d1.y );
-          *angle_out = FT_Atan2( d3.x, d3.y );
+          *angle_in  = a1;
+          *angle_out = a3;
           *angle_mid = ft_angle_mean( *angle_in, *angle_out );
         }
       }
@@ -259,15 +295,15 @@
       {
         if ( close3 )
         {
-          *angle_in  = FT_Atan2( d1.x, d1.y );
+          *angle_in  = a1;
           *angle_mid =
-          *angle_out = FT_Atan2( d2.x, d2.y );
+          *angle_out = a2;
         }
         else /* !close3 */
         {
-          *angle_in  = FT_Atan2( d1.x, d1.y );
-          *angle_mid = FT_Atan2( d2.x, d2.y );
-          *angle_out = FT_Atan2( d3.x, d3.y );
+          *angle_in  = a1;
+          *angle_mid = a2;
+          *angle_out = a3;
         }
       }
     }
@@ -528,9 +564,11 @@
                           FT_Angle         angle_start,
                           FT_Angle         angle_diff )
   {
-    FT_Angle   total, angle, step, rotate, next, theta;
+    FT_Angle   total, angle, step, rotate, next, theta, last_theta = 0;
     FT_Vector  a, b, a2, b2;
-    FT_Fixed   length;
+    FT_Vector  points[3];
+    FT_Fixed   lengths[3], length = 0;
+    FT_Angle   angles[3];
     FT_Error   error = FT_Err_Ok;
 
 
@@ -559,22 +597,33 @@
 
       theta >>= 1;
 
-      /* compute end point */
-      FT_Vector_From_Polar( &b, radius, next );
-      b.x += center->x;
-      b.y += center->y;
+      /* all steps but the last one usually have the same angle */
+      if ( theta != last_theta )
+      {
+        length = FT_MulDiv( radius, FT_Sin( theta ) * 4,
+                            ( 0x10000L + FT_Cos( theta ) ) * 3 );
 
-      /* compute first and second control points */
-      length = FT_MulDiv( radius, FT_Sin( theta ) * 4,
-                          ( 0x10000L + FT_Cos( theta ) ) * 3 );
+        last_theta = theta;
+      }
 
-      FT_Vector_From_Polar( &a2, length, angle + rotate );
-      a2.x += a.x;
-      a2.y += a.y;
+      /* compute end point and first and second control points */
+      lengths[0] = radius;
+      angles[0]  = next;
+      lengths[1] = length;
+      angles[1]  = angle + rotate;
+      lengths[2] = length;
+      angles[2]  = next - rotate;
 
-      FT_Vector_From_Polar( &b2, length, next - rotate );
-      b2.x += b.x;
-      b2.y += b.y;
+      FT_Vector_From_Polar_Array( points, 3, lengths, angles );
+
+      b.x = points[0].x + center->x;
+      b.y = points[0].y + center->y;
+
+      a2.x = points[1].x + a.x;
+      a2.y = points[1].y + a.y;
+
+      b2.x = points[2].x + b.x;
+      b2.y = points[2].y + b.y;
 
       /* add cubic arc */
       error = ft_stroke_border_cubicto( border, &a2, &b2, &b );
@@ -924,52 +973,62 @@
     else if ( stroker->line_cap == FT_STROKER_LINECAP_SQUARE )
     {
       /* add a square cap */
-      FT_Vector        delta, delta2;
+      FT_Vector        delta, d[3];
       FT_Angle         rotate = FT_SIDE_TO_ROTATE( side );
       FT_Fixed         radius = stroker->radius;
       FT_StrokeBorder  border = stroker->borders + side;
+      FT_Fixed         lengths[3];
+      FT_Angle         angles[3];
 
 
-      FT_Vector_From_Polar( &delta2, radius, angle + rotate );
-      FT_Vector_From_Polar( &delta,  radius, angle );
+      lengths[0] = radius;
+      angles[0]  = angle + rotate;
+      lengths[1] = radius;
+      angles[1]  = angle;
+      lengths[2] = radius;
+      angles[2]  = angle - rotate;
 
-      delta.x += stroker->center.x + delta2.x;
-      delta.y += stroker->center.y + delta2.y;
+      FT_Vector_From_Polar_Array( d, 3, lengths, angles );
+
+      delta.x = d[1].x + stroker->center.x + d[0].x;
+      delta.y = d[1].y + stroker->center.y + d[0].y;
 
       error = ft_stroke_border_lineto( border, &delta, FALSE );
       if ( error )
         goto Exit;
 
-      FT_Vector_From_Polar( &delta2, radius, angle - rotate );
-      FT_Vector_From_Polar( &delta,  radius, angle );
-
-      delta.x += delta2.x + stroker->center.x;
-      delta.y += delta2.y + stroker->center.y;
+      delta.x = d[1].x + d[2].x + stroker->center.x;
+      delta.y = d[1].y + d[2].y + stroker->center.y;
 
       error = ft_stroke_border_lineto( border, &delta, FALSE );
     }
     else if ( stroker->line_cap == FT_STROKER_LINECAP_BUTT )
     {
       /* add a butt ending */
-      FT_Vector        delta;
+      FT_Vector        delta, d[2];
       FT_Angle         rotate = FT_SIDE_TO_ROTATE( side );
       FT_Fixed         radius = stroker->radius;
       FT_StrokeBorder  border = stroker->borders + side;
+      FT_Fixed         lengths[2];
+      FT_Angle         angles[2];
 
 
-      FT_Vector_From_Polar( &delta, radius, angle + rotate );
+      lengths[0] = radius;
+      angles[0]  = angle + rotate;
+      lengths[1] = radius;
+      angles[1]  = angle - rotate;
 
-      delta.x += stroker->center.x;
-      delta.y += stroker->center.y;
+      FT_Vector_From_Polar_Array( d, 2, lengths, angles );
+
+      delta.x = d[0].x + stroker->center.x;
+      delta.y = d[0].y + stroker->center.y;
 
       error = ft_stroke_border_lineto( border, &delta, FALSE );
       if ( error )
         goto Exit;
 
-      FT_Vector_From_Polar( &delta, radius, angle - rotate );
-
-      delta.x += stroker->center.x;
-      delta.y += stroker->center.y;
+      delta.x = d[1].x + stroker->center.x;
+      delta.y = d[1].y + stroker->center.y;
 
       error = ft_stroke_border_lineto( border, &delta, FALSE );
     }
@@ -1121,48 +1180,53 @@
         else /* variable bevel */
         {
           /* the miter is truncated */
-          FT_Vector  middle, delta;
-          FT_Fixed   length;
+          FT_Vector  middle, delta, d[4];
+          FT_Fixed   length, lengths[4];
+          FT_Angle   angles[4];
 
 
-          /* compute middle point */
-          FT_Vector_From_Polar( &middle,
-                                FT_MulFix( radius, stroker->miter_limit ),
-                                phi );
-          middle.x += stroker->center.x;
-          middle.y += stroker->center.y;
-
-          /* compute first angle point */
           length = FT_MulDiv( radius, 0x10000L - sigma,
                               ft_pos_abs( FT_Sin( theta ) ) );
 
-          FT_Vector_From_Polar( &delta, length, phi + rotate );
-          delta.x += middle.x;
-          delta.y += middle.y;
+          /* compute middle point, the two angle points relative to it, */
+          /* and the end point (only needed if not lineto; line_length  */
+          /* is zero for curves) at once                                */
+          lengths[0] = FT_MulFix( radius, stroker->miter_limit );
+          angles[0]  = phi;
+          lengths[1] = length;
+          angles[1]  = phi + rotate;
+          lengths[2] = length;
+          angles[2]  = phi - rotate;
+          lengths[3] = radius;
+          angles[3]  = stroker->angle_out + rotate;
+
+          FT_Vector_From_Polar_Array( d, line_length == 0 ? 4 : 3,
+                                      lengths, angles );
+
+          middle.x = d[0].x + stroker->center.x;
+          middle.y = d[0].y + stroker->center.y;
+
+          /* add first angle point */
+          delta.x = d[1].x + middle.x;
+          delta.y = d[1].y + middle.y;
 
           error = ft_stroke_border_lineto( border, &delta, FALSE );
           if ( error )
             goto Exit;
 
-          /* compute second angle point */
-          FT_Vector_From_Polar( &delta, length, phi - rotate );
-          delta.x += middle.x;
-          delta.y += middle.y;
+          /* add second angle point */
+          delta.x = d[2].x + middle.x;
+          delta.y = d[2].y + middle.y;
 
           error = ft_stroke_border_lineto( border, &delta, FALSE );
           if ( error )
             goto Exit;
 
-          /* finally, add an end point; only needed if not lineto */
-          /* (line_length is zero for curves)                     */
+          /* finally, add the end point */
           if ( line_length == 0 )
           {
-            FT_Vector_From_Polar( &delta,
-                                  radius,
-                                  stroker->angle_out + rotate );
-
-            delta.x += stroker->center.x;
-            delta.y += stroker->center.y;
+            delta.x = d[3].x + stroker->center.x;
+            delta.y = d[3].y + stroker->center.y;
 
             error = ft_stroke_border_lineto( border, &delta, FALSE );
           }
@@ -1170,29 +1234,33 @@
       }
       else /* this is a miter (intersection) */
       {
-        FT_Fixed   length;
-        FT_Vector  delta;
+        FT_Fixed   lengths[2];
+        FT_Angle   angles[2];
+        FT_Vector  delta, d[2];
 
 
-        length = FT_DivFix( stroker->radius, thcos );
+        /* compute the miter point and the end point (only needed if */
+        /* not lineto; line_length is zero for curves) at once       */
+        lengths[0] = FT_DivFix( stroker->radius, thcos );
+        angles[0]  = phi;
+        lengths[1] = stroker->radius;
+        angles[1]  = stroker->angle_out + rotate;
 
-        FT_Vector_From_Polar( &delta, length, phi );
-        delta.x += stroker->center.x;
-        delta.y += stroker->center.y;
+        FT_Vector_From_Polar_Array( d, line_length == 0 ? 2 : 1,
+                                    lengths, angles );
+
+        delta.x = d[0].x + stroker->center.x;
+        delta.y = d[0].y + stroker->center.y;
 
         error = ft_stroke_border_lineto( border, &delta, FALSE );
         if ( error )
           goto Exit;
 
-        /* now add an end point; only needed if not lineto */
-        /* (line_length is zero for curves)                */
+        /* now add the end point */
         if ( line_length == 0 )
         {
-          FT_Vector_From_Polar( &delta,
-                                stroker->radius,
-                                stroker->angle_out + rotate );
-          delta.x += stroker->center.x;
-          delta.y += stroker->center.y;
+          delta.x = d[1].x + stroker->center.x;
+          delta.y = d[1].y + stroker->center.y;
 
           error = ft_stroke_border_lineto( border, &delta, FALSE );
         }
@@ -1304,10 +1372,9 @@
     if ( delta.x == 0 && delta.y == 0 )
        goto Exit;
 
-    /* compute length of line */
-    line_length = FT_Vector_Length( &delta );
+    /* compute length and direction of line */
+    FT_Vector_Polarize_Array( &delta, 1, &line_length, &angle );
 
-    angle = FT_Atan2( delta.x, delta.y );
     FT_Vector_From_Polar( &delta, stroker->radius, angle + FT_ANGLE_PI2 );
 
     /* process corner if necessary */
@@ -1445,9 +1512,9 @@
       /* the arc's angle is small enough; we can add it directly to each */
       /* border                                                          */
       {
-        FT_Vector        ctrl, end;
-        FT_Angle         theta, phi, rotate, alpha0 = 0;
-        FT_Fixed         length;
+        FT_Vector        ctrl, end, d[4];
+        FT_Angle         theta, phi, rotate, alpha0 = 0, angles[4];
+        FT_Fixed         length, lengths[4];
         FT_StrokeBorder  border;
         FT_Int           side;
 
@@ -1460,21 +1527,30 @@
         if ( stroker->handle_wide_strokes )
           alpha0 = FT_Atan2( arc[0].x - arc[2].x, arc[0].y - arc[2].y );
 
+        /* compute control and end point offsets of both sides at once */
+        for ( side = 0; side <= 1; side++ )
+        {
+          rotate = FT_SIDE_TO_ROTATE( side );
+
+          lengths[2 * side]     = length;
+          angles[2 * side]      = phi + rotate;
+          lengths[2 * side + 1] = stroker->radius;
+          angles[2 * side + 1]  = angle_out + rotate;
+        }
+
+        FT_Vector_From_Polar_Array( d, 4, lengths, angles );
+
         for ( border = stroker->borders, side = 0;
               side <= 1;
               side++, border++ )
         {
-          rotate = FT_SIDE_TO_ROTATE( side );
-
           /* compute control point */
-          FT_Vector_From_Polar( &ctrl, length, phi + rotate );
-          ctrl.x += arc[1].x;
-          ctrl.y += arc[1].y;
+          ctrl.x = d[2 * side].x + arc[1].x;
+          ctrl.y = d[2 * side].y + arc[1].y;
 
           /* compute end point */
-          FT_Vector_From_Polar( &end, stroker->radius, angle_out + rotate );
-          end.x += arc[0].x;
-          end.y += arc[0].y;
+          end.x = d[2 * side + 1].x + arc[0].x;
+          end.y = d[2 * side + 1].y + arc[0].y;
 
           if ( stroker->handle_wide_strokes )
           {
@@ -1651,9 +1727,10 @@
       /* the arc's angle is small enough; we can add it directly to each */
       /* border                                                          */
       {
-        FT_Vector        ctrl1, ctrl2, end;
+        FT_Vector        ctrl1, ctrl2, end, d[6];
         FT_Angle         theta1, phi1, theta2, phi2, rotate, alpha0 = 0;
-        FT_Fixed         length1, length2;
+        FT_Angle         angles[6];
+        FT_Fixed         length1, length2, lengths[6];
         FT_StrokeBorder  border;
         FT_Int           side;
 
@@ -1669,25 +1746,35 @@
         if ( stroker->handle_wide_strokes )
           alpha0 = FT_Atan2( arc[0].x - arc[3].x, arc[0].y - arc[3].y );
 
+        /* compute control and end point offsets of both sides at once */
+        for ( side = 0; side <= 1; side++ )
+        {
+          rotate = FT_SIDE_TO_ROTATE( side );
+
+          lengths[3 * side]     = length1;
+          angles[3 * side]      = phi1 + rotate;
+          lengths[3 * side + 1] = length2;
+          angles[3 * side + 1]  = phi2 + rotate;
+          lengths[3 * side + 2] = stroker->radius;
+          angles[3 * side + 2]  = angle_out + rotate;
+        }
+
+        FT_Vector_From_Polar_Array( d, 6, lengths, angles );
+
         for ( border = stroker->borders, side = 0;
               side <= 1;
               side++, border++ )
         {
-          rotate = FT_SIDE_TO_ROTATE( side );
-
           /* compute control points */
-          FT_Vector_From_Polar( &ctrl1, length1, phi1 + rotate );
-          ctrl1.x += arc[2].x;
-          ctrl1.y += arc[2].y;
+          ctrl1.x = d[3 * side].x + arc[2].x;
+          ctrl1.y = d[3 * side].y + arc[2].y;
 
-          FT_Vector_From_Polar( &ctrl2, length2, phi2 + rotate );
-          ctrl2.x += arc[1].x;
-          ctrl2.y += arc[1].y;
+          ctrl2.x = d[3 * side + 1].x + arc[1].x;
+          ctrl2.y = d[3 * side + 1].y + arc[1].y;
 
           /* compute end point */
-          FT_Vector_From_Polar( &end, stroker->radius, angle_out + rotate );
-          end.x += arc[0].x;
-          end.y += arc[0].y;
+          end.x = d[3 * side + 2].x + arc[0].x;
+          end.y = d[3 * side + 2].y + arc[0].y;
 
           if ( stroker->handle_wide_strokes )
           {
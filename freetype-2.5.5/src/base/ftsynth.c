@@ -22,6 +22,7 @@
 #include FT_INTERNAL_OBJECTS_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
+#include FT_INTERNAL_CALC_H
 
 
   /*************************************************************************/
@@ -34,6 +35,15 @@
 #define FT_COMPONENT  trace_synth
 
 
+  /* the horizontal shear of an obliqued glyph, about 12 degrees */
+#define FT_SYNTH_SLANT  0x0366AL
+
+  /* some reasonable emboldening strength */
+#define FT_SYNTH_STRENGTH( face )                             \
+          ( FT_MulFix( (face)->units_per_EM,                  \
+                       (face)->size->metrics.y_scale ) / 24 )
+
+
   /*************************************************************************/
   /*************************************************************************/
   /****                                                                 ****/
@@ -68,7 +78,7 @@
     transform.xx = 0x10000L;
     transform.yx = 0x00000L;
 
-    transform.xy = 0x0366AL;
+    transform.xy = FT_SYNTH_SLANT;
     transform.yy = 0x10000L;
 
     FT_Outline_Transform( outline, &transform );
@@ -84,6 +94,25 @@
   /*************************************************************************/
 
 
+  static void
+  ft_synth_embolden_metrics( FT_GlyphSlot  slot,
+                             FT_Pos        xstr,
+                             FT_Pos        ystr )
+  {
+    if ( slot->advance.x )
+      slot->advance.x += xstr;
+
+    if ( slot->advance.y )
+      slot->advance.y += ystr;
+
+    slot->metrics.width        += xstr;
+    slot->metrics.height       += ystr;
+    slot->metrics.horiAdvance  += xstr;
+    slot->metrics.vertAdvance  += ystr;
+    slot->metrics.horiBearingY += ystr;
+  }
+
+
   /* documentation is in ftsynth.h */
 
   FT_EXPORT_DEF( void )
@@ -105,9 +134,7 @@
          slot->format != FT_GLYPH_FORMAT_BITMAP  )
       return;
 
-    /* some reasonable strength */
-    xstr = FT_MulFix( face->units_per_EM,
-                      face->size->metrics.y_scale ) / 24;
+    xstr = FT_SYNTH_STRENGTH( face );
     ystr = xstr;
 
     if ( slot->format == FT_GLYPH_FORMAT_OUTLINE )
@@ -142,17 +169,7 @@
         return;
     }
 
-    if ( slot->advance.x )
-      slot->advance.x += xstr;
-
-    if ( slot->advance.y )
-      slot->advance.y += ystr;
-
-    slot->metrics.width        += xstr;
-    slot->metrics.height       += ystr;
-    slot->metrics.horiAdvance  += xstr;
-    slot->metrics.vertAdvance  += ystr;
-    slot->metrics.horiBearingY += ystr;
+    ft_synth_embolden_metrics( slot, xstr, ystr );
 
     /* XXX: 16-bit overflow case must be excluded before here */
     if ( slot->format == FT_GLYPH_FORMAT_BITMAP )
@@ -160,4 +177,183 @@
   }
 
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /****                                                                 ****/
+  /****   COMBINED SYNTHESIS                                            ****/
+  /****                                                                 ****/
+  /*************************************************************************/
+  /*************************************************************************/
+
+
+  /* return the orientation of the slot's outline, computing it only */
+  /* once per loaded glyph                                           */
+  static FT_Int
+  ft_synth_get_orientation( FT_GlyphSlot  slot )
+  {
+    FT_Slot_Internal  internal = slot->internal;
+
+
+    if ( !( internal->flags & FT_GLYPH_HAS_ORIENTATION ) )
+    {
+      internal->orientation = FT_Outline_Get_Orientation( &slot->outline );
+      internal->flags      |= FT_GLYPH_HAS_ORIENTATION;
+    }
+
+    return internal->orientation;
+  }
+
+
+  /* documentation is in ftsynth.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_GlyphSlot_Synthesize( FT_GlyphSlot      slot,
+                           FT_UInt           flags,
+                           const FT_Matrix*  matrix,
+                           const FT_Vector*  delta )
+  {
+    FT_Error  error = FT_Err_Ok;
+
+
+    if ( !slot )
+      return FT_THROW( Invalid_Slot_Handle );
+
+    if ( slot->format == FT_GLYPH_FORMAT_OUTLINE )
+    {
+      FT_Slot_Internal  internal    = slot->internal;
+      FT_Pos            strength    = 0;
+      FT_Int            orientation = FT_ORIENTATION_NONE;
+      FT_Fixed          slant       = 0;
+
+
+      if ( flags & FT_SYNTHESIS_EMBOLDEN )
+      {
+        strength    = FT_SYNTH_STRENGTH( slot->face );
+        orientation = ft_synth_get_orientation( slot );
+
+        /* like `FT_GlyphSlot_Embolden', we silently ignore */
+        /* outlines we can't embolden                      */
+        if ( orientation == FT_ORIENTATION_NONE && slot->outline.n_contours )
+          FT_TRACE1(( "FT_GlyphSlot_Synthesize:"
+                      " can't embolden outline without orientation\n" ));
+      }
+
+      if ( flags & FT_SYNTHESIS_OBLIQUE )
+        slant = FT_SYNTH_SLANT;
+
+      error = ft_outline_synthesize( &slot->outline,
+                                     strength, strength,
+                                     orientation,
+                                     slant, matrix, delta );
+      if ( error )
+        return error;
+
+      if ( flags & FT_SYNTHESIS_EMBOLDEN )
+        ft_synth_embolden_metrics( slot, strength, strength );
+
+      /* a mirroring matrix reverses the orientation */
+      if ( matrix && ( internal->flags & FT_GLYPH_HAS_ORIENTATION ) )
+      {
+        FT_Int  det = ft_corner_orientation( matrix->xx, matrix->yx,
+                                             matrix->xy, matrix->yy );
+
+
+        if ( det == 0 )
+          internal->flags &= ~FT_GLYPH_HAS_ORIENTATION;
+        else if ( det < 0                                        &&
+                  internal->orientation != FT_ORIENTATION_NONE )
+          internal->orientation =
+            internal->orientation == FT_ORIENTATION_TRUETYPE
+              ? FT_ORIENTATION_POSTSCRIPT
+              : FT_ORIENTATION_TRUETYPE;
+      }
+    }
+    else if ( slot->format == FT_GLYPH_FORMAT_BITMAP )
+    {
+      if ( flags & FT_SYNTHESIS_EMBOLDEN )
+        FT_GlyphSlot_Embolden( slot );
+    }
+
+    if ( matrix )
+      FT_Vector_Transform( &slot->advance, matrix );
+
+    return error;
+  }
+
+
+  /* documentation is in ftsynth.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Load_Glyph_Synthesized( FT_Face   face,
+                             FT_UInt   glyph_index,
+                             FT_Int32  load_flags,
+                             FT_UInt   synthesis_flags )
+  {
+    FT_Error          error;
+    FT_Face_Internal  internal;
+    FT_GlyphSlot      slot;
+    FT_Int            transform_flags;
+
+
+    if ( !face || !face->size || !face->glyph )
+      return FT_THROW( Invalid_Face_Handle );
+
+    internal = face->internal;
+    slot     = face->glyph;
+
+    /* the same flag dependencies as in `FT_Load_Glyph' */
+    if ( load_flags & FT_LOAD_NO_RECURSE )
+      load_flags |= FT_LOAD_NO_SCALE         |
+                    FT_LOAD_IGNORE_TRANSFORM;
+
+    if ( load_flags & FT_LOAD_NO_SCALE )
+      load_flags &= ~FT_LOAD_RENDER;
+
+    /* load the glyph untransformed; as with the auto-hinter, we */
+    /* only hide the transformation flags so that the hinting    */
+    /* decisions of `FT_Load_Glyph' don't change                 */
+    transform_flags           = internal->transform_flags;
+    internal->transform_flags = 0;
+
+    error = FT_Load_Glyph( face, glyph_index, load_flags & ~FT_LOAD_RENDER );
+
+    internal->transform_flags = transform_flags;
+
+    if ( error )
+      return error;
+
+    if ( load_flags & FT_LOAD_IGNORE_TRANSFORM )
+      transform_flags = 0;
+
+    if ( synthesis_flags || transform_flags )
+    {
+      error = FT_GlyphSlot_Synthesize(
+                slot,
+                synthesis_flags,
+                ( transform_flags & 1 ) ? &internal->transform_matrix
+                                        : NULL,
+                ( transform_flags & 2 ) ? &internal->transform_delta
+                                        : NULL );
+      if ( error )
+        return error;
+    }
+
+    if ( slot->format != FT_GLYPH_FORMAT_BITMAP    &&
+         slot->format != FT_GLYPH_FORMAT_COMPOSITE &&
+         load_flags & FT_LOAD_RENDER               )
+    {
+      FT_Render_Mode  mode = FT_LOAD_TARGET_MODE( load_flags );
+
+
+      if ( mode == FT_RENDER_MODE_NORMAL      &&
+           (load_flags & FT_LOAD_MONOCHROME ) )
+        mode = FT_RENDER_MODE_MONO;
+
+      error = FT_Render_Glyph( slot, mode );
+    }
+
+    return error;
+  }
+
+
 /* END */
@@ -33,6 +33,22 @@
 #include FT_INTERNAL_OBJECTS_H
 #include FT_INTERNAL_CALC_H
 #include FT_TRIGONOMETRY_H
+#include FT_INTERNAL_SIMD_H
+
+#ifdef FT_SIMD_X86_64
+#include <emmintrin.h>
+#endif
+
+#ifdef FT_SIMD_ARM64
+#include <arm_neon.h>
+#endif
+
+
+  /* the vector code expects `FT_Fixed' to be a 64-bit type */
+#if ( defined( FT_SIMD_X86_64 ) || defined( FT_SIMD_ARM64 ) ) && \
+    FT_SIZEOF_LONG == ( 64 / FT_CHAR_BIT )
+#define FT_TRIG_VECTORS
+#endif
 
 
   /* the Cordic shrink factor 0.858785336480436 * 2^32 */
@@ -159,19 +175,30 @@
   }
 
 
-  static void
-  ft_trig_pseudo_rotate( FT_Vector*  vec,
+  /* these macros return 0 for positive numbers,
+     and -1 for negative ones */
+#define FT_SIGN_LONG( x )   ( (x) >> ( FT_SIZEOF_LONG * 8 - 1 ) )
+#define FT_SIGN_INT( x )    ( (x) >> ( FT_SIZEOF_INT * 8 - 1 ) )
+#define FT_SIGN_INT32( x )  ( (x) >> 31 )
+#define FT_SIGN_INT16( x )  ( (x) >> 15 )
+
+
+  /* return `x' if mask `m' is 0, and `-x' if it is -1 */
+#define FT_TRIG_APPLY( x, m )  ( ( (x) ^ (m) ) - (m) )
+
+
+  /* rotate `vec' by multiples of PI/2 until the remaining angle,  */
+  /* which gets returned, is inside the [-PI/4,PI/4] sector         */
+  static FT_Angle
+  ft_trig_rotate_sector( FT_Vector*  vec,
                          FT_Angle    theta )
   {
-    FT_Int           i;
-    FT_Fixed         x, y, xtemp, b;
-    const FT_Angle  *arctanptr;
+    FT_Fixed  x, y, xtemp;
 
 
     x = vec->x;
     y = vec->y;
 
-    /* Rotate inside [-PI/4,PI/4] sector */
     while ( theta < -FT_ANGLE_PI4 )
     {
       xtemp  =  y;
@@ -188,25 +215,39 @@
       theta -=  FT_ANGLE_PI2;
     }
 
+    vec->x = x;
+    vec->y = y;
+
+    return theta;
+  }
+
+
+  static void
+  ft_trig_pseudo_rotate( FT_Vector*  vec,
+                         FT_Angle    theta )
+  {
+    FT_Int           i;
+    FT_Fixed         x, y, xtemp, b, m;
+    const FT_Angle  *arctanptr;
+
+
+    /* Rotate inside [-PI/4,PI/4] sector */
+    theta = ft_trig_rotate_sector( vec, theta );
+
+    x = vec->x;
+    y = vec->y;
+
     arctanptr = ft_trig_arctan_table;
 
-    /* Pseudorotations, with right shifts */
+    /* Pseudorotations, with right shifts; the direction of each */
+    /* step is hardly predictable, so apply it with a sign mask  */
     for ( i = 1, b = 1; i < FT_TRIG_MAX_ITERS; b <<= 1, i++ )
     {
-      if ( theta < 0 )
-      {
-        xtemp  = x + ( ( y + b ) >> i );
-        y      = y - ( ( x + b ) >> i );
-        x      = xtemp;
-        theta += *arctanptr++;
-      }
-      else
-      {
-        xtemp  = x - ( ( y + b ) >> i );
-        y      = y + ( ( x + b ) >> i );
-        x      = xtemp;
-        theta -= *arctanptr++;
-      }
+      m      = FT_SIGN_LONG( theta );
+      xtemp  = x - FT_TRIG_APPLY( ( y + b ) >> i, m );
+      y      = y + FT_TRIG_APPLY( ( x + b ) >> i, m );
+      x      = xtemp;
+      theta -= FT_TRIG_APPLY( *arctanptr++, m );
     }
 
     vec->x = x;
@@ -214,19 +255,18 @@
   }
 
 
-  static void
-  ft_trig_pseudo_polarize( FT_Vector*  vec )
+  /* rotate `vec' into the [-PI/4,PI/4] sector and return the angle */
+  /* of this rotation                                               */
+  static FT_Angle
+  ft_trig_polarize_sector( FT_Vector*  vec )
   {
-    FT_Angle         theta;
-    FT_Int           i;
-    FT_Fixed         x, y, xtemp, b;
-    const FT_Angle  *arctanptr;
+    FT_Angle  theta;
+    FT_Fixed  x, y, xtemp;
 
 
     x = vec->x;
     y = vec->y;
 
-    /* Get the vector into [-PI/4,PI/4] sector */
     if ( y > x )
     {
       if ( y > -x )
@@ -258,38 +298,269 @@
       }
     }
 
+    vec->x = x;
+    vec->y = y;
+
+    return theta;
+  }
+
+
+  /* round theta to acknowledge its error that mostly comes */
+  /* from accumulated rounding errors in the arctan table   */
+  static FT_Angle
+  ft_trig_round_angle( FT_Angle  theta )
+  {
+    if ( theta >= 0 )
+      return FT_PAD_ROUND( theta, 16 );
+    else
+      return -FT_PAD_ROUND( -theta, 16 );
+  }
+
+
+  static void
+  ft_trig_pseudo_polarize( FT_Vector*  vec )
+  {
+    FT_Angle         theta;
+    FT_Int           i;
+    FT_Fixed         x, y, xtemp, b, m;
+    const FT_Angle  *arctanptr;
+
+
+    /* Get the vector into [-PI/4,PI/4] sector */
+    theta = ft_trig_polarize_sector( vec );
+
+    x = vec->x;
+    y = vec->y;
+
     arctanptr = ft_trig_arctan_table;
 
-    /* Pseudorotations, with right shifts */
+    /* Pseudorotations, with right shifts (see above) */
     for ( i = 1, b = 1; i < FT_TRIG_MAX_ITERS; b <<= 1, i++ )
     {
-      if ( y > 0 )
-      {
-        xtemp  = x + ( ( y + b ) >> i );
-        y      = y - ( ( x + b ) >> i );
-        x      = xtemp;
-        theta += *arctanptr++;
-      }
-      else
-      {
-        xtemp  = x - ( ( y + b ) >> i );
-        y      = y + ( ( x + b ) >> i );
-        x      = xtemp;
-        theta -= *arctanptr++;
-      }
+      m      = -(FT_Fixed)( y > 0 );
+      xtemp  = x - FT_TRIG_APPLY( ( y + b ) >> i, m );
+      y      = y + FT_TRIG_APPLY( ( x + b ) >> i, m );
+      x      = xtemp;
+      theta -= FT_TRIG_APPLY( *arctanptr++, m );
     }
 
-    /* round theta to acknowledge its error that mostly comes */
-    /* from accumulated rounding errors in the arctan table   */
-    if ( theta >= 0 )
-      theta = FT_PAD_ROUND( theta, 16 );
+    vec->x = x;
+    vec->y = ft_trig_round_angle( theta );
+  }
+
+
+  /* undo `ft_trig_prenorm' for a pseudo-rotated vector */
+  static void
+  ft_trig_postnorm( FT_Vector*  vec,
+                    FT_Int      shift )
+  {
+    FT_Fixed  x, y;
+
+
+    x = ft_trig_downscale( vec->x );
+    y = ft_trig_downscale( vec->y );
+
+    if ( shift > 0 )
+    {
+      FT_Int32  half = (FT_Int32)1L << ( shift - 1 );
+
+
+      vec->x = ( x + half + FT_SIGN_LONG( x ) ) >> shift;
+      vec->y = ( y + half + FT_SIGN_LONG( y ) ) >> shift;
+    }
     else
-      theta = -FT_PAD_ROUND( -theta, 16 );
+    {
+      shift  = -shift;
+      vec->x = (FT_Pos)( (FT_ULong)x << shift );
+      vec->y = (FT_Pos)( (FT_ULong)y << shift );
+    }
+  }
 
-    vec->x = x;
-    vec->y = theta;
+
+  /* compute the length of a pseudo-polarized vector */
+  static FT_Fixed
+  ft_trig_length( FT_Fixed  x,
+                  FT_Int    shift )
+  {
+    x = ft_trig_downscale( x );
+
+    if ( shift > 0 )
+      return ( x + ( 1 << ( shift - 1 ) ) ) >> shift;
+
+    return (FT_Fixed)( (FT_UInt32)x << -shift );
+  }
+
+
+#ifdef FT_TRIG_VECTORS
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The CORDIC iterations of four vectors are also done with SSE2 or NEON */
+  /* instructions, which operate on 32-bit lanes.  After `ft_trig_prenorm' */
+  /* the components of a vector are less than 2^30 in magnitude, and the   */
+  /* iterations scale vectors by less than 1.65.  In `pseudo_rotate' the   */
+  /* vector has a single non-zero component initially, so all values stay  */
+  /* below 2^31.  In `pseudo_polarize' the x component is never negative   */
+  /* but can reach 2^31 (it is thus handled as an unsigned value), while   */
+  /* the y component gets not larger than half of it.  The results are     */
+  /* therefore identical to the scalar code.                               */
+  /*                                                                       */
+  /*************************************************************************/
+
+#ifdef FT_SIMD_X86_64
+
+#define FT_TRIG_APPLY_4( x, m )                         \
+          _mm_sub_epi32( _mm_xor_si128( x, m ), m )
+
+
+  static void
+  ft_trig_pseudo_rotate_4( FT_Int32*  xs,
+                           FT_Int32*  ys,
+                           FT_Int32*  thetas )
+  {
+    __m128i          x, y, theta, dx, dy, m, b, sh, a;
+    FT_Int           i;
+    const FT_Angle  *arctanptr = ft_trig_arctan_table;
+
+
+    x     = _mm_loadu_si128( (const __m128i*)xs );
+    y     = _mm_loadu_si128( (const __m128i*)ys );
+    theta = _mm_loadu_si128( (const __m128i*)thetas );
+
+    for ( i = 1; i < FT_TRIG_MAX_ITERS; i++ )
+    {
+      b  = _mm_set1_epi32( 1 << ( i - 1 ) );
+      sh = _mm_cvtsi32_si128( i );
+      a  = _mm_set1_epi32( (FT_Int32)*arctanptr++ );
+      m  = _mm_srai_epi32( theta, 31 );
+
+      dx    = _mm_sra_epi32( _mm_add_epi32( y, b ), sh );
+      dy    = _mm_sra_epi32( _mm_add_epi32( x, b ), sh );
+      x     = _mm_sub_epi32( x, FT_TRIG_APPLY_4( dx, m ) );
+      y     = _mm_add_epi32( y, FT_TRIG_APPLY_4( dy, m ) );
+      theta = _mm_sub_epi32( theta, FT_TRIG_APPLY_4( a, m ) );
+    }
+
+    _mm_storeu_si128( (__m128i*)xs, x );
+    _mm_storeu_si128( (__m128i*)ys, y );
+  }
+
+
+  /* the x components are returned as unsigned values */
+  static void
+  ft_trig_pseudo_polarize_4( FT_Int32*  xs,
+                             FT_Int32*  ys,
+                             FT_Int32*  thetas )
+  {
+    __m128i          x, y, theta, dx, dy, m, b, sh, a;
+    __m128i          zero = _mm_setzero_si128();
+    FT_Int           i;
+    const FT_Angle  *arctanptr = ft_trig_arctan_table;
+
+
+    x     = _mm_loadu_si128( (const __m128i*)xs );
+    y     = _mm_loadu_si128( (const __m128i*)ys );
+    theta = _mm_loadu_si128( (const __m128i*)thetas );
+
+    for ( i = 1; i < FT_TRIG_MAX_ITERS; i++ )
+    {
+      b  = _mm_set1_epi32( 1 << ( i - 1 ) );
+      sh = _mm_cvtsi32_si128( i );
+      a  = _mm_set1_epi32( (FT_Int32)*arctanptr++ );
+      m  = _mm_cmpgt_epi32( y, zero );
+
+      dx    = _mm_sra_epi32( _mm_add_epi32( y, b ), sh );
+      dy    = _mm_srl_epi32( _mm_add_epi32( x, b ), sh );
+      x     = _mm_sub_epi32( x, FT_TRIG_APPLY_4( dx, m ) );
+      y     = _mm_add_epi32( y, FT_TRIG_APPLY_4( dy, m ) );
+      theta = _mm_sub_epi32( theta, FT_TRIG_APPLY_4( a, m ) );
+    }
+
+    _mm_storeu_si128( (__m128i*)xs, x );
+    _mm_storeu_si128( (__m128i*)thetas, theta );
+  }
+
+#endif /* FT_SIMD_X86_64 */
+
+
+#ifdef FT_SIMD_ARM64
+
+#define FT_TRIG_APPLY_4( x, m )  vsubq_s32( veorq_s32( x, m ), m )
+
+
+  static void
+  ft_trig_pseudo_rotate_4( FT_Int32*  xs,
+                           FT_Int32*  ys,
+                           FT_Int32*  thetas )
+  {
+    int32x4_t        x, y, theta, dx, dy, m, b, sh, a;
+    FT_Int           i;
+    const FT_Angle  *arctanptr = ft_trig_arctan_table;
+
+
+    x     = vld1q_s32( xs );
+    y     = vld1q_s32( ys );
+    theta = vld1q_s32( thetas );
+
+    for ( i = 1; i < FT_TRIG_MAX_ITERS; i++ )
+    {
+      b  = vdupq_n_s32( 1 << ( i - 1 ) );
+      sh = vdupq_n_s32( -i );
+      a  = vdupq_n_s32( (FT_Int32)*arctanptr++ );
+      m  = vshrq_n_s32( theta, 31 );
+
+      dx    = vshlq_s32( vaddq_s32( y, b ), sh );
+      dy    = vshlq_s32( vaddq_s32( x, b ), sh );
+      x     = vsubq_s32( x, FT_TRIG_APPLY_4( dx, m ) );
+      y     = vaddq_s32( y, FT_TRIG_APPLY_4( dy, m ) );
+      theta = vsubq_s32( theta, FT_TRIG_APPLY_4( a, m ) );
+    }
+
+    vst1q_s32( xs, x );
+    vst1q_s32( ys, y );
+  }
+
+
+  /* the x components are returned as unsigned values */
+  static void
+  ft_trig_pseudo_polarize_4( FT_Int32*  xs,
+                             FT_Int32*  ys,
+                             FT_Int32*  thetas )
+  {
+    int32x4_t        x, y, theta, dx, dy, m, b, sh, a;
+    int32x4_t        zero = vdupq_n_s32( 0 );
+    FT_Int           i;
+    const FT_Angle  *arctanptr = ft_trig_arctan_table;
+
+
+    x     = vld1q_s32( xs );
+    y     = vld1q_s32( ys );
+    theta = vld1q_s32( thetas );
+
+    for ( i = 1; i < FT_TRIG_MAX_ITERS; i++ )
+    {
+      b  = vdupq_n_s32( 1 << ( i - 1 ) );
+      sh = vdupq_n_s32( -i );
+      a  = vdupq_n_s32( (FT_Int32)*arctanptr++ );
+      m  = vreinterpretq_s32_u32( vcgtq_s32( y, zero ) );
+
+      dx    = vshlq_s32( vaddq_s32( y, b ), sh );
+      dy    = vreinterpretq_s32_u32(
+                vshlq_u32( vreinterpretq_u32_s32( vaddq_s32( x, b ) ),
+                           sh ) );
+      x     = vsubq_s32( x, FT_TRIG_APPLY_4( dx, m ) );
+      y     = vaddq_s32( y, FT_TRIG_APPLY_4( dy, m ) );
+      theta = vsubq_s32( theta, FT_TRIG_APPLY_4( a, m ) );
+    }
+
+    vst1q_s32( xs, x );
+    vst1q_s32( thetas, theta );
   }
 
+#endif /* FT_SIMD_ARM64 */
+
+#endif /* FT_TRIG_VECTORS */
+
 
   /* documentation is in fttrigon.h */
 
@@ -370,14 +641,6 @@
   }
 
 
-  /* these macros return 0 for positive numbers,
-     and -1 for negative ones */
-#define FT_SIGN_LONG( x )   ( (x) >> ( FT_SIZEOF_LONG * 8 - 1 ) )
-#define FT_SIGN_INT( x )    ( (x) >> ( FT_SIZEOF_INT * 8 - 1 ) )
-#define FT_SIGN_INT32( x )  ( (x) >> 31 )
-#define FT_SIGN_INT16( x )  ( (x) >> 15 )
-
-
   /* documentation is in fttrigon.h */
 
   FT_EXPORT_DEF( void )
@@ -398,23 +661,9 @@
     {
       shift = ft_trig_prenorm( &v );
       ft_trig_pseudo_rotate( &v, angle );
-      v.x = ft_trig_downscale( v.x );
-      v.y = ft_trig_downscale( v.y );
+      ft_trig_postnorm( &v, shift );
 
-      if ( shift > 0 )
-      {
-        FT_Int32  half = (FT_Int32)1L << ( shift - 1 );
-
-
-        vec->x = ( v.x + half + FT_SIGN_LONG( v.x ) ) >> shift;
-        vec->y = ( v.y + half + FT_SIGN_LONG( v.y ) ) >> shift;
-      }
-      else
-      {
-        shift  = -shift;
-        vec->x = (FT_Pos)( (FT_ULong)v.x << shift );
-        vec->y = (FT_Pos)( (FT_ULong)v.y << shift );
-      }
+      *vec = v;
     }
   }
 
@@ -447,12 +696,7 @@
     shift = ft_trig_prenorm( &v );
     ft_trig_pseudo_polarize( &v );
 
-    v.x = ft_trig_downscale( v.x );
-
-    if ( shift > 0 )
-      return ( v.x + ( 1 << ( shift - 1 ) ) ) >> shift;
-
-    return (FT_Fixed)( (FT_UInt32)v.x << -shift );
+    return ft_trig_length( v.x, shift );
   }
 
 
@@ -503,6 +747,218 @@
   }
 
 
+  /* documentation is in fttrigon.h */
+
+  FT_EXPORT_DEF( void )
+  FT_Vector_Polarize_Array( const FT_Vector*  vecs,
+                            FT_UInt           count,
+                            FT_Fixed*         lengths,
+                            FT_Angle*         angles )
+  {
+    FT_UInt  i, j, n;
+
+
+    if ( !vecs )
+      return;
+
+    for ( i = 0; i < count; i += n )
+    {
+      FT_Vector  r[4];
+      FT_Int     shifts[4];
+      FT_Bool    lanes = FALSE;
+
+#ifdef FT_TRIG_VECTORS
+      FT_Int32   xs[4], ys[4], thetas[4];
+      FT_Bool    lane[4];
+#endif
+
+
+      n = count - i;
+      if ( n > 4 )
+        n = 4;
+
+      for ( j = 0; j < 4; j++ )
+      {
+        FT_Vector  v;
+
+
+#ifdef FT_TRIG_VECTORS
+        xs[j]     = 0;
+        ys[j]     = 0;
+        thetas[j] = 0;
+        lane[j]   = FALSE;
+#endif
+
+        if ( j >= n )
+          continue;
+
+        r[j].x    = 0;
+        r[j].y    = 0;
+        shifts[j] = 0;
+
+        v = vecs[i + j];
+        if ( v.x == 0 && v.y == 0 )
+          continue;
+
+        shifts[j] = ft_trig_prenorm( &v );
+
+#ifdef FT_TRIG_VECTORS
+        /* huge values are not really normalized */
+        if ( n > 1                       &&
+             FT_ABS( v.x ) < 0x40000000L &&
+             FT_ABS( v.y ) < 0x40000000L )
+        {
+          thetas[j] = (FT_Int32)ft_trig_polarize_sector( &v );
+          xs[j]     = (FT_Int32)v.x;
+          ys[j]     = (FT_Int32)v.y;
+          lane[j]   = TRUE;
+          lanes     = TRUE;
+          continue;
+        }
+#endif
+
+        ft_trig_pseudo_polarize( &v );
+        r[j] = v;
+      }
+
+#ifdef FT_TRIG_VECTORS
+      if ( lanes )
+      {
+        ft_trig_pseudo_polarize_4( xs, ys, thetas );
+
+        for ( j = 0; j < n; j++ )
+        {
+          if ( !lane[j] )
+            continue;
+
+          r[j].x = (FT_Fixed)(FT_UInt32)xs[j];
+          r[j].y = ft_trig_round_angle( thetas[j] );
+        }
+      }
+#else
+      FT_UNUSED( lanes );
+#endif
+
+      for ( j = 0; j < n; j++ )
+      {
+        const FT_Vector*  v = vecs + i + j;
+
+
+        if ( angles )
+          angles[i + j] = r[j].y;
+
+        if ( !lengths )
+          continue;
+
+        /* handle trivial cases as in `FT_Vector_Length' */
+        if ( v->x == 0 )
+          lengths[i + j] = FT_ABS( v->y );
+        else if ( v->y == 0 )
+          lengths[i + j] = FT_ABS( v->x );
+        else
+          lengths[i + j] = ft_trig_length( r[j].x, shifts[j] );
+      }
+    }
+  }
+
+
+  /* documentation is in fttrigon.h */
+
+  FT_EXPORT_DEF( void )
+  FT_Vector_From_Polar_Array( FT_Vector*       vecs,
+                              FT_UInt          count,
+                              const FT_Fixed*  lengths,
+                              const FT_Angle*  angles )
+  {
+    FT_UInt  i, j, n;
+
+
+    if ( !vecs || !lengths || !angles )
+      return;
+
+    for ( i = 0; i < count; i += n )
+    {
+      FT_Int   shifts[4];
+      FT_Bool  lanes = FALSE;
+
+#ifdef FT_TRIG_VECTORS
+      FT_Int32  xs[4], ys[4], thetas[4];
+      FT_Bool   lane[4];
+#endif
+
+
+      n = count - i;
+      if ( n > 4 )
+        n = 4;
+
+      for ( j = 0; j < 4; j++ )
+      {
+        FT_Vector*  vec = vecs + i + j;
+        FT_Angle    angle;
+
+
+#ifdef FT_TRIG_VECTORS
+        xs[j]     = 0;
+        ys[j]     = 0;
+        thetas[j] = 0;
+        lane[j]   = FALSE;
+#endif
+
+        if ( j >= n )
+          continue;
+
+        vec->x = lengths[i + j];
+        vec->y = 0;
+        angle  = angles[i + j];
+
+        /* `FT_Vector_Rotate' returns such vectors unchanged */
+        if ( angle == 0 || vec->x == 0 )
+          continue;
+
+        shifts[j] = ft_trig_prenorm( vec );
+
+#ifdef FT_TRIG_VECTORS
+        /* huge values are not really normalized */
+        if ( n > 1 && FT_ABS( vec->x ) < 0x40000000L )
+        {
+          thetas[j] = (FT_Int32)ft_trig_rotate_sector( vec, angle );
+          xs[j]     = (FT_Int32)vec->x;
+          ys[j]     = (FT_Int32)vec->y;
+          lane[j]   = TRUE;
+          lanes     = TRUE;
+          continue;
+        }
+#endif
+
+        ft_trig_pseudo_rotate( vec, angle );
+        ft_trig_postnorm( vec, shifts[j] );
+      }
+
+#ifdef FT_TRIG_VECTORS
+      if ( lanes )
+      {
+        ft_trig_pseudo_rotate_4( xs, ys, thetas );
+
+        for ( j = 0; j < n; j++ )
+        {
+          FT_Vector*  vec = vecs + i + j;
+
+
+          if ( !lane[j] )
+            continue;
+
+          vec->x = xs[j];
+          vec->y = ys[j];
+          ft_trig_postnorm( vec, shifts[j] );
+        }
+      }
+#else
+      FT_UNUSED( lanes );
+#endif
+    }
+  }
+
+
   /* documentation is in fttrigon.h */
 
   FT_EXPORT_DEF( FT_Angle )
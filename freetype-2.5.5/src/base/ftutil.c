@@ -21,6 +21,7 @@
 #include FT_INTERNAL_MEMORY_H
 #include FT_INTERNAL_OBJECTS_H
 #include FT_LIST_H
+#include FT_ARENA_H
 
 
   /*************************************************************************/
@@ -73,6 +74,8 @@
 
     if ( size > 0 )
     {
+      FT_GLOBAL_COUNTER_ADD( FT_COUNTER_ALLOCATIONS, 1 );
+
       block = memory->alloc( memory, size );
       if ( block == NULL )
         error = FT_THROW( Out_Of_Memory );
@@ -152,6 +155,8 @@
       FT_Long     new_size = new_count*item_size;
 
 
+      FT_GLOBAL_COUNTER_ADD( FT_COUNTER_ALLOCATIONS, 1 );
+
       block2 = memory->realloc( memory, cur_size, new_size, block );
       if ( block2 == NULL )
         error = FT_THROW( Out_Of_Memory );
@@ -221,6 +226,328 @@
   }
 
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /*************************************************************************/
+  /*****                                                               *****/
+  /*****                                                               *****/
+  /*****                 A R E N A   M E M O R Y                       *****/
+  /*****                                                               *****/
+  /*****                                                               *****/
+  /*************************************************************************/
+  /*************************************************************************/
+  /*************************************************************************/
+
+  /*
+   *  An arena hands out blocks from a stack of chunks, obtained from its
+   *  parent memory manager.  The fill level of the arena is expressed as
+   *  a virtual offset: each chunk records the fill level at the time it
+   *  was started, so that a single integer is sufficient to rewind all
+   *  chunks (see `FT_Arena_Release').
+   *
+   *  Since `FT_Free_Func' doesn't pass a block size, frees are no-ops;
+   *  the most recently allocated block can still be resized in place,
+   *  which covers the common `grow a table while parsing' case.
+   */
+
+#define FT_ARENA_ALIGNMENT     16
+#define FT_ARENA_ALIGN( x )    ( ( (x) + FT_ARENA_ALIGNMENT - 1 ) & \
+                                 ~(FT_ULong)( FT_ARENA_ALIGNMENT - 1 ) )
+
+#define FT_ARENA_CHUNK_SIZE    0x10000UL
+#define FT_ARENA_HEADER_SIZE   FT_ARENA_ALIGN( sizeof ( FT_ArenaChunkRec ) )
+#define FT_ARENA_CHUNK_DATA( c )  ( (FT_Byte*)(c) + FT_ARENA_HEADER_SIZE )
+
+
+  typedef struct FT_ArenaChunkRec_*  FT_ArenaChunk;
+
+  typedef struct  FT_ArenaChunkRec_
+  {
+    FT_ArenaChunk  link;    /* previous chunk in use, or next spare chunk */
+    FT_ULong       start;   /* fill level at the start of this chunk      */
+    FT_ULong       size;    /* usable size in bytes                       */
+
+  } FT_ArenaChunkRec;
+
+
+  typedef struct  FT_ArenaRec_
+  {
+    struct FT_MemoryRec_  root;
+
+    FT_Memory             parent;
+    FT_ULong              chunk_size;
+
+    FT_ArenaChunk         chunks;   /* chunks in use, most recent first */
+    FT_ArenaChunk         spares;   /* released chunks for later reuse  */
+    FT_ULong              cursor;   /* fill level of the current chunk  */
+
+  } FT_ArenaRec, *FT_Arena;
+
+
+  static FT_ArenaChunk
+  ft_arena_chunk_new( FT_Arena  arena,
+                      FT_ULong  size )
+  {
+    FT_ArenaChunk   chunk;
+    FT_ArenaChunk*  pchunk = &arena->spares;
+
+
+    /* first try to recycle a released chunk */
+    for ( ;; )
+    {
+      chunk = *pchunk;
+      if ( !chunk || chunk->size >= size )
+        break;
+
+      pchunk = &chunk->link;
+    }
+
+    if ( chunk )
+      *pchunk = chunk->link;
+    else
+    {
+      FT_Memory  parent = arena->parent;
+
+
+      if ( size < arena->chunk_size )
+        size = arena->chunk_size;
+
+      if ( size > (FT_ULong)FT_LONG_MAX - FT_ARENA_HEADER_SIZE )
+        return NULL;
+
+      chunk = (FT_ArenaChunk)parent->alloc(
+                               parent,
+                               (long)( FT_ARENA_HEADER_SIZE + size ) );
+      if ( !chunk )
+        return NULL;
+
+      chunk->size = size;
+    }
+
+    chunk->start = arena->chunks ? arena->chunks->start + arena->cursor
+                                 : 0;
+    chunk->link  = arena->chunks;
+
+    arena->chunks = chunk;
+    arena->cursor = 0;
+
+    return chunk;
+  }
+
+
+  static void*
+  ft_arena_alloc( FT_Memory  memory,
+                  long       size )
+  {
+    FT_Arena       arena = (FT_Arena)memory->user;
+    FT_ArenaChunk  chunk = arena->chunks;
+    FT_ULong       asize;
+    FT_Byte*       block;
+
+
+    if ( size <= 0                                                  ||
+         (FT_ULong)size > (FT_ULong)FT_LONG_MAX - FT_ARENA_ALIGNMENT )
+      return NULL;
+
+    asize = FT_ARENA_ALIGN( (FT_ULong)size );
+
+    if ( !chunk || chunk->size - arena->cursor < asize )
+    {
+      chunk = ft_arena_chunk_new( arena, asize );
+      if ( !chunk )
+        return NULL;
+    }
+
+    block          = FT_ARENA_CHUNK_DATA( chunk ) + arena->cursor;
+    arena->cursor += asize;
+
+    return block;
+  }
+
+
+  static void
+  ft_arena_free( FT_Memory  memory,
+                 void*      block )
+  {
+    /* blocks are only reclaimed by `FT_Arena_Release' */
+    FT_UNUSED( memory );
+    FT_UNUSED( block );
+  }
+
+
+  static void*
+  ft_arena_realloc( FT_Memory  memory,
+                    long       cur_size,
+                    long       new_size,
+                    void*      block )
+  {
+    FT_Arena       arena = (FT_Arena)memory->user;
+    FT_ArenaChunk  chunk = arena->chunks;
+    FT_ULong       cur_asize, new_asize;
+    void*          new_block;
+
+
+    if ( new_size <= 0                                                  ||
+         (FT_ULong)new_size > (FT_ULong)FT_LONG_MAX - FT_ARENA_ALIGNMENT )
+      return NULL;
+
+    cur_asize = FT_ARENA_ALIGN( (FT_ULong)cur_size );
+    new_asize = FT_ARENA_ALIGN( (FT_ULong)new_size );
+
+    /* resize the most recent block in place if possible */
+    if ( chunk                                                          &&
+         arena->cursor >= cur_asize                                     &&
+         (FT_Byte*)block == FT_ARENA_CHUNK_DATA( chunk ) + arena->cursor -
+                              cur_asize                                 &&
+         chunk->size - ( arena->cursor - cur_asize ) >= new_asize       )
+    {
+      arena->cursor = arena->cursor - cur_asize + new_asize;
+      return block;
+    }
+
+    if ( new_size <= cur_size )
+      return block;
+
+    new_block = ft_arena_alloc( memory, new_size );
+    if ( new_block && block )
+      FT_MEM_COPY( new_block, block, cur_size );
+
+    return new_block;
+  }
+
+
+  FT_BASE_DEF( FT_Bool )
+  ft_mem_is_arena( FT_Memory  memory )
+  {
+    return FT_BOOL( memory && memory->alloc == ft_arena_alloc );
+  }
+
+
+  /* documentation is in ftarena.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Arena_New( FT_Memory   parent,
+                FT_ULong    chunk_size,
+                FT_Memory  *aarena )
+  {
+    FT_Arena  arena;
+
+
+    if ( !aarena )
+      return FT_THROW( Invalid_Argument );
+
+    *aarena = NULL;
+
+    if ( !parent )
+      return FT_THROW( Invalid_Argument );
+
+    if ( chunk_size == 0 )
+      chunk_size = FT_ARENA_CHUNK_SIZE;
+
+    arena = (FT_Arena)parent->alloc( parent, sizeof ( *arena ) );
+    if ( !arena )
+      return FT_THROW( Out_Of_Memory );
+
+    FT_ZERO( arena );
+
+    arena->parent     = parent;
+    arena->chunk_size = FT_ARENA_ALIGN( chunk_size );
+
+    arena->root.user    = arena;
+    arena->root.alloc   = ft_arena_alloc;
+    arena->root.free    = ft_arena_free;
+    arena->root.realloc = ft_arena_realloc;
+
+    *aarena = &arena->root;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in ftarena.h */
+
+  FT_EXPORT_DEF( void )
+  FT_Arena_Done( FT_Memory  memory )
+  {
+    FT_Arena       arena;
+    FT_Memory      parent;
+    FT_ArenaChunk  chunk, next;
+
+
+    if ( !ft_mem_is_arena( memory ) )
+      return;
+
+    arena  = (FT_Arena)memory->user;
+    parent = arena->parent;
+
+    for ( chunk = arena->chunks; chunk; chunk = next )
+    {
+      next = chunk->link;
+      parent->free( parent, chunk );
+    }
+
+    for ( chunk = arena->spares; chunk; chunk = next )
+    {
+      next = chunk->link;
+      parent->free( parent, chunk );
+    }
+
+    parent->free( parent, arena );
+  }
+
+
+  /* documentation is in ftarena.h */
+
+  FT_EXPORT_DEF( FT_ArenaMark )
+  FT_Arena_Mark( FT_Memory  memory )
+  {
+    FT_Arena  arena;
+
+
+    if ( !ft_mem_is_arena( memory ) )
+      return 0;
+
+    arena = (FT_Arena)memory->user;
+
+    return arena->chunks ? arena->chunks->start + arena->cursor : 0;
+  }
+
+
+  /* documentation is in ftarena.h */
+
+  FT_EXPORT_DEF( void )
+  FT_Arena_Release( FT_Memory     memory,
+                    FT_ArenaMark  mark )
+  {
+    FT_Arena       arena;
+    FT_ArenaChunk  chunk;
+
+
+    if ( !ft_mem_is_arena( memory ) )
+      return;
+
+    arena = (FT_Arena)memory->user;
+
+    /* nothing to do for marks at or beyond the current fill level */
+    if ( mark >= FT_Arena_Mark( memory ) )
+      return;
+
+    /* move all chunks started at or after `mark' to the spare list */
+    for (;;)
+    {
+      chunk = arena->chunks;
+      if ( !chunk || chunk->start < mark )
+        break;
+
+      arena->chunks = chunk->link;
+      chunk->link   = arena->spares;
+      arena->spares = chunk;
+    }
+
+    arena->cursor = chunk ? mark - chunk->start : 0;
+  }
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
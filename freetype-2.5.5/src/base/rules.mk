@@ -42,6 +42,7 @@ BASE_SRC := $(BASE_DIR)/basepic.c  \
             $(BASE_DIR)/ftoutln.c  \
             $(BASE_DIR)/ftpic.c    \
             $(BASE_DIR)/ftrfork.c  \
+            $(BASE_DIR)/ftsimd.c   \
             $(BASE_DIR)/ftsnames.c \
             $(BASE_DIR)/ftstream.c \
             $(BASE_DIR)/fttrigon.c \
@@ -27,5 +27,6 @@
 #include "ftcimage.c"
 #include "ftcsbits.c"
 #include "ftcbasic.c"
+#include "ftcstrok.c"
 
 /* END */
@@ -450,6 +450,9 @@
     FTC_Node  node;
 
 
+    cache->misses++;
+    FT_COUNTER_INC( cache->manager->library, FT_COUNTER_CACHE_MISSES );
+
     /*
      * We use the FTC_CACHE_TRYLOOP macros to support out-of-memory
      * errors (OOM) correctly, i.e., by flushing the cache progressively
@@ -548,6 +551,9 @@
 
       if ( node != manager->nodes_list )
         ftc_node_mru_up( node, manager );
+
+      cache->hits++;
+      FT_COUNTER_INC( manager->library, FT_COUNTER_CACHE_HITS );
     }
     *anode = node;
 
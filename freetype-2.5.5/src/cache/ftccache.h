@@ -20,6 +20,7 @@
 #define __FTCCACHE_H__
 
 
+#include FT_INTERNAL_OBJECTS_H
 #include "ftcmru.h"
 
 FT_BEGIN_HEADER
@@ -155,6 +156,9 @@ FT_BEGIN_HEADER
 
     FTC_CacheClass     org_class;   /* original class pointer */
 
+    FT_ULong           hits;        /* lookup statistics      */
+    FT_ULong           misses;
+
   } FTC_CacheRec;
 
 
@@ -272,6 +276,9 @@ FT_BEGIN_HEADER
       if ( _node != _manager->nodes_list )                               \
         FTC_MruNode_Up( (FTC_MruNode*)_nl,                               \
                         (FTC_MruNode)_node );                            \
+                                                                         \
+      _cache->hits++;                                                    \
+      FT_COUNTER_INC( _manager->library, FT_COUNTER_CACHE_HITS );        \
     }                                                                    \
     goto _Ok;                                                            \
                                                                          \
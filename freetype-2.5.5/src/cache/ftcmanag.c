@@ -686,6 +686,31 @@
   }
 
 
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_Manager_GetCacheStats( FTC_Manager  manager,
+                             FT_UInt      cache_index,
+                             FT_ULong    *ahits,
+                             FT_ULong    *amisses )
+  {
+    FTC_Cache  cache;
+
+
+    if ( !manager || cache_index >= manager->num_caches )
+      return FT_THROW( Invalid_Argument );
+
+    cache = manager->caches[cache_index];
+
+    if ( ahits )
+      *ahits = cache->hits;
+    if ( amisses )
+      *amisses = cache->misses;
+
+    return FT_Err_Ok;
+  }
+
+
   /* documentation is in ftcache.h */
 
   FT_EXPORT_DEF( void )
@@ -0,0 +1,361 @@
+/***************************************************************************/
+/*                                                                         */
+/*  ftcstrok.c                                                             */
+/*                                                                         */
+/*    The FreeType stroked glyph image cache (body).                       */
+/*                                                                         */
+/*  Copyright 2026 by                                                      */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+#include <ft2build.h>
+#include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_DEBUG_H
+#include FT_CACHE_H
+#include FT_STROKER_H
+#include "ftcglyph.h"
+#include "ftcimage.h"
+
+#include "ftccback.h"
+#include "ftcerror.h"
+
+#undef  FT_COMPONENT
+#define FT_COMPONENT  trace_cache
+
+
+  /*
+   *  Stroke Families
+   *
+   *  A family holds everything but the glyph index, i.e., the scaler, the
+   *  load flags, and the stroker parameters.
+   */
+  typedef struct  FTC_StrokeAttrRec_
+  {
+    FTC_ScalerRec        scaler;
+    FT_UInt              load_flags;
+    FT_Fixed             radius;
+    FT_Stroker_LineCap   line_cap;
+    FT_Stroker_LineJoin  line_join;
+    FT_Fixed             miter_limit;
+
+  } FTC_StrokeAttrRec, *FTC_StrokeAttrs;
+
+#define FTC_STROKE_ATTR_COMPARE( a, b )                                \
+          FT_BOOL( FTC_SCALER_COMPARE( &(a)->scaler, &(b)->scaler ) && \
+                   (a)->load_flags  == (b)->load_flags              && \
+                   (a)->radius      == (b)->radius                  && \
+                   (a)->line_cap    == (b)->line_cap                && \
+                   (a)->line_join   == (b)->line_join               && \
+                   (a)->miter_limit == (b)->miter_limit             )
+
+#define FTC_STROKE_ATTR_HASH( a )                                  \
+          ( FTC_SCALER_HASH( &(a)->scaler ) + 31*(a)->load_flags + \
+            (FT_PtrDist)(a)->radius*17 + (a)->line_cap*5         + \
+            (a)->line_join*3 + (FT_PtrDist)(a)->miter_limit      )
+
+
+  typedef struct  FTC_StrokeQueryRec_
+  {
+    FTC_GQueryRec      gquery;
+    FTC_StrokeAttrRec  attrs;
+
+  } FTC_StrokeQueryRec, *FTC_StrokeQuery;
+
+
+  typedef struct  FTC_StrokeFamilyRec_
+  {
+    FTC_FamilyRec      family;
+    FTC_StrokeAttrRec  attrs;
+
+  } FTC_StrokeFamilyRec, *FTC_StrokeFamily;
+
+
+  /*
+   *  The stroker is shared by all families of a cache; its border arrays
+   *  thus survive from one cache miss to the next.
+   */
+  typedef struct  FTC_StrokeCacheRec_
+  {
+    FTC_GCacheRec  gcache;
+    FT_Stroker     stroker;
+
+  } FTC_StrokeCacheRec;
+
+
+  FT_CALLBACK_DEF( FT_Bool )
+  ftc_stroke_family_compare( FTC_MruNode  ftcfamily,
+                             FT_Pointer   ftcquery )
+  {
+    FTC_StrokeFamily  family = (FTC_StrokeFamily)ftcfamily;
+    FTC_StrokeQuery   query  = (FTC_StrokeQuery)ftcquery;
+
+
+    return FTC_STROKE_ATTR_COMPARE( &family->attrs, &query->attrs );
+  }
+
+
+  FT_CALLBACK_DEF( FT_Error )
+  ftc_stroke_family_init( FTC_MruNode  ftcfamily,
+                          FT_Pointer   ftcquery,
+                          FT_Pointer   ftccache )
+  {
+    FTC_StrokeFamily  family = (FTC_StrokeFamily)ftcfamily;
+    FTC_StrokeQuery   query  = (FTC_StrokeQuery)ftcquery;
+    FTC_Cache         cache  = (FTC_Cache)ftccache;
+
+
+    FTC_Family_Init( FTC_FAMILY( family ), cache );
+    family->attrs = query->attrs;
+    return 0;
+  }
+
+
+  FT_CALLBACK_DEF( FT_Error )
+  ftc_stroke_family_load_glyph( FTC_Family  ftcfamily,
+                                FT_UInt     gindex,
+                                FTC_Cache   ftccache,
+                                FT_Glyph   *aglyph )
+  {
+    FTC_StrokeFamily  family = (FTC_StrokeFamily)ftcfamily;
+    FTC_StrokeCache   cache  = (FTC_StrokeCache)ftccache;
+    FTC_StrokeAttrs   attrs  = &family->attrs;
+    FT_Error          error;
+    FT_Size           size;
+    FT_Face           face;
+    FT_Glyph          glyph = NULL;
+
+
+    error = FTC_Manager_LookupSize( ftccache->manager,
+                                    &attrs->scaler,
+                                    &size );
+    if ( error )
+      goto Exit;
+
+    face = size->face;
+
+    /* we render the stroked outline ourselves */
+    error = FT_Load_Glyph( face, gindex,
+                           attrs->load_flags & ~FT_LOAD_RENDER );
+    if ( error )
+      goto Exit;
+
+    if ( face->glyph->format != FT_GLYPH_FORMAT_OUTLINE )
+    {
+      error = FT_THROW( Invalid_Glyph_Format );
+      goto Exit;
+    }
+
+    error = FT_Get_Glyph( face->glyph, &glyph );
+    if ( error )
+      goto Exit;
+
+    FT_Stroker_Set( cache->stroker,
+                    attrs->radius,
+                    attrs->line_cap,
+                    attrs->line_join,
+                    attrs->miter_limit );
+
+    error = FT_Glyph_Stroke( &glyph, cache->stroker, 1 );
+    if ( error )
+      goto Exit;
+
+    if ( attrs->load_flags & FT_LOAD_RENDER )
+    {
+      FT_Render_Mode  mode = FT_LOAD_TARGET_MODE( attrs->load_flags );
+
+
+      if ( mode == FT_RENDER_MODE_NORMAL                   &&
+           ( attrs->load_flags & FT_LOAD_MONOCHROME ) )
+        mode = FT_RENDER_MODE_MONO;
+
+      error = FT_Glyph_To_Bitmap( &glyph, mode, NULL, 1 );
+      if ( error )
+        goto Exit;
+    }
+
+    *aglyph = glyph;
+    glyph   = NULL;
+
+  Exit:
+    FT_Done_Glyph( glyph );
+    return error;
+  }
+
+
+  FT_CALLBACK_DEF( FT_Bool )
+  ftc_stroke_gnode_compare_faceid( FTC_Node    ftcgnode,
+                                   FT_Pointer  ftcface_id,
+                                   FTC_Cache   cache,
+                                   FT_Bool*    list_changed )
+  {
+    FTC_GNode         gnode   = (FTC_GNode)ftcgnode;
+    FTC_FaceID        face_id = (FTC_FaceID)ftcface_id;
+    FTC_StrokeFamily  family  = (FTC_StrokeFamily)gnode->family;
+    FT_Bool           result;
+
+
+    if ( list_changed )
+      *list_changed = FALSE;
+    result = FT_BOOL( family->attrs.scaler.face_id == face_id );
+    if ( result )
+    {
+      /* we must call this function to avoid this node from appearing
+       * in later lookups with the same face_id!
+       */
+      FTC_GNode_UnselectFamily( gnode, cache );
+    }
+    return result;
+  }
+
+
+  FT_CALLBACK_DEF( FT_Error )
+  ftc_stroke_cache_init( FTC_Cache  ftccache )
+  {
+    FTC_StrokeCache  cache = (FTC_StrokeCache)ftccache;
+    FT_Error         error;
+
+
+    error = ftc_gcache_init( ftccache );
+    if ( !error )
+      error = FT_Stroker_New( ftccache->manager->library,
+                              &cache->stroker );
+
+    return error;
+  }
+
+
+  FT_CALLBACK_DEF( void )
+  ftc_stroke_cache_done( FTC_Cache  ftccache )
+  {
+    FTC_StrokeCache  cache = (FTC_StrokeCache)ftccache;
+
+
+    ftc_gcache_done( ftccache );
+
+    FT_Stroker_Done( cache->stroker );
+    cache->stroker = NULL;
+  }
+
+
+  static
+  const FTC_IFamilyClassRec  ftc_stroke_family_class =
+  {
+    {
+      sizeof ( FTC_StrokeFamilyRec ),
+      ftc_stroke_family_compare,
+      ftc_stroke_family_init,
+      0,                        /* FTC_MruNode_ResetFunc */
+      0                         /* FTC_MruNode_DoneFunc  */
+    },
+    ftc_stroke_family_load_glyph
+  };
+
+
+  static
+  const FTC_GCacheClassRec  ftc_stroke_cache_class =
+  {
+    {
+      ftc_inode_new,
+      ftc_inode_weight,
+      ftc_gnode_compare,
+      ftc_stroke_gnode_compare_faceid,
+      ftc_inode_free,
+
+      sizeof ( FTC_StrokeCacheRec ),
+      ftc_stroke_cache_init,
+      ftc_stroke_cache_done
+    },
+    (FTC_MruListClass)&ftc_stroke_family_class
+  };
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_StrokeCache_New( FTC_Manager       manager,
+                       FTC_StrokeCache  *acache )
+  {
+    return FTC_GCache_New( manager, &ftc_stroke_cache_class,
+                           (FTC_GCache*)acache );
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_StrokeCache_Lookup( FTC_StrokeCache  cache,
+                          FTC_StrokeType   type,
+                          FT_UInt          gindex,
+                          FT_Glyph        *aglyph,
+                          FTC_Node        *anode )
+  {
+    FTC_StrokeQueryRec  query;
+    FTC_Node            node = 0; /* make compiler happy */
+    FT_Error            error;
+    FT_PtrDist          hash;
+
+
+    /* some argument checks are delayed to `FTC_Cache_Lookup' */
+    if ( !aglyph || !type )
+    {
+      error = FT_THROW( Invalid_Argument );
+      goto Exit;
+    }
+
+    *aglyph = NULL;
+    if ( anode )
+      *anode  = NULL;
+
+    if ( (FT_ULong)( type->image.flags - FT_INT_MIN ) > FT_UINT_MAX )
+      FT_TRACE1(( "FTC_StrokeCache_Lookup:"
+                  " higher bits in load_flags 0x%x are dropped\n",
+                  type->image.flags & ~((FT_ULong)FT_UINT_MAX) ));
+
+    query.attrs.scaler.face_id = type->image.face_id;
+    query.attrs.scaler.width   = type->image.width;
+    query.attrs.scaler.height  = type->image.height;
+    query.attrs.load_flags     = (FT_UInt)type->image.flags;
+
+    query.attrs.scaler.pixel = 1;
+    query.attrs.scaler.x_res = 0;  /* make compilers happy */
+    query.attrs.scaler.y_res = 0;
+
+    query.attrs.radius      = type->radius;
+    query.attrs.line_cap    = type->line_cap;
+    query.attrs.line_join   = type->line_join;
+    query.attrs.miter_limit = type->miter_limit;
+
+    hash = FTC_STROKE_ATTR_HASH( &query.attrs ) + gindex;
+
+    FTC_GCACHE_LOOKUP_CMP( cache,
+                           ftc_stroke_family_compare,
+                           FTC_GNode_Compare,
+                           hash, gindex,
+                           &query,
+                           node,
+                           error );
+    if ( !error )
+    {
+      *aglyph = FTC_INODE( node )->glyph;
+
+      if ( anode )
+      {
+        *anode = node;
+        node->ref_count++;
+      }
+    }
+
+  Exit:
+    return error;
+  }
+
+
+/* END */
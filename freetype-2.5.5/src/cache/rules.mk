@@ -31,7 +31,8 @@ CACHE_DRV_SRC := $(CACHE_DIR)/ftcbasic.c \
                  $(CACHE_DIR)/ftcimage.c \
                  $(CACHE_DIR)/ftcmanag.c \
                  $(CACHE_DIR)/ftcmru.c   \
-                 $(CACHE_DIR)/ftcsbits.c
+                 $(CACHE_DIR)/ftcsbits.c \
+                 $(CACHE_DIR)/ftcstrok.c
 
 # Cache driver headers
 #
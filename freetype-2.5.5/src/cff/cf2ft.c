@@ -41,6 +41,7 @@
 
 #include "cf2font.h"
 #include "cf2error.h"
+#include "cffload.h"
 
 
 #define CF2_MAX_SIZE  cf2_intToFixed( 2000 )    /* max ppem */
@@ -540,6 +541,28 @@
   }
 
 
+  /* Set `buf' to the charstring data of subroutine `idx' (unbiased),  */
+  /* taken from the `subrs' table or, if that is NULL, by decoding the  */
+  /* offsets in `subrs_index'.  The caller must check `idx'; `buf' is   */
+  /* empty if the subroutine data is not available.                     */
+  static void
+  cf2_getSubrRange( CFF_Index   subrs_index,
+                    FT_Byte**   subrs,
+                    CF2_UInt    idx,
+                    CF2_Buffer  buf )
+  {
+    FT_Byte*  start;
+    FT_Byte*  limit;
+
+
+    cff_index_get_element_range( subrs_index, subrs, idx, &start, &limit );
+
+    buf->start =
+    buf->ptr   = start;
+    buf->end   = limit;
+  }
+
+
   /* convert unbiased subroutine index to `CF2_Buffer' and */
   /* return 0 on success                                   */
   FT_LOCAL_DEF( CF2_Int )
@@ -555,11 +578,10 @@
     if ( idx >= decoder->num_globals )
       return TRUE;     /* error */
 
-    FT_ASSERT( decoder->globals );
-
-    buf->start =
-    buf->ptr   = decoder->globals[idx];
-    buf->end   = decoder->globals[idx + 1];
+    cf2_getSubrRange( decoder->globals_index,
+                      decoder->globals,
+                      idx,
+                      buf );
 
     return FALSE;      /* success */
   }
@@ -617,6 +639,8 @@
   }
 
 
+  /* convert unbiased local subroutine index to `CF2_Buffer' */
+  /* and return 0 on success                                 */
   FT_LOCAL_DEF( CF2_Int )
   cf2_initLocalRegionBuffer( CFF_Decoder*  decoder,
                              CF2_UInt      idx,
@@ -630,11 +654,10 @@
     if ( idx >= decoder->num_locals )
       return TRUE;     /* error */
 
-    FT_ASSERT( decoder->locals );
-
-    buf->start =
-    buf->ptr   = decoder->locals[idx];
-    buf->end   = decoder->locals[idx + 1];
+    cf2_getSubrRange( decoder->locals_index,
+                      decoder->locals,
+                      idx,
+                      buf );
 
     return FALSE;      /* success */
   }
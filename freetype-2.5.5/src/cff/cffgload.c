@@ -397,14 +397,15 @@
     cff_builder_init( &decoder->builder, face, size, slot, hinting );
 
     /* initialize Type2 decoder */
-    decoder->cff          = cff;
-    decoder->num_globals  = cff->global_subrs_index.count;
-    decoder->globals      = cff->global_subrs;
-    decoder->globals_bias = cff_compute_bias(
-                              cff->top_font.font_dict.charstring_type,
-                              decoder->num_globals );
-
-    decoder->hint_mode    = hint_mode;
+    decoder->cff           = cff;
+    decoder->num_globals   = cff->global_subrs_index.count;
+    decoder->globals       = cff->global_subrs;
+    decoder->globals_index = &cff->global_subrs_index;
+    decoder->globals_bias  = cff_compute_bias(
+                               cff->top_font.font_dict.charstring_type,
+                               decoder->num_globals );
+
+    decoder->hint_mode     = hint_mode;
   }
 
 
@@ -450,6 +451,7 @@
 
     decoder->num_locals    = sub->local_subrs_index.count;
     decoder->locals        = sub->local_subrs;
+    decoder->locals_index  = &sub->local_subrs_index;
     decoder->locals_bias   = cff_compute_bias(
                                decoder->cff->top_font.font_dict.charstring_type,
                                decoder->num_locals );
@@ -1994,15 +1996,25 @@
             /* close hints recording session */
             if ( hinter )
             {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+              FT_Library  library = FT_FACE_LIBRARY( builder->face );
+#endif
+
+              FT_TIMER_VAR( start )
+
+
               if ( hinter->close( hinter->hints,
                                   builder->current->n_points ) )
                 goto Syntax_Error;
 
               /* apply hints to the loaded glyph outline now */
+              FT_TIMER_START( library, start );
               error = hinter->apply( hinter->hints,
                                      builder->current,
                                      (PSH_Globals)builder->hints_globals,
                                      decoder->hint_mode );
+              FT_TIMER_STOP( library, FT_COUNTER_HINTING_TIME, start );
+
               if ( error )
                 goto Fail;
             }
@@ -2408,8 +2420,11 @@
             zone->cursor = ip;  /* save current instruction pointer */
 
             zone++;
-            zone->base   = decoder->locals[idx];
-            zone->limit  = decoder->locals[idx + 1];
+            cff_index_get_element_range( decoder->locals_index,
+                                         decoder->locals,
+                                         idx,
+                                         &zone->base,
+                                         &zone->limit );
             zone->cursor = zone->base;
 
             if ( !zone->base || zone->limit == zone->base )
@@ -2450,8 +2465,11 @@
             zone->cursor = ip;  /* save current instruction pointer */
 
             zone++;
-            zone->base   = decoder->globals[idx];
-            zone->limit  = decoder->globals[idx + 1];
+            cff_index_get_element_range( decoder->globals_index,
+                                         decoder->globals,
+                                         idx,
+                                         &zone->base,
+                                         &zone->limit );
             zone->cursor = zone->base;
 
             if ( !zone->base || zone->limit == zone->base )
@@ -181,9 +181,13 @@ FT_BEGIN_HEADER
     FT_Int             locals_bias;
     FT_Int             globals_bias;
 
+    /* if NULL, use `cff_index_get_element_range' with the indices */
     FT_Byte**          locals;
     FT_Byte**          globals;
 
+    CFF_Index          locals_index;    /* since 2.6 */
+    CFF_Index          globals_index;
+
     FT_Byte**          glyph_names;   /* for pure CFF fonts only  */
     FT_UInt            num_glyphs;    /* number of glyphs in font */
 
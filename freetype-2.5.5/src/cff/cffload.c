@@ -309,6 +309,9 @@
       if ( idx->bytes )
         FT_FRAME_RELEASE( idx->bytes );
 
+      if ( idx->raw_offsets )
+        FT_FRAME_RELEASE( idx->raw_offsets );
+
       FT_FREE( idx->offsets );
       FT_MEM_ZERO( idx, sizeof ( *idx ) );
     }
@@ -466,6 +469,111 @@
   }
 
 
+  static FT_ULong
+  cff_index_peek_offset( CFF_Index  idx,
+                         FT_UInt    n )
+  {
+    FT_Byte*  p = idx->raw_offsets + n * idx->off_size;
+
+
+    switch ( idx->off_size )
+    {
+    case 1:
+      return p[0];
+
+    case 2:
+      return FT_PEEK_USHORT( p );
+
+    case 3:
+      return FT_PEEK_OFF3( p );
+
+    default:
+      return FT_PEEK_ULONG( p );
+    }
+  }
+
+
+  /* Prepare random access to the elements of an index loaded in     */
+  /* memory.  Normally, we simply access the index's offset table as */
+  /* stored in the font (which doesn't need any allocation if the    */
+  /* font is memory-mapped) and decode offsets on demand.  Only if   */
+  /* the offsets are not sorted, a table of pointers to the elements */
+  /* is returned in `table', using the sanitizing rules of           */
+  /* `cff_index_get_pointers'.                                       */
+  static FT_Error
+  cff_index_map( CFF_Index   idx,
+                 FT_Byte***  table )
+  {
+    FT_Error   error  = FT_Err_Ok;
+    FT_Stream  stream = idx->stream;
+    FT_UInt    n;
+    FT_ULong   cur_offset, next_offset;
+
+
+    *table = NULL;
+
+    if ( idx->count == 0 )
+      goto Exit;
+
+    if ( FT_STREAM_SEEK( idx->start + 3 )                    ||
+         FT_FRAME_EXTRACT( ( idx->count + 1 ) * idx->off_size,
+                           idx->raw_offsets )                )
+      goto Exit;
+
+    cur_offset = cff_index_peek_offset( idx, 0 );
+    if ( cur_offset != 1 )
+      goto Fallback;
+
+    for ( n = 1; n <= idx->count; n++ )
+    {
+      next_offset = cff_index_peek_offset( idx, n );
+      if ( next_offset < cur_offset )
+        goto Fallback;
+
+      cur_offset = next_offset;
+    }
+
+    if ( cur_offset - 1 > idx->data_size )
+      goto Fallback;
+
+  Exit:
+    return error;
+
+  Fallback:
+    FT_TRACE0(( "cff_index_map: invalid offsets; using pointer table\n" ));
+
+    FT_FRAME_RELEASE( idx->raw_offsets );
+    return cff_index_get_pointers( idx, table, NULL );
+  }
+
+
+  /* Get the data of an element of an index loaded with `cff_index_map'; */
+  /* `table' is the pointer table returned by this function.              */
+  FT_LOCAL_DEF( void )
+  cff_index_get_element_range( CFF_Index  idx,
+                               FT_Byte**  table,
+                               FT_UInt    element,
+                               FT_Byte**  pstart,
+                               FT_Byte**  plimit )
+  {
+    if ( table )
+    {
+      *pstart = table[element];
+      *plimit = table[element + 1];
+    }
+    else if ( idx->raw_offsets && idx->bytes )
+    {
+      *pstart = idx->bytes + cff_index_peek_offset( idx, element ) - 1;
+      *plimit = idx->bytes + cff_index_peek_offset( idx, element + 1 ) - 1;
+    }
+    else
+    {
+      *pstart = NULL;
+      *plimit = NULL;
+    }
+  }
+
+
   FT_LOCAL_DEF( FT_Error )
   cff_index_access_element( CFF_Index  idx,
                             FT_UInt    element,
@@ -652,24 +760,71 @@
   CFF_Done_FD_Select( CFF_FDSelect  fdselect,
                       FT_Stream     stream )
   {
+    FT_Memory  memory = stream->memory;
+
+
     if ( fdselect->data )
       FT_FRAME_RELEASE( fdselect->data );
 
+    FT_FREE( fdselect->glyph_fds );
+    fdselect->num_glyphs  = 0;
+
     fdselect->data_size   = 0;
     fdselect->format      = 0;
     fdselect->range_count = 0;
   }
 
 
+  /* Expand the ranges of a format 3 FDSelect table into an array with */
+  /* one FD index per glyph.  Range `k' covers the glyphs from the      */
+  /* largest of all previous range limits (or the first glyph index)    */
+  /* up to its own limit; this makes the array return exactly the same */
+  /* values as a linear search in `cff_fd_select_get', even for broken  */
+  /* tables with overlapping or unsorted ranges.                        */
+  static void
+  cff_fd_select_expand( CFF_FDSelect  fdselect,
+                        FT_UInt       num_glyphs,
+                        FT_Memory     memory )
+  {
+    FT_Error  error;
+    FT_Byte*  p       = fdselect->data;
+    FT_Byte*  p_limit = p + fdselect->data_size;
+    FT_UInt   first, limit;
+    FT_Byte   fd;
+
+
+    if ( !num_glyphs                                    ||
+         FT_NEW_ARRAY( fdselect->glyph_fds, num_glyphs ) )
+      return;   /* not fatal; we search the ranges instead */
+
+    fdselect->num_glyphs = num_glyphs;
+
+    first = FT_NEXT_USHORT( p );
+    while ( p < p_limit && first < num_glyphs )
+    {
+      fd    = *p++;
+      limit = FT_NEXT_USHORT( p );
+
+      if ( limit > first )
+      {
+        FT_MEM_SET( fdselect->glyph_fds + first, fd,
+                    FT_MIN( limit, num_glyphs ) - first );
+        first = limit;
+      }
+    }
+  }
+
+
   static FT_Error
   CFF_Load_FD_Select( CFF_FDSelect  fdselect,
                       FT_UInt       num_glyphs,
                       FT_Stream     stream,
                       FT_ULong      offset )
   {
-    FT_Error  error;
-    FT_Byte   format;
-    FT_UInt   num_ranges;
+    FT_Error   error;
+    FT_Memory  memory = stream->memory;
+    FT_Byte    format;
+    FT_UInt    num_ranges;
 
 
     /* read format */
@@ -701,6 +856,9 @@
     Load_Data:
       if ( FT_FRAME_EXTRACT( fdselect->data_size, fdselect->data ) )
         goto Exit;
+
+      if ( format == 3 )
+        cff_fd_select_expand( fdselect, num_glyphs, memory );
       break;
 
     default:    /* hmm... that's wrong */
@@ -726,7 +884,13 @@
       break;
 
     case 3:
-      /* first, compare to the cache */
+      if ( glyph_index < fdselect->num_glyphs )
+      {
+        fd = fdselect->glyph_fds[glyph_index];
+        break;
+      }
+
+      /* otherwise, compare to the cache */
       if ( (FT_UInt)( glyph_index - fdselect->cache_first ) <
                         fdselect->cache_count )
       {
@@ -783,15 +947,34 @@
   /*************************************************************************/
   /*************************************************************************/
 
+  static void
+  cff_charset_free_cids( CFF_Charset  charset,
+                         FT_Memory    memory )
+  {
+    if ( charset->cids )
+    {
+      FT_UInt  n;
+
+
+      for ( n = 0; n <= charset->max_cid >> CFF_CID_PAGE_BITS; n++ )
+        FT_FREE( charset->cids[n] );
+
+      FT_FREE( charset->cids );
+    }
+    charset->max_cid = 0;
+  }
+
+
   static FT_Error
   cff_charset_compute_cids( CFF_Charset  charset,
                             FT_UInt      num_glyphs,
                             FT_Memory    memory )
   {
-    FT_Error   error   = FT_Err_Ok;
-    FT_UInt    i;
-    FT_Long    j;
-    FT_UShort  max_cid = 0;
+    FT_Error    error   = FT_Err_Ok;
+    FT_UInt     i;
+    FT_Long     j;
+    FT_UShort   max_cid = 0;
+    FT_UShort*  page;
 
 
     if ( charset->max_cid > 0 )
@@ -803,16 +986,34 @@
         max_cid = charset->sids[i];
     }
 
-    if ( FT_NEW_ARRAY( charset->cids, (FT_ULong)max_cid + 1 ) )
+    if ( FT_NEW_ARRAY( charset->cids,
+                       ( max_cid >> CFF_CID_PAGE_BITS ) + 1 ) )
       goto Exit;
 
+    charset->max_cid = max_cid;
+
     /* When multiple GIDs map to the same CID, we choose the lowest */
     /* GID.  This is not described in any spec, but it matches the  */
     /* behaviour of recent Acroread versions.                       */
     for ( j = num_glyphs - 1; j >= 0 ; j-- )
-      charset->cids[charset->sids[j]] = (FT_UShort)j;
+    {
+      FT_UInt  cid = charset->sids[j];
+
+
+      page = charset->cids[cid >> CFF_CID_PAGE_BITS];
+      if ( !page )
+      {
+        if ( FT_NEW_ARRAY( page, CFF_CID_PAGE_SIZE ) )
+        {
+          cff_charset_free_cids( charset, memory );
+          goto Exit;
+        }
+        charset->cids[cid >> CFF_CID_PAGE_BITS] = page;
+      }
+
+      page[cid & CFF_CID_PAGE_MASK] = (FT_UShort)j;
+    }
 
-    charset->max_cid    = max_cid;
     charset->num_glyphs = num_glyphs;
 
   Exit:
@@ -827,19 +1028,16 @@
     FT_UInt  result = 0;
 
 
-    if ( cid <= charset->max_cid )
-      result = charset->cids[cid];
+    if ( charset->cids && cid <= charset->max_cid )
+    {
+      FT_UShort*  page = charset->cids[cid >> CFF_CID_PAGE_BITS];
 
-    return result;
-  }
 
+      if ( page )
+        result = page[cid & CFF_CID_PAGE_MASK];
+    }
 
-  static void
-  cff_charset_free_cids( CFF_Charset  charset,
-                         FT_Memory    memory )
-  {
-    FT_FREE( charset->cids );
-    charset->max_cid = 0;
+    return result;
   }
 
 
@@ -1038,7 +1236,7 @@
     if ( error )
     {
       FT_FREE( charset->sids );
-      FT_FREE( charset->cids );
+      cff_charset_free_cids( charset, memory );
       charset->format = 0;
       charset->offset = 0;
       charset->sids   = 0;
@@ -1399,8 +1597,8 @@
       if ( error )
         goto Exit;
 
-      error = cff_index_get_pointers( &font->local_subrs_index,
-                                      &font->local_subrs, NULL );
+      error = cff_index_map( &font->local_subrs_index,
+                             &font->local_subrs );
       if ( error )
         goto Exit;
     }
@@ -1613,8 +1811,8 @@
 
     font->num_glyphs = font->charstrings_index.count;
 
-    error = cff_index_get_pointers( &font->global_subrs_index,
-                                    &font->global_subrs, NULL );
+    error = cff_index_map( &font->global_subrs_index,
+                           &font->global_subrs );
 
     if ( error )
       goto Exit;
@@ -1662,6 +1860,10 @@
     FT_UInt    idx;
 
 
+    /* with arena memory, all sub-objects go away with the arena */
+    if ( ft_mem_is_arena( memory ) )
+      return;
+
     cff_index_done( &font->global_subrs_index );
     cff_index_done( &font->font_dict_index );
     cff_index_done( &font->name_index );
@@ -49,6 +49,13 @@ FT_BEGIN_HEADER
   cff_index_forget_element( CFF_Index  idx,
                             FT_Byte**  pbytes );
 
+  FT_LOCAL( void )
+  cff_index_get_element_range( CFF_Index  idx,
+                               FT_Byte**  table,
+                               FT_UInt    element,
+                               FT_Byte**  pstart,
+                               FT_Byte**  plimit );
+
   FT_LOCAL( FT_String* )
   cff_index_get_name( CFF_Font  font,
                       FT_UInt   element );
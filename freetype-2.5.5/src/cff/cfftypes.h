@@ -60,6 +60,10 @@ FT_BEGIN_HEADER
   /*                                                                       */
   /*    bytes       :: If the index is loaded in memory, its bytes.        */
   /*                                                                       */
+  /*    raw_offsets :: The offset table as stored in the font, if the      */
+  /*                   index has been loaded with `cff_index_map'.  Since  */
+  /*                   2.6.                                                */
+  /*                                                                       */
   typedef struct  CFF_IndexRec_
   {
     FT_Stream  stream;
@@ -72,6 +76,8 @@ FT_BEGIN_HEADER
     FT_ULong*  offsets;
     FT_Byte*   bytes;
 
+    FT_Byte*   raw_offsets;
+
   } CFF_IndexRec, *CFF_Index;
 
 
@@ -87,17 +93,26 @@ FT_BEGIN_HEADER
   } CFF_EncodingRec, *CFF_Encoding;
 
 
+  /* The inverse mapping of a charset (from CIDs to glyph indices) is a */
+  /* two-level table: the CID's high byte selects a page of 256 glyph   */
+  /* indices, which is only allocated if it is used by any glyph.  This */
+  /* keeps the table small for subsetted fonts with sparse CIDs.        */
+#define CFF_CID_PAGE_BITS  8
+#define CFF_CID_PAGE_SIZE  ( 1U << CFF_CID_PAGE_BITS )
+#define CFF_CID_PAGE_MASK  ( CFF_CID_PAGE_SIZE - 1 )
+
+
   typedef struct  CFF_CharsetRec_
   {
 
-    FT_UInt     format;
-    FT_ULong    offset;
+    FT_UInt      format;
+    FT_ULong     offset;
 
-    FT_UShort*  sids;
-    FT_UShort*  cids;       /* the inverse mapping of `sids'; only needed */
-                            /* for CID-keyed fonts                        */
-    FT_UInt     max_cid;
-    FT_UInt     num_glyphs;
+    FT_UShort*   sids;
+    FT_UShort**  cids;      /* the pages of the inverse mapping of `sids'; */
+                            /* only needed for CID-keyed fonts             */
+    FT_UInt      max_cid;
+    FT_UInt      num_glyphs;
 
   } CFF_CharsetRec, *CFF_Charset;
 
@@ -192,7 +207,12 @@ FT_BEGIN_HEADER
     FT_Byte*  data;
     FT_UInt   data_size;
 
-    /* small cache for format 3 only */
+    /* format 3 only: the FD index of each glyph, expanded from the */
+    /* ranges at load time; if NULL, the ranges are searched and    */
+    /* the last match is cached                                     */
+    FT_Byte*  glyph_fds;
+    FT_UInt   num_glyphs;
+
     FT_UInt   cache_first;
     FT_UInt   cache_count;
     FT_Byte   cache_fd;
@@ -292,7 +292,8 @@
                   FT_Byte*     base,
                   FT_Long      size )
   {
-    CID_Parser*  parser = &loader->parser;
+    CID_Parser*    parser = &loader->parser;
+    PSAux_Service  psaux  = (PSAux_Service)face->psaux;
 
 
     parser->root.cursor = base;
@@ -350,41 +351,21 @@
 
           if ( len > 0 && len < 22 )
           {
-            /* now compare the immediate name to the keyword table */
-            T1_Field  keyword = (T1_Field)cid_field_records;
+            /* now look up the immediate name in the keyword table */
+            T1_Field  keyword;
 
 
-            for (;;)
+            keyword = (T1_Field)psaux->keyword_hash_lookup( &loader->keywords,
+                                                            cur,
+                                                            len );
+            if ( keyword )
             {
-              FT_Byte*  name;
-
-
-              name = (FT_Byte*)keyword->ident;
-              if ( !name )
-                break;
-
-              if ( cur[0] == name[0]                                 &&
-                   len == (FT_PtrDist)ft_strlen( (const char*)name ) )
-              {
-                FT_PtrDist  n;
-
-
-                for ( n = 1; n < len; n++ )
-                  if ( cur[n] != name[n] )
-                    break;
-
-                if ( n >= len )
-                {
-                  /* we found it - run the parsing callback */
-                  parser->root.error = cid_load_keyword( face,
-                                                         loader,
-                                                         keyword );
-                  if ( parser->root.error )
-                    return parser->root.error;
-                  break;
-                }
-              }
-              keyword++;
+              /* we found it - run the parsing callback */
+              parser->root.error = cid_load_keyword( face,
+                                                     loader,
+                                                     keyword );
+              if ( parser->root.error )
+                return parser->root.error;
             }
           }
         }
@@ -646,17 +627,19 @@
   cid_face_open( CID_Face  face,
                  FT_Int    face_index )
   {
-    CID_Loader   loader;
-    CID_Parser*  parser;
-    FT_Memory    memory = face->root.memory;
-    FT_Error     error;
+    CID_Loader     loader;
+    CID_Parser*    parser;
+    FT_Memory      memory = face->root.memory;
+    PSAux_Service  psaux  = (PSAux_Service)face->psaux;
+    FT_Error       error;
 
 
     cid_init_loader( &loader, face );
+    psaux->keyword_hash_init( &loader.keywords, cid_field_records );
 
     parser = &loader.parser;
     error = cid_parser_new( parser, face->root.stream, face->root.memory,
-                            (PSAux_Service)face->psaux );
+                            psaux );
     if ( error )
       goto Exit;
 
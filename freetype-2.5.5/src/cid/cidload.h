@@ -30,8 +30,9 @@ FT_BEGIN_HEADER
 
   typedef struct  CID_Loader_
   {
-    CID_Parser  parser;          /* parser used to read the stream */
-    FT_Int      num_chars;       /* number of characters in encoding */
+    CID_Parser          parser;     /* parser used to read the stream */
+    FT_Int              num_chars;  /* number of characters in encoding */
+    PS_Keyword_HashRec  keywords;   /* hash of `cid_field_records'      */
 
   } CID_Loader;
 
@@ -116,6 +116,9 @@
 #else
     0,
 #endif
+
+    ps_keyword_hash_init,
+    ps_keyword_hash_lookup
   };
 
 
@@ -80,6 +80,51 @@
 #endif /* 'A' == 193 */
 
 
+  /* The value of a hexadecimal digit, or a value larger than 15 */
+  /* (16 for ASCII) for all other characters.                     */
+
+#if 'A' == 65
+  /* ASCII */
+
+  static const FT_Byte  ft_hex_table[256] =
+  {
+    /* 0x00 */
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    /* 0x20 */
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 16, 16, 16, 16, 16, 16,
+    /* 0x40 */
+    16, 10, 11, 12, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    /* 0x60 */
+    16, 10, 11, 12, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    /* 0x80 */
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    /* 0xA0 */
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    /* 0xC0 */
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    /* 0xE0 */
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+  };
+
+#define PS_HEX_VALUE( c )  ( (FT_UInt)ft_hex_table[c] )
+
+#else /* 'A' != 65 */
+
+#define PS_HEX_VALUE( c )                                     \
+          ( (c) OP 0x80 ? 16U                                 \
+                        : (FT_UInt)ft_char_table[(c) & 0x7F] )
+
+#endif /* 'A' != 65 */
+
+
   FT_LOCAL_DEF( FT_Long )
   PS_Conv_Strtol( FT_Byte**  cursor,
                   FT_Byte*   limit,
@@ -480,9 +525,29 @@
     /* we try to process two nibbles at a time to be as fast as possible */
     for ( ; r < n; r++ )
     {
-      FT_UInt  c = p[r];
+      FT_UInt  c;
+
+
+      /* fast path: decode pairs of hex digits at byte boundaries */
+      /* until we hit whitespace or the end of the data           */
+      while ( pad == 0x01 && r + 1 < n )
+      {
+        FT_UInt  hi = PS_HEX_VALUE( p[r] );
+        FT_UInt  lo = PS_HEX_VALUE( p[r + 1] );
 
 
+        if ( ( hi | lo ) >= 16 )
+          break;
+
+        buffer[w++] = (FT_Byte)( ( hi << 4 ) | lo );
+        r          += 2;
+      }
+
+      if ( r >= n )
+        break;
+
+      c = p[r];
+
       if ( IS_PS_SPACE( c ) )
         continue;
 
@@ -568,13 +633,42 @@
     if ( n > (FT_UInt)(limit - p) )
       n = (FT_UInt)(limit - p);
 
-    for ( r = 0; r < n; r++ )
+    /* The key update `s = (c + s) * 52845 + 22719 (mod 65536)' is a    */
+    /* linear recurrence; we can thus advance the key by four bytes at   */
+    /* once, using the powers of 52845 modulo 65536 (52845, 39529,       */
+    /* 15541, and 32529).  The terms depending on the ciphertext only    */
+    /* (`t1' to `t4') don't depend on the previous key, which shortens   */
+    /* the serial dependency chain to one multiplication per four bytes. */
+    /* Only the lower 16 bits of `s' are significant, so there is no     */
+    /* need to mask the intermediate values.                             */
+    for ( r = 0; r + 4 <= n; r += 4 )
+    {
+      FT_UInt  c0 = p[r];
+      FT_UInt  c1 = p[r + 1];
+      FT_UInt  c2 = p[r + 2];
+      FT_UInt  c3 = p[r + 3];
+
+      FT_UInt  t1 = c0 * 52845U + 22719;
+      FT_UInt  t2 = ( c1 + t1 ) * 52845U + 22719;
+      FT_UInt  t3 = ( c2 + t2 ) * 52845U + 22719;
+      FT_UInt  t4 = ( c3 + t3 ) * 52845U + 22719;
+
+
+      buffer[r    ] = (FT_Byte)( c0 ^ ( s >> 8 ) );
+      buffer[r + 1] = (FT_Byte)( c1 ^ ( ( s * 52845U + t1 ) >> 8 ) );
+      buffer[r + 2] = (FT_Byte)( c2 ^ ( ( s * 39529U + t2 ) >> 8 ) );
+      buffer[r + 3] = (FT_Byte)( c3 ^ ( ( s * 15541U + t3 ) >> 8 ) );
+
+      s = s * 32529U + t4;
+    }
+
+    for ( ; r < n; r++ )
     {
       FT_UInt  val = p[r];
       FT_UInt  b   = ( val ^ ( s >> 8 ) );
 
 
-      s         = ( (val + s)*52845U + 22719 ) & 0xFFFFU;
+      s         = ( val + s ) * 52845U + 22719;
       buffer[r] = (FT_Byte) b;
     }
 
@@ -285,6 +285,59 @@
   /*************************************************************************/
 
 
+  /* The scanning functions below classify characters with a single  */
+  /* table lookup instead of a chain of comparisons (see the IS_PS_XXX */
+  /* macros in `psaux.h', which define the same classes).              */
+
+#define PS_CHAR_SPACE    1
+#define PS_CHAR_NEWLINE  2
+#define PS_CHAR_SPECIAL  4
+
+#define PS_CHAR_DELIM  ( PS_CHAR_SPACE | PS_CHAR_SPECIAL )
+
+#if 'A' == 65
+  /* ASCII */
+
+  static const FT_Byte  ps_char_class[256] =
+  {
+    /* 0x00 */
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 3, 0, 1, 3, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0x20 */
+    1, 0, 0, 0, 0, 4, 0, 0, 4, 4, 0, 0, 0, 0, 0, 4,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 4, 0,
+    /* 0x40 */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 4, 0, 0,
+    /* 0x60 */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 4, 0, 0,
+    /* 0x80 */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0xA0 */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0xC0 */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0xE0 */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  };
+
+#define PS_CHAR_CLASS( c )  ps_char_class[c]
+
+#else /* 'A' != 65 */
+
+#define PS_CHAR_CLASS( c )                                \
+          ( ( IS_PS_SPACE( c )   ? PS_CHAR_SPACE   : 0 ) | \
+            ( IS_PS_NEWLINE( c ) ? PS_CHAR_NEWLINE : 0 ) | \
+            ( IS_PS_SPECIAL( c ) ? PS_CHAR_SPECIAL : 0 ) )
+
+#endif /* 'A' != 65 */
+
+
   /* first character must be already part of the comment */
 
   static void
@@ -294,12 +347,8 @@
     FT_Byte*  cur = *acur;
 
 
-    while ( cur < limit )
-    {
-      if ( IS_PS_NEWLINE( *cur ) )
-        break;
+    while ( cur < limit && !( PS_CHAR_CLASS( *cur ) & PS_CHAR_NEWLINE ) )
       cur++;
-    }
 
     *acur = cur;
   }
@@ -314,7 +363,7 @@
 
     while ( cur < limit )
     {
-      if ( !IS_PS_SPACE( *cur ) )
+      if ( !( PS_CHAR_CLASS( *cur ) & PS_CHAR_SPACE ) )
       {
         if ( *cur == '%' )
           /* According to the PLRM, a comment is equal to a space. */
@@ -577,16 +626,11 @@
     if ( *cur == '/' )
       cur++;
 
-    /* anything else */
-    while ( cur < limit )
-    {
-      /* *cur might be invalid (e.g., ')' or '}'), but this   */
-      /* is handled by the test `cur == parser->cursor' below */
-      if ( IS_PS_DELIM( *cur ) )
-        break;
-
+    /* anything else; *cur might be invalid (e.g., `)' or `}'), */
+    /* but this is handled by the test `cur == parser->cursor'  */
+    /* below                                                    */
+    while ( cur < limit && !( PS_CHAR_CLASS( *cur ) & PS_CHAR_DELIM ) )
       cur++;
-    }
 
   Exit:
     if ( cur < limit && cur == parser->cursor )
@@ -1500,6 +1544,95 @@
   }
 
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /*****                                                               *****/
+  /*****                         KEYWORD HASH                          *****/
+  /*****                                                               *****/
+  /*************************************************************************/
+  /*************************************************************************/
+
+#define PS_KEYWORD_HASH_MASK  ( PS_KEYWORD_HASH_SIZE - 1 )
+
+
+  static FT_UInt
+  ps_keyword_hash_value( const FT_Byte*  name,
+                         FT_PtrDist      len )
+  {
+    FT_UInt  h = 0;
+
+
+    while ( len-- > 0 )
+      h = h * 31 + *name++;
+
+    return h & PS_KEYWORD_HASH_MASK;
+  }
+
+
+  /* Build a hash of the keywords in `fields'.  Since the parsers use the */
+  /* first entry of a given name only (the callbacks for `FontBBox' and   */
+  /* friends follow the field entries), duplicates are not inserted.     */
+  FT_LOCAL_DEF( void )
+  ps_keyword_hash_init( PS_Keyword_Hash     hash,
+                        const T1_FieldRec*  fields )
+  {
+    const T1_FieldRec*  field;
+
+
+    FT_MEM_ZERO( hash->slots, sizeof ( hash->slots ) );
+    hash->fields = fields;
+
+    for ( field = fields; field->ident; field++ )
+    {
+      FT_PtrDist  len = (FT_PtrDist)ft_strlen( field->ident );
+
+
+      FT_ASSERT( field - fields < PS_KEYWORD_HASH_SIZE / 2 );
+
+      if ( !ps_keyword_hash_lookup( hash,
+                                    (const FT_Byte*)field->ident,
+                                    len ) )
+      {
+        FT_UInt  h = ps_keyword_hash_value( (const FT_Byte*)field->ident,
+                                            len );
+
+
+        while ( hash->slots[h] )
+          h = ( h + 1 ) & PS_KEYWORD_HASH_MASK;
+
+        hash->slots[h] = (FT_UShort)( field - fields + 1 );
+      }
+    }
+  }
+
+
+  /* Return the first field named `name' (which is not null-terminated), */
+  /* or NULL if there is none.                                           */
+  FT_LOCAL_DEF( const T1_FieldRec* )
+  ps_keyword_hash_lookup( PS_Keyword_Hash  hash,
+                          const FT_Byte*   name,
+                          FT_PtrDist       len )
+  {
+    FT_UInt  h = ps_keyword_hash_value( name, len );
+
+
+    while ( hash->slots[h] )
+    {
+      const T1_FieldRec*  field = hash->fields + hash->slots[h] - 1;
+      const char*         ident = field->ident;
+
+
+      if ( ft_strncmp( ident, (const char*)name, (FT_Offset)len ) == 0 &&
+           ident[len] == '\0'                                       )
+        return field;
+
+      h = ( h + 1 ) & PS_KEYWORD_HASH_MASK;
+    }
+
+    return NULL;
+  }
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*****                                                               *****/
@@ -143,6 +143,16 @@ FT_BEGIN_HEADER
   ps_parser_done( PS_Parser  parser );
 
 
+  FT_LOCAL( void )
+  ps_keyword_hash_init( PS_Keyword_Hash     hash,
+                        const T1_FieldRec*  fields );
+
+  FT_LOCAL( const T1_FieldRec* )
+  ps_keyword_hash_lookup( PS_Keyword_Hash  hash,
+                          const FT_Byte*   name,
+                          FT_PtrDist       len );
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*****                                                               *****/
@@ -1094,14 +1094,24 @@
           /* close hints recording session */
           if ( hinter )
           {
+#ifdef FT_CONFIG_OPTION_COUNTERS
+            FT_Library  library = FT_FACE_LIBRARY( builder->face );
+#endif
+
+            FT_TIMER_VAR( start )
+
+
             if ( hinter->close( hinter->hints, builder->current->n_points ) )
               goto Syntax_Error;
 
             /* apply hints to the loaded glyph outline now */
+            FT_TIMER_START( library, start );
             error = hinter->apply( hinter->hints,
                                    builder->current,
                                    (PSH_Globals)builder->hints_globals,
                                    decoder->hint_mode );
+            FT_TIMER_STOP( library, FT_COUNTER_HINTING_TIME, start );
+
             if ( error )
               goto Fail;
           }
@@ -1254,6 +1254,147 @@
   }
 
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /*****                                                               *****/
+  /*****                     GLYPH ANALYSIS CACHE                      *****/
+  /*****                                                               *****/
+  /*************************************************************************/
+  /*************************************************************************/
+
+  /* compute the cache slot of an outline; we only look at a few */
+  /* points since entries are validated anyway                   */
+  static FT_UInt
+  psh_glyph_cache_hash( FT_Outline*  outline )
+  {
+    FT_Vector*  vec = outline->points;
+    FT_UInt     n   = (FT_UInt)outline->n_points;
+    FT_ULong    h;
+
+
+    h = n * 31 + (FT_ULong)outline->n_contours;
+    h = h * 31 + ( (FT_ULong)vec[0].x ^ ( (FT_ULong)vec[0].y << 8 ) );
+    h = h * 31 + ( (FT_ULong)vec[n / 2].x ^ ( (FT_ULong)vec[n / 2].y << 8 ) );
+    h = h * 31 + ( (FT_ULong)vec[n - 1].x ^ ( (FT_ULong)vec[n - 1].y << 8 ) );
+
+    return (FT_UInt)( ( h ^ ( h >> 16 ) ) % PSH_GLYPH_CACHE_SIZE );
+  }
+
+
+  static void
+  psh_glyph_cache_clear( PSH_Glyph_Cache        cache,
+                         PSH_Glyph_Cache_Entry  entry,
+                         FT_Memory              memory )
+  {
+    cache->total_size -= entry->size;
+
+    FT_FREE( entry->block );
+    FT_MEM_ZERO( entry, sizeof ( *entry ) );
+  }
+
+
+  /* return the cache entry of `outline' if it is valid, NULL otherwise */
+  static PSH_Glyph_Cache_Entry
+  psh_glyph_cache_lookup( PS_Hints     ps_hints,
+                          FT_Outline*  outline )
+  {
+    PSH_Glyph_Cache        cache = ps_hints->glyph_cache;
+    PSH_Glyph_Cache_Entry  entry;
+    FT_UInt                n_points;
+
+
+    if ( !cache )
+      return NULL;
+
+    entry    = cache->entries + psh_glyph_cache_hash( outline );
+    n_points = (FT_UInt)outline->n_points;
+
+    if ( entry->num_points   != n_points                       ||
+         entry->num_contours != (FT_UInt)outline->n_contours   ||
+         ft_memcmp( entry->contours, outline->contours,
+                    entry->num_contours * sizeof ( short ) )   ||
+         ft_memcmp( entry->tags, outline->tags, n_points )     ||
+         ft_memcmp( entry->vecs, outline->points,
+                    n_points * sizeof ( FT_Vector ) )          )
+      return NULL;
+
+    return entry;
+  }
+
+
+  /* Create a new cache entry for `outline', replacing the one in the  */
+  /* same slot.  The analysis data is filled in later by the caller,   */
+  /* which finally sets `num_points'.  Return NULL if the glyph cannot */
+  /* be cached.                                                        */
+  static PSH_Glyph_Cache_Entry
+  psh_glyph_cache_new_entry( PS_Hints     ps_hints,
+                             FT_Outline*  outline )
+  {
+    FT_Memory              memory = ps_hints->memory;
+    FT_Error               error;
+    PSH_Glyph_Cache        cache;
+    PSH_Glyph_Cache_Entry  entry;
+    FT_UInt                n_points   = (FT_UInt)outline->n_points;
+    FT_UInt                n_contours = (FT_UInt)outline->n_contours;
+    FT_ULong               size;
+
+
+    if ( !ps_hints->glyph_cache && FT_NEW( ps_hints->glyph_cache ) )
+      return NULL;
+
+    cache = ps_hints->glyph_cache;
+    entry = cache->entries + psh_glyph_cache_hash( outline );
+
+    size = n_points   * ( sizeof ( FT_Vector )           +
+                          sizeof ( PSH_Cached_PointRec ) + 1 ) +
+           n_contours * sizeof ( short );
+
+    if ( cache->total_size - entry->size + size > PSH_GLYPH_CACHE_MAX_BYTES )
+      return NULL;
+
+    psh_glyph_cache_clear( cache, entry, memory );
+
+    if ( FT_ALLOC( entry->block, size ) )
+      return NULL;
+
+    /* the arrays are sorted by decreasing alignment requirements */
+    entry->vecs     = (FT_Vector*)entry->block;
+    entry->points   = (PSH_Cached_Point)( entry->vecs + n_points );
+    entry->contours = (short*)( entry->points + n_points );
+    entry->tags     = (char*)( entry->contours + n_contours );
+
+    FT_ARRAY_COPY( entry->vecs, outline->points, n_points );
+    FT_ARRAY_COPY( entry->contours, outline->contours, n_contours );
+    FT_ARRAY_COPY( entry->tags, outline->tags, n_points );
+
+    entry->num_contours = n_contours;
+    entry->size         = size;
+    cache->total_size  += size;
+
+    return entry;
+  }
+
+
+  FT_LOCAL_DEF( void )
+  psh_glyph_cache_done( PS_Hints  ps_hints )
+  {
+    FT_Memory        memory = ps_hints->memory;
+    PSH_Glyph_Cache  cache  = ps_hints->glyph_cache;
+
+
+    if ( cache )
+    {
+      FT_UInt  n;
+
+
+      for ( n = 0; n < PSH_GLYPH_CACHE_SIZE; n++ )
+        FT_FREE( cache->entries[n].block );
+
+      FT_FREE( ps_hints->glyph_cache );
+    }
+  }
+
+
   static FT_Error
   psh_glyph_init( PSH_Glyph    glyph,
                   FT_Outline*  outline,
@@ -1317,6 +1458,28 @@
       }
     }
 
+    glyph->outline = outline;
+    glyph->globals = globals;
+
+    /* reuse the analysis of an identical outline if possible */
+    glyph->cache_entry = psh_glyph_cache_lookup( ps_hints, outline );
+    if ( glyph->cache_entry )
+    {
+      PSH_Point         point  = glyph->points;
+      PSH_Cached_Point  cpoint = glyph->cache_entry->points;
+      FT_UInt           n;
+
+
+      for ( n = 0; n < glyph->num_points; n++, point++, cpoint++ )
+      {
+        point->flags   = cpoint->flags;
+        point->dir_in  = cpoint->dir_in;
+        point->dir_out = cpoint->dir_out;
+      }
+
+      glyph->cache_hit = 1;
+    }
+    else
     {
       PSH_Point   points = glyph->points;
       PSH_Point   point  = points;
@@ -1355,16 +1518,29 @@
             point->flags |= PSH_POINT_SMOOTH;
         }
       }
-    }
-
-    glyph->outline = outline;
-    glyph->globals = globals;
 
 #ifdef COMPUTE_INFLEXS
-    psh_glyph_load_points( glyph, 0 );
-    psh_glyph_compute_inflections( glyph );
+      psh_glyph_load_points( glyph, 0 );
+      psh_glyph_compute_inflections( glyph );
 #endif /* COMPUTE_INFLEXS */
 
+      /* the extrema flags get stored by `ps_hints_apply' */
+      glyph->cache_entry = psh_glyph_cache_new_entry( ps_hints, outline );
+      if ( glyph->cache_entry )
+      {
+        PSH_Cached_Point  cpoint = glyph->cache_entry->points;
+
+
+        point = points;
+        for ( n = 0; n < glyph->num_points; n++, point++, cpoint++ )
+        {
+          cpoint->flags   = (FT_UShort)point->flags;
+          cpoint->dir_in  = point->dir_in;
+          cpoint->dir_out = point->dir_out;
+        }
+      }
+    }
+
     /* now deal with hints tables */
     error = psh_hint_table_init( &glyph->hint_tables [0],
                                  &ps_hints->dimension[0].hints,
@@ -2264,7 +2440,35 @@
         psh_glyph_load_points( glyph, dimension );
 
         /* compute local extrema */
-        psh_glyph_compute_extrema( glyph );
+        if ( glyph->cache_hit )
+        {
+          PSH_Point         point  = glyph->points;
+          PSH_Cached_Point  cpoint = glyph->cache_entry->points;
+          FT_UInt           n;
+
+
+          for ( n = 0; n < glyph->num_points; n++, point++, cpoint++ )
+            point->flags2 = cpoint->flags2[dimension];
+        }
+        else
+        {
+          psh_glyph_compute_extrema( glyph );
+
+          if ( glyph->cache_entry )
+          {
+            PSH_Point         point  = glyph->points;
+            PSH_Cached_Point  cpoint = glyph->cache_entry->points;
+            FT_UInt           n;
+
+
+            for ( n = 0; n < glyph->num_points; n++, point++, cpoint++ )
+              cpoint->flags2[dimension] = (FT_UShort)point->flags2;
+
+            /* the entry is complete now */
+            if ( dimension == 1 )
+              glyph->cache_entry->num_points = glyph->num_points;
+          }
+        }
 
         /* compute aligned stem/hints positions */
         psh_hint_table_align_hints( &glyph->hint_tables[dimension],
@@ -191,28 +191,82 @@ FT_BEGIN_HEADER
   } PSH_ContourRec;
 
 
+  /*
+   *  The point flags, directions, and extrema computed by the glyph
+   *  analyzer only depend on the outline in font units.  They are kept
+   *  in a small cache of the hints recorder (and thus shared by all
+   *  faces and sizes), indexed by a hash of the outline; an entry is
+   *  only used if the outline is exactly the same.  The cache is
+   *  direct-mapped, and its total size is limited to
+   *  `PSH_GLYPH_CACHE_MAX_BYTES'.
+   *
+   *  Hint tables and strong points are not cached since the latter
+   *  depend on the scaling.
+   */
+#define PSH_GLYPH_CACHE_SIZE       128
+#define PSH_GLYPH_CACHE_MAX_BYTES  0x40000L
+
+
+  typedef struct  PSH_Cached_PointRec_
+  {
+    FT_UShort  flags;
+    FT_UShort  flags2[2];  /* extrema flags for each dimension */
+    FT_Char    dir_in;
+    FT_Char    dir_out;
+
+  } PSH_Cached_PointRec, *PSH_Cached_Point;
+
+
+  typedef struct  PSH_Glyph_Cache_EntryRec_
+  {
+    FT_UInt           num_points;    /* 0 if the entry is unused */
+    FT_UInt           num_contours;
+    FT_ULong          size;          /* size of `block' in bytes */
+    FT_Byte*          block;
+
+    /* a copy of the outline, to validate the entry */
+    FT_Vector*        vecs;
+    short*            contours;
+    char*             tags;
+
+    PSH_Cached_Point  points;
+
+  } PSH_Glyph_Cache_EntryRec, *PSH_Glyph_Cache_Entry;
+
+
+  typedef struct  PSH_Glyph_CacheRec_
+  {
+    FT_ULong                  total_size;
+    PSH_Glyph_Cache_EntryRec  entries[PSH_GLYPH_CACHE_SIZE];
+
+  } PSH_Glyph_CacheRec;
+
+
   typedef struct  PSH_GlyphRec_
   {
-    FT_UInt            num_points;
-    FT_UInt            num_contours;
+    FT_UInt                num_points;
+    FT_UInt                num_contours;
 
-    PSH_Point          points;
-    PSH_Contour        contours;
+    PSH_Point              points;
+    PSH_Contour            contours;
 
-    FT_Memory          memory;
-    FT_Outline*        outline;
-    PSH_Globals        globals;
-    PSH_Hint_TableRec  hint_tables[2];
+    FT_Memory              memory;
+    FT_Outline*            outline;
+    PSH_Globals            globals;
+    PSH_Hint_TableRec      hint_tables[2];
 
-    FT_Bool            vertical;
-    FT_Int             major_dir;
-    FT_Int             minor_dir;
+    FT_Bool                vertical;
+    FT_Int                 major_dir;
+    FT_Int                 minor_dir;
 
-    FT_Bool            do_horz_hints;
-    FT_Bool            do_vert_hints;
-    FT_Bool            do_horz_snapping;
-    FT_Bool            do_vert_snapping;
-    FT_Bool            do_stem_adjust;
+    FT_Bool                do_horz_hints;
+    FT_Bool                do_vert_hints;
+    FT_Bool                do_horz_snapping;
+    FT_Bool                do_vert_snapping;
+    FT_Bool                do_stem_adjust;
+
+    PSH_Glyph_Cache_Entry  cache_entry;  /* the glyph's entry, if any */
+    FT_Bool                cache_hit;    /* whether it was valid      */
 
   } PSH_GlyphRec, *PSH_Glyph;
 
@@ -236,6 +290,9 @@ FT_BEGIN_HEADER
                   PSH_Globals     globals,
                   FT_Render_Mode  hint_mode );
 
+  FT_LOCAL( void )
+  psh_glyph_cache_done( PS_Hints  ps_hints );
+
 
 FT_END_HEADER
 
@@ -792,6 +792,8 @@
     ps_dimension_done( &hints->dimension[0], memory );
     ps_dimension_done( &hints->dimension[1], memory );
 
+    psh_glyph_cache_done( hints );
+
     hints->error  = FT_Err_Ok;
     hints->memory = 0;
   }
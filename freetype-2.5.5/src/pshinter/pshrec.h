@@ -125,6 +125,10 @@ FT_BEGIN_HEADER
   } PS_DimensionRec, *PS_Dimension;
 
 
+  /* cache of glyph outline analyses, see `pshalgo.h' */
+  typedef struct PSH_Glyph_CacheRec_*  PSH_Glyph_Cache;
+
+
   /* glyph hints descriptor                                */
   /* dimension 0 => X coordinates + vertical hints/stems   */
   /* dimension 1 => Y coordinates + horizontal hints/stems */
@@ -135,6 +139,7 @@ FT_BEGIN_HEADER
     FT_UInt32        magic;
     PS_Hint_Type     hint_type;
     PS_DimensionRec  dimension[2];
+    PSH_Glyph_Cache  glyph_cache;
 
   } PS_HintsRec, *PS_Hints;
 
@@ -3603,6 +3603,10 @@
     if ( params->flags & FT_RASTER_FLAG_DIRECT )
       return FT_THROW( Unsupported );
 
+    /* neither does it stroke */
+    if ( params->flags & FT_RASTER_FLAG_STROKE )
+      return FT_THROW( Unsupported );
+
     if ( !target_map )
       return FT_THROW( Invalid );
 
@@ -19,6 +19,7 @@
 #include <ft2build.h>
 #include FT_INTERNAL_DEBUG_H
 #include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_SIMD_H
 #include FT_OUTLINE_H
 #include "ftrend1.h"
 #include "ftraster.h"
@@ -71,11 +72,8 @@
       goto Exit;
     }
 
-    if ( matrix )
-      FT_Outline_Transform( &slot->outline, matrix );
-
-    if ( delta )
-      FT_Outline_Translate( &slot->outline, delta->x, delta->y );
+    ft_vector_array_transform( slot->outline.points, slot->outline.n_points,
+                               matrix, delta );
 
   Exit:
     return error;
@@ -242,6 +242,7 @@ typedef ptrdiff_t  FT_PtrDist;
 #include FT_INTERNAL_OBJECTS_H
 #include FT_INTERNAL_DEBUG_H
 #include FT_OUTLINE_H
+#include FT_TRIGONOMETRY_H
 
 #include "ftsmerrs.h"
 
@@ -251,6 +252,9 @@ typedef ptrdiff_t  FT_PtrDist;
 #define Smooth_Err_Memory_Overflow  Smooth_Err_Out_Of_Memory
 #define ErrRaster_Memory_Overflow   Smooth_Err_Out_Of_Memory
 
+  /* stroking needs FreeType's trigonometric functions */
+#define GRAY_STROKE
+
 
 #endif /* !_STANDALONE_ */
 
@@ -442,12 +446,27 @@ typedef ptrdiff_t  FT_PtrDist;
     int  band_size;
     int  band_shoot;
 
+    unsigned long  total_cells;   /* statistics for the current glyph */
+    unsigned long  band_splits;
+
     void*       buffer;
     long        buffer_size;
 
     PCell*     ycells;
     TPos       ycount;
 
+    TPos       stroke_radius;  /* in subpixels; 0 if not stroking     */
+#ifdef GRAY_STROKE
+    FT_Angle   stroke_step;    /* maximum angle of an arc segment     */
+    TPos       stroke_limit;   /* minimum dot product of arc normals  */
+    int        stroke_shift;   /* downscaling of normals for the same */
+    int        stroke_open;    /* does the contour have a segment?    */
+    FT_Vector  stroke_first;   /* normal and length of its first ...  */
+    TPos       stroke_first_length;
+    FT_Vector  stroke_last;    /* ... and of its previous segment     */
+    TPos       stroke_last_length;
+#endif
+
   } gray_TWorker, *gray_PWorker;
 
 #if defined( _MSC_VER )
@@ -470,6 +489,8 @@ typedef ptrdiff_t  FT_PtrDist;
     void*         memory;
     gray_PWorker  worker;
 
+    unsigned long  stats[2];   /* see FT_GRAYS_MODE_STATS */
+
   } gray_TRaster, *gray_PRaster;
 
 
@@ -531,6 +552,18 @@ typedef ptrdiff_t  FT_PtrDist;
       if ( y > ras.max_ey ) ras.max_ey = y;
     }
 
+    /* a stroke extends beyond the outline by the pen radius */
+    if ( ras.stroke_radius )
+    {
+      TPos  radius = DOWNSCALE( ras.stroke_radius ) + 1;
+
+
+      ras.min_ex -= radius;
+      ras.min_ey -= radius;
+      ras.max_ex += radius;
+      ras.max_ey += radius;
+    }
+
     /* truncate the bounding box to integer pixels */
     ras.min_ex = ras.min_ex >> 6;
     ras.min_ey = ras.min_ey >> 6;
@@ -911,6 +944,254 @@ typedef ptrdiff_t  FT_PtrDist;
     ras.last_ey = SUBPIXELS( ey2 );
   }
 
+#ifdef GRAY_STROKE
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* Stroking.  With FT_RASTER_FLAG_STROKE, the flattened outline isn't    */
+  /* filled; instead, the borders of its stroke are fed directly into the  */
+  /* cells, without building an intermediate outline.                      */
+  /*                                                                       */
+  /* Every segment contributes its left border and its reversed right      */
+  /* border, each at distance `stroke_radius'.  At a vertex, the outer     */
+  /* borders are connected with an arc around the vertex, giving a round   */
+  /* join.  The inner borders are connected through their intersection if  */
+  /* it is near enough, and through the vertex otherwise; the latter       */
+  /* produces small overlapping loops, just like the inner joins of the    */
+  /* stroker.  As the cells merely accumulate signed areas, these pieces   */
+  /* can be rendered in any order; the non-zero winding rule then yields   */
+  /* the union of all loops.                                               */
+  /*                                                                       */
+  /*************************************************************************/
+
+
+  /* start a new edge path at a given position */
+  static void
+  gray_stroke_move( RAS_ARG_ TPos  x,
+                             TPos  y )
+  {
+    if ( !ras.invalid )
+      gray_record_cell( RAS_VAR );
+
+    gray_start_cell( RAS_VAR_ TRUNC( x ), TRUNC( y ) );
+
+    ras.x = x;
+    ras.y = y;
+  }
+
+
+  /* render a clockwise arc around (x,y) from offset `n1' to `n2' */
+  static void
+  gray_stroke_arc( RAS_ARG_ TPos        x,
+                            TPos        y,
+                            FT_Vector*  n1,
+                            FT_Vector*  n2 )
+  {
+    int   shift = ras.stroke_shift;
+    TPos  dot;
+
+
+    gray_stroke_move( RAS_VAR_ x + n1->x, y + n1->y );
+
+    dot = ( n1->x >> shift ) * ( n2->x >> shift ) +
+          ( n1->y >> shift ) * ( n2->y >> shift );
+
+    /* add intermediate points if the chord is too far from the arc */
+    if ( dot < ras.stroke_limit )
+    {
+      FT_Angle   angle = FT_Atan2( n1->x, n1->y );
+      FT_Angle   theta = FT_Angle_Diff( angle, FT_Atan2( n2->x, n2->y ) );
+      FT_Vector  v;
+      FT_Int     n, i;
+
+
+      if ( theta > 0 )
+        theta -= FT_ANGLE_2PI;
+
+      n = (FT_Int)( ( ras.stroke_step - 1 - theta ) / ras.stroke_step );
+
+      for ( i = 1; i < n; i++ )
+      {
+        FT_Vector_From_Polar( &v, ras.stroke_radius,
+                              angle + FT_MulDiv( theta, i, n ) );
+        gray_render_line( RAS_VAR_ x + v.x, y + v.y );
+      }
+    }
+
+    gray_render_line( RAS_VAR_ x + n2->x, y + n2->y );
+  }
+
+
+  /* join the borders at vertex (x,y) between segments of length `l1' */
+  /* and `l2' with normals `n1' and `n2'                                */
+  static void
+  gray_stroke_join( RAS_ARG_ TPos        x,
+                             TPos        y,
+                             FT_Vector*  n1,
+                             TPos        l1,
+                             FT_Vector*  n2,
+                             TPos        l2 )
+  {
+    int        shift = ras.stroke_shift;
+    TPos       rr, dot, cross;
+    FT_Vector  m, v1, v2;
+
+
+    if ( n1->x == n2->x && n1->y == n2->y )
+      return;
+
+    rr    = ( ras.stroke_radius >> shift ) * ( ras.stroke_radius >> shift );
+    dot   = ( n1->x >> shift ) * ( n2->x >> shift ) +
+            ( n1->y >> shift ) * ( n2->y >> shift );
+    cross = ( n1->x >> shift ) * ( n2->y >> shift ) -
+            ( n1->y >> shift ) * ( n2->x >> shift );
+
+    /* The inner borders meet at the vertex.  If they intersect within */
+    /* the first halves of both segments, we use the intersection to   */
+    /* avoid overlaps; the mitered offset `m' reaches it from (x,y).   */
+    m.x = 0;
+    m.y = 0;
+
+    if ( rr + dot > 0 )
+    {
+      TPos  t = FT_MulDiv( ras.stroke_radius,
+                           cross < 0 ? -cross : cross,
+                           rr + dot );
+
+
+      if ( 2 * t <= l1 && 2 * t <= l2 )
+      {
+        m.x = FT_MulDiv( n1->x + n2->x, rr, rr + dot );
+        m.y = FT_MulDiv( n1->y + n2->y, rr, rr + dot );
+      }
+    }
+
+    if ( cross > 0 )
+    {
+      /* left turn: round right border (reversed), inner left border */
+      v1.x = -n2->x;
+      v1.y = -n2->y;
+      v2.x = -n1->x;
+      v2.y = -n1->y;
+
+      gray_stroke_arc( RAS_VAR_ x, y, &v1, &v2 );
+
+      gray_stroke_move( RAS_VAR_ x + n1->x, y + n1->y );
+      gray_render_line( RAS_VAR_ x + m.x, y + m.y );
+      gray_render_line( RAS_VAR_ x + n2->x, y + n2->y );
+    }
+    else
+    {
+      /* right turn (or U-turn): round left border, inner right border */
+      gray_stroke_arc( RAS_VAR_ x, y, n1, n2 );
+
+      gray_stroke_move( RAS_VAR_ x - n2->x, y - n2->y );
+      gray_render_line( RAS_VAR_ x - m.x, y - m.y );
+      gray_render_line( RAS_VAR_ x - n1->x, y - n1->y );
+    }
+  }
+
+
+  /* stroke a segment from the current path position */
+  static void
+  gray_stroke_line( RAS_ARG_ TPos  to_x,
+                             TPos  to_y )
+  {
+    TPos       x = ras.x;
+    TPos       y = ras.y;
+    FT_Vector  d, n;
+    FT_Fixed   length;
+
+
+    d.x = to_x - x;
+    d.y = to_y - y;
+
+    if ( d.x == 0 && d.y == 0 )
+      return;
+
+    length = FT_Vector_Length( &d );
+    n.x    = -FT_MulDiv( d.y, ras.stroke_radius, length );
+    n.y    =  FT_MulDiv( d.x, ras.stroke_radius, length );
+
+    if ( ras.stroke_open )
+      gray_stroke_join( RAS_VAR_ x, y,
+                        &ras.stroke_last, ras.stroke_last_length,
+                        &n, length );
+    else
+    {
+      ras.stroke_first        = n;
+      ras.stroke_first_length = length;
+      ras.stroke_open         = 1;
+    }
+
+    /* left border */
+    gray_stroke_move( RAS_VAR_ x + n.x, y + n.y );
+    gray_render_line( RAS_VAR_ to_x + n.x, to_y + n.y );
+
+    /* right border, reversed */
+    gray_stroke_move( RAS_VAR_ to_x - n.x, to_y - n.y );
+    gray_render_line( RAS_VAR_ x - n.x, y - n.y );
+
+    ras.stroke_last        = n;
+    ras.stroke_last_length = length;
+
+    /* continue the path at the end of the segment */
+    ras.x = to_x;
+    ras.y = to_y;
+  }
+
+
+  /* join the last and the first segment of the current contour, */
+  /* which ends at the current path position                     */
+  static void
+  gray_stroke_close( RAS_ARG )
+  {
+    if ( ras.stroke_open )
+    {
+      TPos  x = ras.x;
+      TPos  y = ras.y;
+
+
+      gray_stroke_join( RAS_VAR_ x, y,
+                        &ras.stroke_last, ras.stroke_last_length,
+                        &ras.stroke_first, ras.stroke_first_length );
+
+      ras.stroke_open = 0;
+      ras.x           = x;
+      ras.y           = y;
+    }
+  }
+
+
+  /* set up the stroke parameters for a radius in 26.6 units */
+  static void
+  gray_stroke_init( RAS_ARG_ FT_Pos  radius )
+  {
+    TPos      r     = UPSCALE( radius );
+    FT_Angle  step  = FT_ANGLE_PI2;
+    int       shift = 0;
+
+
+    /* halve the arc steps until their chords deviate by 1/8 pixel */
+    /* at most                                                     */
+    while ( step > FT_ANGLE_PI / 1024                              &&
+            r - FT_MulFix( r, FT_Cos( step / 2 ) ) > ONE_PIXEL / 8 )
+      step /= 2;
+
+    /* keep dot and cross products of normals within 31 bits */
+    while ( ( r >> shift ) > 0x7FFF )
+      shift++;
+
+    ras.stroke_radius = r;
+    ras.stroke_step   = step;
+    ras.stroke_shift  = shift;
+    ras.stroke_limit  = FT_MulFix( ( r >> shift ) * ( r >> shift ),
+                                   FT_Cos( step ) );
+    ras.stroke_open   = 0;
+  }
+
+#endif /* GRAY_STROKE */
+
 
   static void
   gray_split_conic( FT_Vector*  base )
@@ -973,7 +1254,8 @@ typedef ptrdiff_t  FT_PtrDist;
     if ( y < min ) min = y;
     if ( y > max ) max = y;
 
-    if ( TRUNC( min ) >= ras.max_ey || TRUNC( max ) < ras.min_ey )
+    if ( TRUNC( min - ras.stroke_radius ) >= ras.max_ey ||
+         TRUNC( max + ras.stroke_radius ) <  ras.min_ey )
       goto Draw;
 
     level = 0;
@@ -998,7 +1280,12 @@ typedef ptrdiff_t  FT_PtrDist;
       }
 
     Draw:
-      gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
+#ifdef GRAY_STROKE
+      if ( ras.stroke_radius )
+        gray_stroke_line( RAS_VAR_ arc[0].x, arc[0].y );
+      else
+#endif
+        gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
       top--;
       arc -= 2;
 
@@ -1074,7 +1361,8 @@ typedef ptrdiff_t  FT_PtrDist;
     if ( y > max )
       max = y;
 
-    if ( TRUNC( min ) >= ras.max_ey || TRUNC( max ) < ras.min_ey )
+    if ( TRUNC( min - ras.stroke_radius ) >= ras.max_ey ||
+         TRUNC( max + ras.stroke_radius ) <  ras.min_ey )
       goto Draw;
 
     for (;;)
@@ -1136,7 +1424,12 @@ typedef ptrdiff_t  FT_PtrDist;
       continue;
 
     Draw:
-      gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
+#ifdef GRAY_STROKE
+      if ( ras.stroke_radius )
+        gray_stroke_line( RAS_VAR_ arc[0].x, arc[0].y );
+      else
+#endif
+        gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
 
       if ( arc == ras.bez_stack )
         return;
@@ -1199,6 +1492,31 @@ typedef ptrdiff_t  FT_PtrDist;
   }
 
 
+#ifdef GRAY_STROKE
+
+  static int
+  gray_stroke_move_to( const FT_Vector*  to,
+                       gray_PWorker      worker )
+  {
+    gray_stroke_close( RAS_VAR );
+
+    worker->x = UPSCALE( to->x );
+    worker->y = UPSCALE( to->y );
+    return 0;
+  }
+
+
+  static int
+  gray_stroke_line_to( const FT_Vector*  to,
+                       gray_PWorker      worker )
+  {
+    gray_stroke_line( RAS_VAR_ UPSCALE( to->x ), UPSCALE( to->y ) );
+    return 0;
+  }
+
+#endif /* GRAY_STROKE */
+
+
   static void
   gray_render_span( int             y,
                     int             count,
@@ -1753,6 +2071,20 @@ typedef ptrdiff_t  FT_PtrDist;
       0
     )
 
+#ifdef GRAY_STROKE
+
+    /* curves are flattened as usual, then stroked segment by segment */
+    FT_DEFINE_OUTLINE_FUNCS(stroke_func_interface,
+      (FT_Outline_MoveTo_Func) gray_stroke_move_to,
+      (FT_Outline_LineTo_Func) gray_stroke_line_to,
+      (FT_Outline_ConicTo_Func)gray_conic_to,
+      (FT_Outline_CubicTo_Func)gray_cubic_to,
+      0,
+      0
+    )
+
+#endif
+
   static int
   gray_convert_glyph_inner( RAS_ARG )
   {
@@ -1761,12 +2093,32 @@ typedef ptrdiff_t  FT_PtrDist;
 
 #ifdef FT_CONFIG_OPTION_PIC
       FT_Outline_Funcs func_interface;
+#ifdef GRAY_STROKE
+      FT_Outline_Funcs stroke_func_interface;
+#endif
       Init_Class_func_interface(&func_interface);
+#ifdef GRAY_STROKE
+      Init_Class_stroke_func_interface(&stroke_func_interface);
+#endif
 #endif
 
     if ( ft_setjmp( ras.jump_buffer ) == 0 )
     {
-      error = FT_Outline_Decompose( &ras.outline, &func_interface, &ras );
+#ifdef GRAY_STROKE
+      if ( ras.stroke_radius )
+      {
+        ras.stroke_open = 0;
+
+        error = FT_Outline_Decompose( &ras.outline,
+                                      &stroke_func_interface,
+                                      &ras );
+        if ( !error )
+          gray_stroke_close( RAS_VAR );
+      }
+      else
+#endif
+        error = FT_Outline_Decompose( &ras.outline, &func_interface, &ras );
+
       if ( !ras.invalid )
         gray_record_cell( RAS_VAR );
     }
@@ -1873,6 +2225,7 @@ typedef ptrdiff_t  FT_PtrDist;
 
         if ( !error )
         {
+          ras.total_cells += (unsigned long)ras.num_cells;
           gray_sweep( RAS_VAR_ &ras.target );
           band--;
           continue;
@@ -1899,6 +2252,8 @@ typedef ptrdiff_t  FT_PtrDist;
         if ( bottom-top >= ras.band_size )
           ras.band_shoot++;
 
+        ras.band_splits++;
+
         band[1].min = bottom;
         band[1].max = middle;
         band[0].min = middle;
@@ -1921,6 +2276,7 @@ typedef ptrdiff_t  FT_PtrDist;
     const FT_Outline*  outline    = (const FT_Outline*)params->source;
     const FT_Bitmap*   target_map = params->target;
     gray_PWorker       worker;
+    int                error;
 
 
     if ( !raster || !raster->buffer || !raster->buffer_size )
@@ -1960,6 +2316,20 @@ typedef ptrdiff_t  FT_PtrDist;
     if ( !( params->flags & FT_RASTER_FLAG_AA ) )
       return FT_THROW( Invalid_Mode );
 
+    ras.stroke_radius = 0;
+
+    if ( params->flags & FT_RASTER_FLAG_STROKE )
+    {
+#ifdef GRAY_STROKE
+      if ( params->stroke_radius <= 0 )
+        return FT_THROW( Invalid_Argument );
+
+      gray_stroke_init( RAS_VAR_ params->stroke_radius );
+#else
+      return FT_THROW( Invalid_Mode );
+#endif
+    }
+
     /* compute clipping box */
     if ( !( params->flags & FT_RASTER_FLAG_DIRECT ) )
     {
@@ -1987,6 +2357,10 @@ typedef ptrdiff_t  FT_PtrDist;
     ras.band_size      = raster->band_size;
     ras.num_gray_spans = 0;
 
+    /* the stroke borders overlap each other; they must be unified */
+    if ( ras.stroke_radius )
+      ras.outline.flags &= ~FT_OUTLINE_EVEN_ODD_FILL;
+
     if ( params->flags & FT_RASTER_FLAG_DIRECT )
     {
       ras.render_span      = (FT_Raster_Span_Func)params->gray_spans;
@@ -1999,7 +2373,15 @@ typedef ptrdiff_t  FT_PtrDist;
       ras.render_span_data = &ras;
     }
 
-    return gray_convert_glyph( RAS_VAR );
+    ras.total_cells = 0;
+    ras.band_splits = 0;
+
+    error = gray_convert_glyph( RAS_VAR );
+
+    raster->stats[0] += ras.total_cells;
+    raster->stats[1] += ras.band_splits;
+
+    return error;
   }
 
 
@@ -2105,12 +2487,21 @@ typedef ptrdiff_t  FT_PtrDist;
                         unsigned long  mode,
                         void*          args )
   {
-    FT_UNUSED( raster );
-    FT_UNUSED( mode );
-    FT_UNUSED( args );
+    gray_PRaster  rast = (gray_PRaster)raster;
+
+
+    if ( mode == FT_GRAYS_MODE_STATS && rast && args )
+    {
+      unsigned long*  stats = (unsigned long*)args;
 
 
-    return 0; /* nothing to do */
+      stats[0]       = rast->stats[0];
+      stats[1]       = rast->stats[1];
+      rast->stats[0] = 0;
+      rast->stats[1] = 0;
+    }
+
+    return 0;
   }
 
 
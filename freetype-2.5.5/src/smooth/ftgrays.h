@@ -48,6 +48,16 @@
   FT_EXPORT_VAR( const FT_Raster_Funcs )  ft_grays_raster;
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* The `mode' value of the raster's `set_mode' function to retrieve the  */
+  /* statistics accumulated since the previous call.  `args' must point to */
+  /* an array of two `unsigned long' values, receiving the number of cells */
+  /* generated and the number of band splits, respectively.                */
+  /*                                                                       */
+#define FT_GRAYS_MODE_STATS  0x73746174UL  /* `stat' */
+
+
 #ifdef __cplusplus
   }
 #endif
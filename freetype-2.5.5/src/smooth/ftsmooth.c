@@ -19,6 +19,7 @@
 #include <ft2build.h>
 #include FT_INTERNAL_DEBUG_H
 #include FT_INTERNAL_OBJECTS_H
+#include FT_INTERNAL_SIMD_H
 #include FT_OUTLINE_H
 #include "ftsmooth.h"
 #include "ftgrays.h"
@@ -70,11 +71,8 @@
       goto Exit;
     }
 
-    if ( matrix )
-      FT_Outline_Transform( &slot->outline, matrix );
-
-    if ( delta )
-      FT_Outline_Translate( &slot->outline, delta->x, delta->y );
+    ft_vector_array_transform( slot->outline.points, slot->outline.n_points,
+                               matrix, delta );
 
   Exit:
     return error;
@@ -94,6 +92,55 @@
   }
 
 
+#ifdef FT_CONFIG_OPTION_SUBPIXEL_RENDERING
+
+  /* state of the span function for horizontal LCD bitmaps */
+  typedef struct  FT_Smooth_LcdRowsRec_
+  {
+    FT_Library  library;
+    FT_Bitmap*  bitmap;
+    FT_Byte*    line;     /* row receiving spans, not yet filtered */
+
+  } FT_Smooth_LcdRowsRec, *FT_Smooth_LcdRows;
+
+
+  /* Draw spans like the rasterizer does for a target bitmap, then     */
+  /* apply the LCD filter to each row as soon as it is complete, while */
+  /* it is still in the cache.  This relies on the rasterizer sending  */
+  /* all spans of a row in consecutive calls, which it does since it   */
+  /* sweeps the cells row by row.  Rows without spans stay zero, which */
+  /* is the filtered value of an empty row.                            */
+  static void
+  ft_smooth_lcd_spans( int             y,
+                       int             count,
+                       const FT_Span*  spans,
+                       void*           user )
+  {
+    FT_Smooth_LcdRows  rows   = (FT_Smooth_LcdRows)user;
+    FT_Bitmap*         bitmap = rows->bitmap;
+    FT_Byte*           line;
+
+
+    line = bitmap->buffer - y * bitmap->pitch;
+    if ( bitmap->pitch >= 0 )
+      line += (unsigned)( ( bitmap->rows - 1 ) * bitmap->pitch );
+
+    if ( line != rows->line )
+    {
+      if ( rows->line )
+        ft_lcd_filter_line( rows->library, rows->line, bitmap->width );
+
+      rows->line = line;
+    }
+
+    for ( ; count > 0; count--, spans++ )
+      if ( spans->coverage )
+        FT_MEM_SET( line + spans->x, spans->coverage, spans->len );
+  }
+
+#endif /* FT_CONFIG_OPTION_SUBPIXEL_RENDERING */
+
+
   /* convert a slot's glyph image into a bitmap */
   static FT_Error
   ft_smooth_render_generic( FT_Renderer       render,
@@ -119,6 +166,10 @@
 
     FT_Raster_Params  params;
 
+#ifdef FT_CONFIG_OPTION_SUBPIXEL_RENDERING
+    FT_Smooth_LcdRowsRec  lcd_rows;
+#endif
+
     FT_Bool  have_outline_shifted = FALSE;
     FT_Bool  have_buffer          = FALSE;
 
@@ -277,6 +328,24 @@
           vec->y *= 3;
     }
 
+    /* filter horizontal LCD rows while rendering */
+    lcd_rows.line = NULL;
+
+    if ( hmul && slot->library->lcd_filter_func )
+    {
+      lcd_rows.library = slot->library;
+      lcd_rows.bitmap  = bitmap;
+
+      params.flags     |= FT_RASTER_FLAG_DIRECT | FT_RASTER_FLAG_CLIP;
+      params.gray_spans = ft_smooth_lcd_spans;
+      params.user       = &lcd_rows;
+
+      params.clip_box.xMin = 0;
+      params.clip_box.yMin = 0;
+      params.clip_box.xMax = (FT_Pos)width;
+      params.clip_box.yMax = (FT_Pos)height;
+    }
+
     /* render outline into the bitmap */
     error = render->raster_render( render->raster, &params );
 
@@ -299,7 +368,13 @@
     if ( error )
       goto Exit;
 
-    if ( slot->library->lcd_filter_func )
+    if ( params.flags & FT_RASTER_FLAG_DIRECT )
+    {
+      /* filter the last row */
+      if ( lcd_rows.line )
+        ft_lcd_filter_line( slot->library, lcd_rows.line, bitmap->width );
+    }
+    else if ( slot->library->lcd_filter_func )
       slot->library->lcd_filter_func( bitmap, mode, slot->library );
 
 #else /* !FT_CONFIG_OPTION_SUBPIXEL_RENDERING */
@@ -365,6 +440,19 @@
     error = FT_Err_Ok;
 
   Exit:
+#ifdef FT_CONFIG_OPTION_COUNTERS
+    {
+      unsigned long  stats[2] = { 0, 0 };
+
+
+      render->clazz->raster_class->raster_set_mode( render->raster,
+                                                    FT_GRAYS_MODE_STATS,
+                                                    stats );
+      FT_COUNTER_ADD( slot->library, FT_COUNTER_RASTER_CELLS, stats[0] );
+      FT_COUNTER_ADD( slot->library, FT_COUNTER_BAND_SPLITS, stats[1] );
+    }
+#endif
+
     if ( have_outline_shifted )
       FT_Outline_Translate( outline, -x_shift, -y_shift );
     if ( have_buffer )
@@ -233,6 +233,34 @@
       }
     }
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+
+    /* Vary the advances with the `HVAR' or `VVAR' table, which doesn't */
+    /* need the glyph outlines.  Without such a table, the advances     */
+    /* depend on the phantom points of `gvar', and we let the caller    */
+    /* load the glyphs instead.                                         */
+    if ( face->doblend )
+    {
+      FT_Bool  vertical = FT_BOOL( flags & FT_LOAD_VERTICAL_LAYOUT );
+
+
+      for ( nn = 0; nn < count; nn++ )
+      {
+        FT_Int    delta;
+        FT_Error  error;
+
+
+        error = TT_Vary_Get_Advance_Delta( face, start + nn,
+                                           vertical, &delta );
+        if ( error )
+          return error;
+
+        advances[nn] += delta;
+      }
+    }
+
+#endif /* TT_CONFIG_OPTION_GX_VAR_SUPPORT */
+
     return FT_Err_Ok;
   }
 
@@ -19,6 +19,7 @@
 #include <ft2build.h>
 #include FT_INTERNAL_DEBUG_H
 #include FT_INTERNAL_CALC_H
+#include FT_INTERNAL_SIMD_H
 #include FT_INTERNAL_STREAM_H
 #include FT_INTERNAL_SFNT_H
 #include FT_TRUETYPE_TAGS_H
@@ -150,6 +151,23 @@
     loader->top_bearing  = top_bearing;
     loader->vadvance     = advance_height;
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+
+    /* vary the advances with `HVAR' and `VVAR'; without these tables, */
+    /* the phantom point deltas of `gvar' get applied later on         */
+    if ( face->doblend )
+    {
+      FT_Int  delta;
+
+
+      if ( !TT_Vary_Get_Advance_Delta( face, glyph_index, FALSE, &delta ) )
+        loader->advance += delta;
+      if ( !TT_Vary_Get_Advance_Delta( face, glyph_index, TRUE, &delta ) )
+        loader->vadvance += delta;
+    }
+
+#endif /* TT_CONFIG_OPTION_GX_VAR_SUPPORT */
+
 #ifdef TT_CONFIG_OPTION_SUBPIXEL_HINTING
     if ( driver->interpreter_version == TT_INTERPRETER_VERSION_38 )
     {
@@ -165,7 +183,7 @@
     if ( !loader->linear_def )
     {
       loader->linear_def = 1;
-      loader->linear     = advance_width;
+      loader->linear     = loader->advance;
     }
 
     return FT_Err_Ok;
@@ -244,29 +262,6 @@
 #endif /* FT_CONFIG_OPTION_INCREMENTAL */
 
 
-  /*************************************************************************/
-  /*                                                                       */
-  /* Translates an array of coordinates.                                   */
-  /*                                                                       */
-  static void
-  translate_array( FT_UInt     n,
-                   FT_Vector*  coords,
-                   FT_Pos      delta_x,
-                   FT_Pos      delta_y )
-  {
-    FT_UInt  k;
-
-
-    if ( delta_x )
-      for ( k = 0; k < n; k++ )
-        coords[k].x += delta_x;
-
-    if ( delta_y )
-      for ( k = 0; k < n; k++ )
-        coords[k].y += delta_y;
-  }
-
-
   /*************************************************************************/
   /*                                                                       */
   /* The following functions are used by default with TrueType fonts.      */
@@ -800,6 +795,12 @@
       FT_GlyphLoader  gloader         = loader->gloader;
       FT_Outline      current_outline = gloader->current.outline;
 
+#ifdef FT_CONFIG_OPTION_COUNTERS
+      FT_Library  library = FT_FACE_LIBRARY( loader->face );
+#endif
+
+      FT_TIMER_VAR( start )
+
 
       TT_Set_CodeRange( loader->exec, tt_coderange_glyph,
                         loader->exec->glyphIns, n_ins );
@@ -810,7 +811,10 @@
       debug = FT_BOOL( !( loader->load_flags & FT_LOAD_NO_SCALE ) &&
                        ((TT_Size)loader->size)->debug             );
 
+      FT_TIMER_START( library, start );
       error = TT_Run_Context( loader->exec, debug );
+      FT_TIMER_STOP( library, FT_COUNTER_HINTING_TIME, start );
+
       if ( error && loader->exec->pedantic_hinting )
         return error;
 
@@ -985,12 +989,13 @@
           vec->x = FT_MulFix( vec->x, x_scale );
           vec->y = FT_MulFix( vec->y, y_scale );
         }
-
-        loader->pp1 = outline->points[n_points - 4];
-        loader->pp2 = outline->points[n_points - 3];
-        loader->pp3 = outline->points[n_points - 2];
-        loader->pp4 = outline->points[n_points - 1];
       }
+
+      /* the phantom points may have been varied or scaled */
+      loader->pp1 = outline->points[n_points - 4];
+      loader->pp2 = outline->points[n_points - 3];
+      loader->pp3 = outline->points[n_points - 2];
+      loader->pp4 = outline->points[n_points - 1];
     }
 
     if ( IS_HINTED( loader->load_flags ) )
@@ -1032,13 +1037,9 @@
 
     /* perform the transform required for this subglyph */
     if ( have_scale )
-    {
-      FT_UInt  i;
-
-
-      for ( i = num_base_points; i < num_points; i++ )
-        FT_Vector_Transform( base_vec + i, &subglyph->transform );
-    }
+      ft_vector_array_transform( base_vec + num_base_points,
+                                 (FT_Int)( num_points - num_base_points ),
+                                 &subglyph->transform, NULL );
 
     /* get offset */
     if ( !( subglyph->flags & ARGS_ARE_XY_VALUES ) )
@@ -1147,9 +1148,17 @@
     }
 
     if ( x || y )
-      translate_array( num_points - num_base_points,
-                       base_vec + num_base_points,
-                       x, y );
+    {
+      FT_Vector  delta;
+
+
+      delta.x = x;
+      delta.y = y;
+
+      ft_vector_array_transform( base_vec + num_base_points,
+                                 (FT_Int)( num_points - num_base_points ),
+                                 NULL, &delta );
+    }
 
     return FT_Err_Ok;
   }
@@ -2125,6 +2134,12 @@
       FT_Bool  reexecute = FALSE;
 
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+      /* the blend instance has been changed since the CVT program ran */
+      if ( size->instance != TT_BLEND_INSTANCE( face ) )
+        size->cvt_ready = -1;
+#endif
+
       if ( size->bytecode_ready < 0 || size->cvt_ready < 0 )
       {
         error = tt_size_ready_bytecode( size, pedantic );
@@ -2136,9 +2151,8 @@
       else if ( size->cvt_ready )
         return size->cvt_ready;
 
-      /* query new execution context */
-      exec = size->debug ? size->context
-                         : ( (TT_Driver)FT_FACE_DRIVER( face ) )->context;
+      /* query the size's execution context */
+      exec = size->context;
       if ( !exec )
         return FT_THROW( Could_Not_Find_Context );
 
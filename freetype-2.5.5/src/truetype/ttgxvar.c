@@ -100,6 +100,15 @@
 #define GX_PT_POINT_RUN_COUNT_MASK  0x7F
 
 
+  /* Compute `FT_MulFix( delta, apply )' for a 16-bit `delta' and a      */
+  /* tuple scalar `apply' in the range [0;0x10000], using 32-bit integer */
+  /* arithmetic only.  This is exact, including the rounding of negative */
+  /* values.                                                             */
+#define GX_MUL_DELTA( delta, apply )                                  \
+          ( ( (FT_Int32)(delta) * (apply) + 0x8000 - ( (delta) < 0 ) ) \
+            >> 16 )
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Function>                                                            */
@@ -137,45 +146,47 @@
     FT_UNUSED( error );
 
 
-    *point_cnt = n = FT_GET_BYTE();
+    *point_cnt = 0;
+
+    n = FT_GET_BYTE();
     if ( n == 0 )
       return ALL_POINTS;
 
     if ( n & GX_PT_POINTS_ARE_WORDS )
       n = FT_GET_BYTE() | ( ( n & GX_PT_POINT_RUN_COUNT_MASK ) << 8 );
 
+    *point_cnt = (FT_UInt)n;
+
     if ( FT_NEW_ARRAY( points, n ) )
       return NULL;
 
-    i = 0;
+    /* point numbers are delta-encoded across all runs */
+    first = 0;
+    i     = 0;
     while ( i < n )
     {
       runcnt = FT_GET_BYTE();
       if ( runcnt & GX_PT_POINTS_ARE_WORDS )
       {
         runcnt = runcnt & GX_PT_POINT_RUN_COUNT_MASK;
-        first  = points[i++] = FT_GET_USHORT();
-
-        if ( runcnt < 1 || i + runcnt >= n )
-          goto Exit;
 
-        /* first point not included in runcount */
-        for ( j = 0; j < runcnt; ++j )
-          points[i++] = (FT_UShort)( first += FT_GET_USHORT() );
+        /* first point not included in run count */
+        for ( j = 0; j <= runcnt && i < n; ++j )
+        {
+          first      += FT_GET_USHORT();
+          points[i++] = (FT_UShort)first;
+        }
       }
       else
       {
-        first = points[i++] = FT_GET_BYTE();
-
-        if ( runcnt < 1 || i + runcnt >= n )
-          goto Exit;
-
-        for ( j = 0; j < runcnt; ++j )
-          points[i++] = (FT_UShort)( first += FT_GET_BYTE() );
+        for ( j = 0; j <= runcnt && i < n; ++j )
+        {
+          first      += FT_GET_BYTE();
+          points[i++] = (FT_UShort)first;
+        }
       }
     }
 
-  Exit:
     return points;
   }
 
@@ -458,16 +469,398 @@
       for ( i = 0; i < blend->tuplecount; ++i )
         for ( j = 0 ; j < (FT_UInt)gvar_head.axisCount; ++j )
           blend->tuplecoords[i * gvar_head.axisCount + j] =
-            FT_GET_SHORT() << 2;                /* convert to FT_Fixed */
+            FT_GET_SHORT() * 4;                 /* convert to FT_Fixed */
+
+      FT_FRAME_EXIT();
+    }
+
+  Exit:
+    return error;
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    ft_var_done_item_variation_store                                   */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Frees the data of an item variation store.                         */
+  /*                                                                       */
+  static void
+  ft_var_done_item_variation_store( FT_Memory        memory,
+                                    GX_ItemVarStore  itemStore )
+  {
+    FT_UInt  i;
+
+
+    if ( itemStore->varData != NULL )
+    {
+      for ( i = 0; i < itemStore->dataCount; ++i )
+      {
+        FT_FREE( itemStore->varData[i].regionIndices );
+        FT_FREE( itemStore->varData[i].deltaSet );
+      }
+      FT_FREE( itemStore->varData );
+    }
+
+    FT_FREE( itemStore->regions );
+    FT_FREE( itemStore->scalars );
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    ft_var_load_item_variation_store                                   */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Parses an item variation store (format 1) starting at `offset'.    */
+  /*                                                                       */
+  /* <Input>                                                               */
+  /*    face      :: The font face.                                        */
+  /*                                                                       */
+  /*    offset    :: The stream offset of the store.                       */
+  /*                                                                       */
+  /* <Output>                                                              */
+  /*    itemStore :: The store.  Its arrays must be freed with             */
+  /*                 `ft_var_done_item_variation_store' even on failure.   */
+  /*                                                                       */
+  /* <Return>                                                              */
+  /*    FreeType error code.  0 means success.                             */
+  /*                                                                       */
+  static FT_Error
+  ft_var_load_item_variation_store( TT_Face          face,
+                                    FT_ULong         offset,
+                                    GX_ItemVarStore  itemStore )
+  {
+    FT_Stream  stream = FT_FACE_STREAM( face );
+    FT_Memory  memory = stream->memory;
+    GX_Blend   blend  = face->blend;
+    FT_UInt    num_axis = blend->mmvar->num_axis;
+
+    FT_Error   error;
+    FT_UShort  format;
+    FT_ULong   region_offset;
+    FT_ULong*  data_offsets = NULL;
+    FT_UInt    axisCount;
+    FT_UInt    i, j, k;
+
+
+    if ( FT_STREAM_SEEK( offset )       ||
+         FT_READ_USHORT( format )       ||
+         FT_READ_ULONG( region_offset ) )
+      goto Exit;
+
+    if ( format != 1 )
+    {
+      error = FT_THROW( Invalid_Table );
+      goto Exit;
+    }
+
+    if ( FT_READ_USHORT( itemStore->dataCount ) )
+      goto Exit;
+
+    if ( FT_NEW_ARRAY( data_offsets, itemStore->dataCount ) )
+      goto Exit;
+
+    if ( FT_FRAME_ENTER( itemStore->dataCount * 4L ) )
+      goto Exit;
+
+    for ( i = 0; i < itemStore->dataCount; ++i )
+      data_offsets[i] = offset + FT_GET_ULONG();
+
+    FT_FRAME_EXIT();
+
+    /* the region list */
+    if ( FT_STREAM_SEEK( offset + region_offset ) ||
+         FT_READ_USHORT( axisCount )              ||
+         FT_READ_USHORT( itemStore->regionCount ) )
+      goto Exit;
+
+    if ( axisCount != num_axis                                    ||
+         FT_STREAM_POS() + itemStore->regionCount * num_axis * 6UL >
+           stream->size                                             )
+    {
+      error = FT_THROW( Invalid_Table );
+      goto Exit;
+    }
+
+    if ( FT_NEW_ARRAY( itemStore->regions,
+                       itemStore->regionCount * 3 * num_axis ) ||
+         FT_NEW_ARRAY( itemStore->scalars, itemStore->regionCount ) )
+      goto Exit;
+
+    if ( FT_FRAME_ENTER( itemStore->regionCount * num_axis * 6L ) )
+      goto Exit;
+
+    for ( i = 0; i < itemStore->regionCount; ++i )
+    {
+      FT_Fixed*  peak  = itemStore->regions + i * 3 * num_axis;
+      FT_Fixed*  start = peak + num_axis;
+      FT_Fixed*  end   = start + num_axis;
+
+
+      for ( j = 0; j < num_axis; ++j )
+      {
+        start[j] = FT_GET_SHORT() * 4;          /* convert to FT_Fixed */
+        peak[j]  = FT_GET_SHORT() * 4;
+        end[j]   = FT_GET_SHORT() * 4;
+
+        /* axes of invalid regions don't contribute to the scalar; */
+        /* we mark them with a zero peak                           */
+        if ( start[j] > peak[j]             ||
+             peak[j] > end[j]               ||
+             ( start[j] < 0 && end[j] > 0 ) )
+          peak[j] = 0;
+      }
+    }
+
+    FT_FRAME_EXIT();
+
+    /* the item variation data subtables */
+    if ( FT_NEW_ARRAY( itemStore->varData, itemStore->dataCount ) )
+      goto Exit;
+
+    for ( i = 0; i < itemStore->dataCount; ++i )
+    {
+      GX_ItemVarData  varData = itemStore->varData + i;
+      FT_UShort       wordDeltaCount;
+      FT_Bool         long_words;
+      FT_ULong        row_size;
+      FT_Int*         delta;
+
+
+      if ( FT_STREAM_SEEK( data_offsets[i] )         ||
+           FT_READ_USHORT( varData->itemCount )      ||
+           FT_READ_USHORT( wordDeltaCount )          ||
+           FT_READ_USHORT( varData->regionIdxCount ) )
+        goto Exit;
+
+      long_words      = FT_BOOL( wordDeltaCount & 0x8000 );
+      wordDeltaCount &= 0x7FFF;
+      row_size        = (FT_ULong)( wordDeltaCount +
+                                    varData->regionIdxCount ) << long_words;
+
+      /* check the size before allocating the delta sets */
+      if ( wordDeltaCount > varData->regionIdxCount         ||
+           FT_STREAM_POS() + varData->regionIdxCount * 2UL +
+             varData->itemCount * row_size > stream->size   )
+      {
+        error = FT_THROW( Invalid_Table );
+        goto Exit;
+      }
+
+      if ( FT_NEW_ARRAY( varData->regionIndices,
+                         varData->regionIdxCount ) ||
+           FT_NEW_ARRAY( varData->deltaSet,
+                         varData->itemCount *
+                           varData->regionIdxCount ) )
+        goto Exit;
+
+      if ( FT_FRAME_ENTER( varData->regionIdxCount * 2L ) )
+        goto Exit;
+
+      for ( j = 0; j < varData->regionIdxCount; ++j )
+      {
+        varData->regionIndices[j] = FT_GET_USHORT();
+
+        if ( varData->regionIndices[j] >= itemStore->regionCount )
+        {
+          FT_FRAME_EXIT();
+          error = FT_THROW( Invalid_Table );
+          goto Exit;
+        }
+      }
+
+      FT_FRAME_EXIT();
+
+      if ( FT_FRAME_ENTER( varData->itemCount * row_size ) )
+        goto Exit;
+
+      delta = varData->deltaSet;
+      for ( j = 0; j < varData->itemCount; ++j )
+      {
+        if ( long_words )
+        {
+          for ( k = 0; k < wordDeltaCount; ++k )
+            *delta++ = (FT_Int)FT_GET_LONG();
+          for ( ; k < varData->regionIdxCount; ++k )
+            *delta++ = FT_GET_SHORT();
+        }
+        else
+        {
+          for ( k = 0; k < wordDeltaCount; ++k )
+            *delta++ = FT_GET_SHORT();
+          for ( ; k < varData->regionIdxCount; ++k )
+            *delta++ = FT_GET_CHAR();
+        }
+      }
 
       FT_FRAME_EXIT();
     }
 
   Exit:
+    FT_FREE( data_offsets );
+
     return error;
   }
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    ft_var_load_hvar                                                   */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Parses the advance data of the `HVAR' or `VVAR' table if present.  */
+  /*    Both tables start with the same fields.  The table need not be     */
+  /*    there, so we return nothing; on failure, we simply continue to     */
+  /*    vary advances with the phantom points of `gvar'.                   */
+  /*                                                                       */
+  /* <InOut>                                                               */
+  /*    face     :: The font face.                                         */
+  /*                                                                       */
+  /* <Input>                                                               */
+  /*    vertical :: If set, load `VVAR'; `HVAR' otherwise.                 */
+  /*                                                                       */
+  static void
+  ft_var_load_hvar( TT_Face  face,
+                    FT_Bool  vertical )
+  {
+    FT_Stream     stream = FT_FACE_STREAM( face );
+    FT_Memory     memory = stream->memory;
+    GX_Blend      blend  = face->blend;
+    GX_HVarTable  table  = NULL;
+
+    FT_Error      error;
+    FT_ULong      table_len;
+    FT_ULong      table_offset;
+    FT_ULong      store_offset;
+    FT_ULong      map_offset;
+    FT_ULong      version;
+    FT_UInt       i;
+
+
+    error = face->goto_table( face,
+                              vertical ? TTAG_VVAR : TTAG_HVAR,
+                              stream,
+                              &table_len );
+    if ( error )
+      return;
+
+    table_offset = FT_STREAM_POS();
+
+    if ( FT_FRAME_ENTER( 12L ) )
+      return;
+
+    version      = FT_GET_ULONG();
+    store_offset = FT_GET_ULONG();
+    map_offset   = FT_GET_ULONG();
+
+    FT_FRAME_EXIT();
+
+    if ( version != 0x00010000UL )
+      return;
+
+    if ( FT_NEW( table ) )
+      return;
+
+    error = ft_var_load_item_variation_store( face,
+                                              table_offset + store_offset,
+                                              &table->itemStore );
+    if ( error )
+      goto Exit;
+
+    /* the optional advance mapping; without it, glyph indices are */
+    /* inner indices into the first item variation data subtable   */
+    if ( map_offset != 0 )
+    {
+      FT_Byte   format, entryFormat;
+      FT_UInt   entrySize, innerBits;
+      FT_ULong  mapCount;
+
+
+      if ( FT_STREAM_SEEK( table_offset + map_offset ) ||
+           FT_READ_BYTE( format )                      ||
+           FT_READ_BYTE( entryFormat )                 )
+        goto Exit;
+
+      if ( format == 0 )
+      {
+        FT_UShort  count;
+
+
+        if ( FT_READ_USHORT( count ) )
+          goto Exit;
+        mapCount = count;
+      }
+      else if ( format == 1 )
+      {
+        if ( FT_READ_ULONG( mapCount ) )
+          goto Exit;
+      }
+      else
+      {
+        error = FT_THROW( Invalid_Table );
+        goto Exit;
+      }
+
+      /* there is no need to keep entries beyond the last glyph */
+      if ( mapCount > (FT_ULong)face->root.num_glyphs )
+        mapCount = (FT_ULong)face->root.num_glyphs;
+
+      entrySize = ( ( entryFormat & 0x30 ) >> 4 ) + 1;
+      innerBits = ( entryFormat & 0x0F ) + 1;
+
+      if ( FT_NEW_ARRAY( table->outerIndex, mapCount ) ||
+           FT_NEW_ARRAY( table->innerIndex, mapCount ) )
+        goto Exit;
+
+      if ( FT_FRAME_ENTER( mapCount * entrySize ) )
+        goto Exit;
+
+      for ( i = 0; i < mapCount; ++i )
+      {
+        FT_ULong  entry = 0;
+        FT_UInt   k;
+
+
+        for ( k = 0; k < entrySize; ++k )
+          entry = ( entry << 8 ) | FT_GET_BYTE();
+
+        table->outerIndex[i] = (FT_UShort)( entry >> innerBits );
+        table->innerIndex[i] = (FT_UShort)( entry &
+                                            ( ( 1UL << innerBits ) - 1 ) );
+      }
+
+      FT_FRAME_EXIT();
+
+      table->mapCount = (FT_UInt)mapCount;
+    }
+
+    /* force computation of the region scalars */
+    table->itemStore.scalars_serial = blend->coords_serial - 1;
+
+  Exit:
+    if ( error )
+    {
+      FT_TRACE2(( "ft_var_load_hvar: ignoring invalid `%s' table\n",
+                  vertical ? "VVAR" : "HVAR" ));
+
+      ft_var_done_item_variation_store( memory, &table->itemStore );
+      FT_FREE( table->outerIndex );
+      FT_FREE( table->innerIndex );
+      FT_FREE( table );
+    }
+
+    if ( vertical )
+      blend->vvar_table = table;
+    else
+      blend->hvar_table = table;
+  }
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Function>                                                            */
@@ -825,55 +1218,190 @@
   /*************************************************************************/
   /*                                                                       */
   /* <Function>                                                            */
-  /*    TT_Set_MM_Blend                                                    */
+  /*    ft_var_find_instance                                               */
   /*                                                                       */
   /* <Description>                                                         */
-  /*    Set the blend (normalized) coordinates for this instance of the    */
-  /*    font.  Check that the `gvar' table is reasonable and does some     */
-  /*    initial preparation.                                               */
+  /*    Look up a recently used blend instance by its coordinates.         */
   /*                                                                       */
-  /* <InOut>                                                               */
-  /*    face       :: The font.                                            */
-  /*                  Initialize the blend structure with `gvar' data.     */
+  /* <Return>                                                              */
+  /*    The instance, or NULL if there is none.                            */
   /*                                                                       */
-  /* <Input>                                                               */
-  /*    num_coords :: Must be the axis count of the font.                  */
+  static GX_Instance
+  ft_var_find_instance( GX_Blend   blend,
+                        FT_Fixed*  coords )
+  {
+    FT_UInt  n;
+
+
+    for ( n = 0; n < blend->num_instances; n++ )
+      if ( !ft_memcmp( blend->instances[n].normalizedcoords,
+                       coords,
+                       blend->num_axis * sizeof ( FT_Fixed ) ) )
+        return blend->instances + n;
+
+    return NULL;
+  }
+
+
+  /*************************************************************************/
   /*                                                                       */
-  /*    coords     :: An array of num_coords, each between [-1,1].         */
+  /* <Function>                                                            */
+  /*    ft_var_use_instance                                                */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Make a blend instance the most recently used one.                  */
   /*                                                                       */
   /* <Return>                                                              */
-  /*    FreeType error code.  0 means success.                             */
+  /*    The new address of the instance.                                   */
   /*                                                                       */
-  FT_LOCAL_DEF( FT_Error )
-  TT_Set_MM_Blend( TT_Face    face,
-                   FT_UInt    num_coords,
-                   FT_Fixed*  coords )
+  static GX_Instance
+  ft_var_use_instance( GX_Blend     blend,
+                       GX_Instance  instance )
   {
-    FT_Error    error = FT_Err_Ok;
-    GX_Blend    blend;
-    FT_MM_Var*  mmvar;
-    FT_UInt     i;
-    FT_Memory   memory = face->root.memory;
-
-    enum
-    {
-      mcvt_retain,
-      mcvt_modify,
-      mcvt_load
+    GX_InstanceRec  rec = *instance;
 
-    } manageCvt;
 
+    ft_memmove( blend->instances + 1,
+                blend->instances,
+                (FT_UInt)( instance - blend->instances ) *
+                  sizeof ( GX_InstanceRec ) );
+    blend->instances[0] = rec;
 
-    face->doblend = FALSE;
+    return blend->instances;
+  }
 
-    if ( face->blend == NULL )
-    {
-      if ( (error = TT_Get_MM_Var( face, NULL)) != 0 )
-        goto Exit;
-    }
 
-    blend = face->blend;
-    mmvar = blend->mmvar;
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    ft_var_new_instance                                                */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Record the current blend coordinates and CVT of a face as a new    */
+  /*    instance and make it the current one.  An instance with the same   */
+  /*    coordinates (but without a saved CVT) is replaced; otherwise the   */
+  /*    least recently used instance is dropped if necessary.              */
+  /*                                                                       */
+  static void
+  ft_var_new_instance( TT_Face  face )
+  {
+    FT_Memory       memory = face->root.memory;
+    GX_Blend        blend  = face->blend;
+    GX_InstanceRec  instance;
+    GX_Instance     old;
+    FT_Error        error;
+
+
+    FT_ZERO( &instance );
+
+    instance.serial      = ++blend->last_serial;
+    blend->coords_serial = instance.serial;
+
+    if ( FT_QNEW_ARRAY( instance.normalizedcoords, blend->num_axis ) )
+      goto Fail;
+
+    FT_ARRAY_COPY( instance.normalizedcoords,
+                   blend->normalizedcoords,
+                   blend->num_axis );
+
+    if ( face->cvt != NULL )
+    {
+      if ( FT_QNEW_ARRAY( instance.cvt, face->cvt_size ) )
+        goto Fail;
+
+      FT_ARRAY_COPY( instance.cvt, face->cvt, face->cvt_size );
+    }
+
+    old = ft_var_find_instance( blend, blend->normalizedcoords );
+    if ( old != NULL )
+    {
+      FT_FREE( old->normalizedcoords );
+      FT_FREE( old->cvt );
+
+      blend->num_instances--;
+      ft_memmove( old,
+                  old + 1,
+                  ( blend->num_instances -
+                    (FT_UInt)( old - blend->instances ) ) *
+                    sizeof ( GX_InstanceRec ) );
+    }
+    else if ( blend->num_instances == GX_MAX_INSTANCES )
+    {
+      GX_Instance  last = blend->instances + --blend->num_instances;
+
+
+      FT_FREE( last->normalizedcoords );
+      FT_FREE( last->cvt );
+    }
+
+    ft_memmove( blend->instances + 1,
+                blend->instances,
+                blend->num_instances * sizeof ( GX_InstanceRec ) );
+    blend->instances[0] = instance;
+    blend->num_instances++;
+    return;
+
+  Fail:
+    /* the instances are an optimization only; ignore allocation errors */
+    FT_FREE( instance.normalizedcoords );
+    FT_FREE( instance.cvt );
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    TT_Set_MM_Blend                                                    */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Set the blend (normalized) coordinates for this instance of the    */
+  /*    font.  Check that the `gvar' table is reasonable and does some     */
+  /*    initial preparation.                                               */
+  /*                                                                       */
+  /* <InOut>                                                               */
+  /*    face       :: The font.                                            */
+  /*                  Initialize the blend structure with `gvar' data.     */
+  /*                                                                       */
+  /* <Input>                                                               */
+  /*    num_coords :: Must be the axis count of the font.                  */
+  /*                                                                       */
+  /*    coords     :: An array of num_coords, each between [-1,1].         */
+  /*                                                                       */
+  /* <Return>                                                              */
+  /*    FreeType error code.  0 means success.                             */
+  /*                                                                       */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Set_MM_Blend( TT_Face    face,
+                   FT_UInt    num_coords,
+                   FT_Fixed*  coords )
+  {
+    FT_Error     error = FT_Err_Ok;
+    GX_Blend     blend;
+    FT_MM_Var*   mmvar;
+    FT_UInt      i;
+    FT_Memory    memory   = face->root.memory;
+    GX_Instance  instance = NULL;
+
+    enum
+    {
+      mcvt_retain,
+      mcvt_modify,
+      mcvt_load,
+      mcvt_restore
+
+    } manageCvt;
+
+
+    face->doblend = FALSE;
+
+    if ( face->blend == NULL )
+    {
+      if ( (error = TT_Get_MM_Var( face, NULL)) != 0 )
+        goto Exit;
+    }
+
+    blend = face->blend;
+    mmvar = blend->mmvar;
 
     if ( num_coords != mmvar->num_axis )
     {
@@ -889,9 +1417,16 @@
       }
 
     if ( blend->glyphoffsets == NULL )
+    {
       if ( (error = ft_var_load_gvar( face )) != 0 )
         goto Exit;
 
+      /* the metrics variation tables are optional; we load them now */
+      /* since they are accessed while a glyph frame is open         */
+      ft_var_load_hvar( face, FALSE );
+      ft_var_load_hvar( face, TRUE );
+    }
+
     if ( blend->normalizedcoords == NULL )
     {
       if ( FT_NEW_ARRAY( blend->normalizedcoords, num_coords ) )
@@ -918,7 +1453,19 @@
       /* If we don't change the blend coords then we don't need to do  */
       /* anything to the cvt table.  It will be correct.  Otherwise we */
       /* no longer have the original cvt (it was modified when we set  */
-      /* the blend last time), so we must reload and then modify it.   */
+      /* the blend last time), so we must reload and then modify it -- */
+      /* unless the coordinates have been used recently.               */
+
+      if ( manageCvt == mcvt_load )
+      {
+        instance = ft_var_find_instance( blend, coords );
+        if ( instance != NULL                              &&
+             ( face->cvt == NULL || instance->cvt != NULL ) )
+        {
+          instance  = ft_var_use_instance( blend, instance );
+          manageCvt = mcvt_restore;
+        }
+      }
     }
 
     blend->num_axis = num_coords;
@@ -926,6 +1473,21 @@
                  coords,
                  num_coords * sizeof ( FT_Fixed ) );
 
+    /* the scalars of the shared peak tuples only depend on the blend */
+    /* coordinates; compute them once here instead of for every glyph */
+    if ( blend->tuplecount != 0 && blend->tuplescalars == NULL )
+      if ( FT_NEW_ARRAY( blend->tuplescalars, blend->tuplecount ) )
+        goto Exit;
+
+    if ( manageCvt != mcvt_retain )
+      for ( i = 0; i < blend->tuplecount; ++i )
+        blend->tuplescalars[i] =
+          ft_var_apply_tuple( blend,
+                              0,
+                              &blend->tuplecoords[i * num_coords],
+                              NULL,
+                              NULL );
+
     face->doblend = TRUE;
 
     if ( face->cvt != NULL )
@@ -947,12 +1509,31 @@
         error = tt_face_vary_cvt( face, face->root.stream );
         break;
 
+      case mcvt_restore:
+        /* The cvt table for these coordinates has been saved. */
+        FT_ARRAY_COPY( face->cvt, instance->cvt, face->cvt_size );
+        break;
+
       case mcvt_retain:
         /* The cvt table is correct for this set of coordinates. */
         break;
       }
+
+      if ( error )
+      {
+        /* the coordinates have changed nevertheless */
+        blend->coords_serial = ++blend->last_serial;
+        goto Exit;
+      }
     }
 
+    /* Results of the CVT program are cached per instance (sizes notice */
+    /* a change of the instance and restore or rerun the CVT program).  */
+    if ( manageCvt == mcvt_restore )
+      blend->coords_serial = instance->serial;
+    else if ( manageCvt != mcvt_retain )
+      ft_var_new_instance( face );
+
   Exit:
     return error;
   }
@@ -1278,83 +1859,115 @@
   /*************************************************************************/
   /*                                                                       */
   /* <Function>                                                            */
-  /*    TT_Vary_Get_Glyph_Deltas                                           */
+  /*    ft_var_done_glyph_deltas                                           */
   /*                                                                       */
   /* <Description>                                                         */
-  /*    Load the appropriate deltas for the current glyph.                 */
+  /*    Free a glyph deltas record.                                        */
+  /*                                                                       */
+  static void
+  ft_var_done_glyph_deltas( FT_Memory       memory,
+                            GX_GlyphDeltas  gdeltas )
+  {
+    FT_UInt  i;
+
+
+    if ( gdeltas == NULL )
+      return;
+
+    for ( i = 0; i < gdeltas->num_tuples; ++i )
+    {
+      GX_TupleDeltas  tuple = gdeltas->tuples + i;
+
+
+      if ( tuple->points != gdeltas->sharedpoints )
+        FT_FREE( tuple->points );
+      FT_FREE( tuple->coords );
+      FT_FREE( tuple->deltas_x );
+      FT_FREE( tuple->deltas_y );
+    }
+
+    FT_FREE( gdeltas->sharedpoints );
+    FT_FREE( gdeltas->tuples );
+    FT_FREE( gdeltas->scalars );
+    FT_FREE( gdeltas );
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    ft_var_load_glyph_deltas                                           */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Decode the `gvar' variation data of a glyph.  All tuples are       */
+  /*    decoded, regardless of the current blend coordinates, so that the  */
+  /*    result stays valid if the coordinates change.                      */
   /*                                                                       */
   /* <Input>                                                               */
   /*    face        :: A handle to the target face object.                 */
   /*                                                                       */
-  /*    glyph_index :: The index of the glyph being modified.              */
+  /*    glyph_index :: The glyph index.  The glyph must have variation     */
+  /*                   data.                                               */
   /*                                                                       */
   /*    n_points    :: The number of the points in the glyph, including    */
   /*                   phantom points.                                     */
   /*                                                                       */
   /* <Output>                                                              */
-  /*    deltas      :: The array of points to change.                      */
+  /*    agdeltas    :: The new glyph deltas record.                        */
   /*                                                                       */
   /* <Return>                                                              */
   /*    FreeType error code.  0 means success.                             */
   /*                                                                       */
-  FT_LOCAL_DEF( FT_Error )
-  TT_Vary_Get_Glyph_Deltas( TT_Face      face,
-                            FT_UInt      glyph_index,
-                            FT_Vector*  *deltas,
-                            FT_UInt      n_points )
+  static FT_Error
+  ft_var_load_glyph_deltas( TT_Face          face,
+                            FT_UInt          glyph_index,
+                            FT_UInt          n_points,
+                            GX_GlyphDeltas  *agdeltas )
   {
-    FT_Stream   stream = face->root.stream;
-    FT_Memory   memory = stream->memory;
-    GX_Blend    blend  = face->blend;
-    FT_Vector*  delta_xy = NULL;
-
-    FT_Error    error;
-    FT_ULong    glyph_start;
-    FT_UInt     tupleCount;
-    FT_ULong    offsetToData;
-    FT_ULong    here;
-    FT_UInt     i, j;
-    FT_Fixed*   tuple_coords    = NULL;
-    FT_Fixed*   im_start_coords = NULL;
-    FT_Fixed*   im_end_coords   = NULL;
-    FT_UInt     point_count, spoint_count = 0;
-    FT_UShort*  sharedpoints = NULL;
-    FT_UShort*  localpoints  = NULL;
-    FT_UShort*  points;
-    FT_Short    *deltas_x, *deltas_y;
-
-
-    if ( !face->doblend || blend == NULL )
-      return FT_THROW( Invalid_Argument );
+    FT_Stream       stream  = face->root.stream;
+    FT_Memory       memory  = stream->memory;
+    GX_Blend        blend   = face->blend;
+    GX_GlyphDeltas  gdeltas = NULL;
+
+    FT_Error        error;
+    FT_ULong        glyph_start;
+    FT_UInt         tupleCount;
+    FT_ULong        offsetToData;
+    FT_ULong        here;
+    FT_UInt         i, j;
+    FT_UInt         spoint_count = 0;
+    FT_UShort*      sharedpoints = NULL;
 
-    /* to be freed by the caller */
-    if ( FT_NEW_ARRAY( delta_xy, n_points ) )
-      goto Exit;
-    *deltas = delta_xy;
 
-    if ( glyph_index >= blend->gv_glyphcnt      ||
-         blend->glyphoffsets[glyph_index] ==
-           blend->glyphoffsets[glyph_index + 1] )
-      return FT_Err_Ok;               /* no variation data for this glyph */
+    *agdeltas = NULL;
 
     if ( FT_STREAM_SEEK( blend->glyphoffsets[glyph_index] )   ||
          FT_FRAME_ENTER( blend->glyphoffsets[glyph_index + 1] -
                            blend->glyphoffsets[glyph_index] ) )
-      goto Fail1;
+      goto Exit;
 
     glyph_start = FT_Stream_FTell( stream );
 
     /* each set of glyph variation data is formatted similarly to `cvar' */
     /* (except we get shared points and global tuples)                   */
 
-    if ( FT_NEW_ARRAY( tuple_coords, blend->num_axis )    ||
-         FT_NEW_ARRAY( im_start_coords, blend->num_axis ) ||
-         FT_NEW_ARRAY( im_end_coords, blend->num_axis )   )
-      goto Fail2;
-
     tupleCount   = FT_GET_USHORT();
     offsetToData = glyph_start + FT_GET_USHORT();
 
+    if ( FT_NEW( gdeltas )                                                ||
+         FT_NEW_ARRAY( gdeltas->tuples,
+                       tupleCount & GX_TC_TUPLE_COUNT_MASK )              ||
+         FT_NEW_ARRAY( gdeltas->scalars,
+                       tupleCount & GX_TC_TUPLE_COUNT_MASK )              )
+      goto Fail;
+
+    gdeltas->glyph_index = glyph_index;
+    gdeltas->n_points    = n_points;
+    gdeltas->size        = sizeof ( GX_GlyphDeltasRec ) +
+                           ( tupleCount & GX_TC_TUPLE_COUNT_MASK ) *
+                             ( sizeof ( GX_TupleDeltasRec ) +
+                               sizeof ( FT_Fixed )          );
+
     if ( tupleCount & GX_TC_TUPLES_SHARE_POINT_NUMBERS )
     {
       here = FT_Stream_FTell( stream );
@@ -1365,131 +1978,478 @@
       offsetToData = FT_Stream_FTell( stream );
 
       FT_Stream_SeekSet( stream, here );
+
+      if ( sharedpoints != ALL_POINTS )
+      {
+        gdeltas->sharedpoints = sharedpoints;
+        gdeltas->size        += spoint_count * sizeof ( FT_UShort );
+      }
     }
 
     for ( i = 0; i < ( tupleCount & GX_TC_TUPLE_COUNT_MASK ); ++i )
     {
-      FT_UInt   tupleDataSize;
-      FT_UInt   tupleIndex;
-      FT_Fixed  apply;
+      GX_TupleDeltas  tuple = gdeltas->tuples + gdeltas->num_tuples;
+      FT_UInt         tupleDataSize;
+      FT_UInt         tupleIndex;
+      FT_UInt         point_count;
+      FT_UShort*      points;
 
 
       tupleDataSize = FT_GET_USHORT();
       tupleIndex    = FT_GET_USHORT();
 
-      if ( tupleIndex & GX_TI_EMBEDDED_TUPLE_COORD )
-      {
-        for ( j = 0; j < blend->num_axis; ++j )
-          tuple_coords[j] = FT_GET_SHORT() << 2;  /* convert from        */
-                                                  /* short frac to fixed */
-      }
-      else if ( ( tupleIndex & GX_TI_TUPLE_INDEX_MASK ) >= blend->tuplecount )
+      if ( !( tupleIndex & GX_TI_EMBEDDED_TUPLE_COORD )                  &&
+           ( tupleIndex & GX_TI_TUPLE_INDEX_MASK ) >= blend->tuplecount )
       {
         error = FT_THROW( Invalid_Table );
-        goto Fail3;
+        goto Fail;
       }
-      else
+
+      tuple->tupleIndex = tupleIndex;
+
+      /* the scalars of shared peak tuples are computed by */
+      /* `TT_Set_MM_Blend'; we only need the other ones    */
+      if ( tupleIndex & ( GX_TI_EMBEDDED_TUPLE_COORD |
+                          GX_TI_INTERMEDIATE_TUPLE   ) )
       {
-        FT_MEM_COPY(
-          tuple_coords,
-          &blend->tuplecoords[(tupleIndex & 0xFFF) * blend->num_axis],
-          blend->num_axis * sizeof ( FT_Fixed ) );
+        if ( FT_NEW_ARRAY( tuple->coords, 3 * blend->num_axis ) )
+          goto Fail;
+
+        if ( tupleIndex & GX_TI_EMBEDDED_TUPLE_COORD )
+        {
+          for ( j = 0; j < blend->num_axis; ++j )
+            tuple->coords[j] = FT_GET_SHORT() * 4;  /* convert from      */
+                                                    /* short frac to     */
+                                                    /* fixed             */
+        }
+        else
+          FT_MEM_COPY(
+            tuple->coords,
+            &blend->tuplecoords[( tupleIndex & GX_TI_TUPLE_INDEX_MASK ) *
+                                  blend->num_axis],
+            blend->num_axis * sizeof ( FT_Fixed ) );
+
+        if ( tupleIndex & GX_TI_INTERMEDIATE_TUPLE )
+        {
+          for ( j = 0; j < 2 * blend->num_axis; ++j )
+            tuple->coords[blend->num_axis + j] = FT_GET_SHORT() * 4;
+        }
+
+        gdeltas->size += 3 * blend->num_axis * sizeof ( FT_Fixed );
       }
 
-      if ( tupleIndex & GX_TI_INTERMEDIATE_TUPLE )
+      here = FT_Stream_FTell( stream );
+
+      FT_Stream_SeekSet( stream, offsetToData );
+
+      if ( tupleIndex & GX_TI_PRIVATE_POINT_NUMBERS )
+        points = ft_var_readpackedpoints( stream, &point_count );
+      else
       {
-        for ( j = 0; j < blend->num_axis; ++j )
-          im_start_coords[j] = FT_GET_SHORT() << 2;
-        for ( j = 0; j < blend->num_axis; ++j )
-          im_end_coords[j] = FT_GET_SHORT() << 2;
+        points      = sharedpoints;
+        point_count = spoint_count;
       }
 
-      apply = ft_var_apply_tuple( blend,
-                                  (FT_UShort)tupleIndex,
-                                  tuple_coords,
-                                  im_start_coords,
-                                  im_end_coords );
+      tuple->deltas_x = ft_var_readpackeddeltas( stream,
+                                                 point_count == 0
+                                                   ? n_points
+                                                   : point_count );
+      tuple->deltas_y = ft_var_readpackeddeltas( stream,
+                                                 point_count == 0
+                                                   ? n_points
+                                                   : point_count );
 
-      if ( apply == 0 )              /* tuple isn't active for our blend */
+      tuple->point_count = point_count;
+      tuple->points      = points == ALL_POINTS ? NULL : points;
+
+      if ( points == NULL                                     ||
+           tuple->deltas_x == NULL || tuple->deltas_y == NULL )
       {
-        offsetToData += tupleDataSize;
-        continue;
+        /* failure, ignore this tuple */
+        if ( tuple->points != sharedpoints )
+          FT_FREE( tuple->points );
+        FT_FREE( tuple->coords );
+        FT_FREE( tuple->deltas_x );
+        FT_FREE( tuple->deltas_y );
+      }
+      else
+      {
+        gdeltas->num_tuples++;
+        gdeltas->size += ( point_count == 0 ? n_points : point_count ) *
+                           2 * sizeof ( FT_Short );
+        if ( tuple->points != sharedpoints )
+          gdeltas->size += point_count * sizeof ( FT_UShort );
       }
 
-      here = FT_Stream_FTell( stream );
+      offsetToData += tupleDataSize;
 
-      if ( tupleIndex & GX_TI_PRIVATE_POINT_NUMBERS )
+      FT_Stream_SeekSet( stream, here );
+    }
+
+    FT_FRAME_EXIT();
+
+    *agdeltas = gdeltas;
+    goto Exit;
+
+  Fail:
+    FT_FRAME_EXIT();
+
+    ft_var_done_glyph_deltas( memory, gdeltas );
+
+  Exit:
+    return error;
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    TT_Vary_Get_Glyph_Deltas                                           */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Load the appropriate deltas for the current glyph.                 */
+  /*                                                                       */
+  /*    The decoded variation data of recently used glyphs is cached, and  */
+  /*    the tuple scalars are only computed once per glyph and set of      */
+  /*    blend coordinates.                                                 */
+  /*                                                                       */
+  /* <Input>                                                               */
+  /*    face        :: A handle to the target face object.                 */
+  /*                                                                       */
+  /*    glyph_index :: The index of the glyph being modified.              */
+  /*                                                                       */
+  /*    n_points    :: The number of the points in the glyph, including    */
+  /*                   phantom points.                                     */
+  /*                                                                       */
+  /* <Output>                                                              */
+  /*    deltas      :: The array of points to change.                      */
+  /*                                                                       */
+  /* <Return>                                                              */
+  /*    FreeType error code.  0 means success.                             */
+  /*                                                                       */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Vary_Get_Glyph_Deltas( TT_Face      face,
+                            FT_UInt      glyph_index,
+                            FT_Vector*  *deltas,
+                            FT_UInt      n_points )
+  {
+    FT_Memory        memory = face->root.memory;
+    GX_Blend         blend  = face->blend;
+    FT_Vector*       delta_xy = NULL;
+    GX_GlyphDeltas*  slot;
+    GX_GlyphDeltas   gdeltas;
+
+    FT_Error         error;
+    FT_UInt          i, j;
+
+
+    if ( !face->doblend || blend == NULL )
+      return FT_THROW( Invalid_Argument );
+
+    /* to be freed by the caller */
+    if ( FT_NEW_ARRAY( delta_xy, n_points ) )
+      goto Exit;
+    *deltas = delta_xy;
+
+    if ( glyph_index >= blend->gv_glyphcnt      ||
+         blend->glyphoffsets[glyph_index] ==
+           blend->glyphoffsets[glyph_index + 1] )
+      return FT_Err_Ok;               /* no variation data for this glyph */
+
+    slot    = &blend->glyph_deltas[glyph_index &
+                                   ( GX_GLYPH_DELTAS_CACHE_SIZE - 1 )];
+    gdeltas = *slot;
+
+    if ( gdeltas == NULL                     ||
+         gdeltas->glyph_index != glyph_index ||
+         gdeltas->n_points    != n_points    )
+    {
+      error = ft_var_load_glyph_deltas( face, glyph_index, n_points,
+                                        &gdeltas );
+      if ( error )
+        goto Fail;
+
+      /* replace the slot's old entry if the budget allows it */
+      if ( *slot != NULL )
       {
-        FT_Stream_SeekSet( stream, offsetToData );
+        blend->glyph_deltas_size -= (*slot)->size;
+        ft_var_done_glyph_deltas( memory, *slot );
+        *slot = NULL;
+      }
 
-        localpoints = ft_var_readpackedpoints( stream, &point_count );
-        points      = localpoints;
+      if ( blend->glyph_deltas_size + gdeltas->size <=
+             GX_GLYPH_DELTAS_MAX_BYTES                 )
+      {
+        blend->glyph_deltas_size += gdeltas->size;
+        *slot                     = gdeltas;
       }
-      else
+
+      gdeltas->coords_serial = blend->coords_serial - 1;
+    }
+
+    if ( gdeltas->coords_serial != blend->coords_serial )
+    {
+      for ( i = 0; i < gdeltas->num_tuples; ++i )
       {
-        points      = sharedpoints;
-        point_count = spoint_count;
+        GX_TupleDeltas  tuple = gdeltas->tuples + i;
+
+
+        if ( tuple->coords == NULL )
+          gdeltas->scalars[i] =
+            blend->tuplescalars[tuple->tupleIndex & GX_TI_TUPLE_INDEX_MASK];
+        else
+          gdeltas->scalars[i] =
+            ft_var_apply_tuple( blend,
+                                (FT_UShort)tuple->tupleIndex,
+                                tuple->coords,
+                                tuple->coords + blend->num_axis,
+                                tuple->coords + 2 * blend->num_axis );
       }
 
-      deltas_x = ft_var_readpackeddeltas( stream,
-                                          point_count == 0 ? n_points
-                                                           : point_count );
-      deltas_y = ft_var_readpackeddeltas( stream,
-                                          point_count == 0 ? n_points
-                                                           : point_count );
+      gdeltas->coords_serial = blend->coords_serial;
+    }
+
+    for ( i = 0; i < gdeltas->num_tuples; ++i )
+    {
+      GX_TupleDeltas  tuple = gdeltas->tuples + i;
+      FT_Int32        apply = (FT_Int32)gdeltas->scalars[i];
+      FT_Short*       dx    = tuple->deltas_x;
+      FT_Short*       dy    = tuple->deltas_y;
 
-      if ( points == NULL || deltas_y == NULL || deltas_x == NULL )
-        ; /* failure, ignore it */
 
-      else if ( points == ALL_POINTS )
+      if ( apply == 0 )              /* tuple isn't active for our blend */
+        continue;
+
+      /* `apply' is in the range [0;1], thus the products of the 16-bit */
+      /* deltas fit into 32 bits, and we can compute `FT_MulFix' in a   */
+      /* loop the compiler is able to vectorize                         */
+      if ( tuple->points == NULL )
       {
         /* this means that there are deltas for every point in the glyph */
         for ( j = 0; j < n_points; ++j )
         {
-          delta_xy[j].x += FT_MulFix( deltas_x[j], apply );
-          delta_xy[j].y += FT_MulFix( deltas_y[j], apply );
+          delta_xy[j].x += GX_MUL_DELTA( dx[j], apply );
+          delta_xy[j].y += GX_MUL_DELTA( dy[j], apply );
         }
       }
-
       else
       {
-        for ( j = 0; j < point_count; ++j )
+        FT_UShort*  points = tuple->points;
+
+
+        for ( j = 0; j < tuple->point_count; ++j )
         {
-          if ( localpoints[j] >= n_points )
+          if ( points[j] >= n_points )
             continue;
 
-          delta_xy[localpoints[j]].x += FT_MulFix( deltas_x[j], apply );
-          delta_xy[localpoints[j]].y += FT_MulFix( deltas_y[j], apply );
+          delta_xy[points[j]].x += GX_MUL_DELTA( dx[j], apply );
+          delta_xy[points[j]].y += GX_MUL_DELTA( dy[j], apply );
         }
       }
+    }
 
-      if ( localpoints != ALL_POINTS )
-        FT_FREE( localpoints );
-      FT_FREE( deltas_x );
-      FT_FREE( deltas_y );
+    /* the advances are varied with `HVAR' and `VVAR' if present; */
+    /* we must not move the phantom points a second time          */
+    if ( n_points >= 4 )
+    {
+      if ( blend->hvar_table != NULL )
+      {
+        delta_xy[n_points - 4].x = 0;
+        delta_xy[n_points - 4].y = 0;
+        delta_xy[n_points - 3].x = 0;
+        delta_xy[n_points - 3].y = 0;
+      }
+      if ( blend->vvar_table != NULL )
+      {
+        delta_xy[n_points - 2].x = 0;
+        delta_xy[n_points - 2].y = 0;
+        delta_xy[n_points - 1].x = 0;
+        delta_xy[n_points - 1].y = 0;
+      }
+    }
 
-      offsetToData += tupleDataSize;
+    if ( gdeltas != *slot )
+      ft_var_done_glyph_deltas( memory, gdeltas );
 
-      FT_Stream_SeekSet( stream, here );
+    return FT_Err_Ok;
+
+  Fail:
+    FT_FREE( delta_xy );
+    *deltas = NULL;
+
+  Exit:
+    return error;
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    ft_var_get_region_scalar                                           */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Compute the scalar of a region of an item variation store for the  */
+  /*    current blend.  In contrast to intermediate `gvar' tuples, the     */
+  /*    scalar is 1 if a coordinate equals the peak, even if the peak      */
+  /*    coincides with the start or end of the region.                     */
+  /*                                                                       */
+  /* <Input>                                                               */
+  /*    blend  :: The current blend of the font.                           */
+  /*                                                                       */
+  /*    peak   :: The peak coordinates of the region.  Axes with a zero    */
+  /*              peak are ignored.                                        */
+  /*                                                                       */
+  /*    start  :: The start coordinates of the region.                     */
+  /*                                                                       */
+  /*    end    :: The end coordinates of the region.                       */
+  /*                                                                       */
+  /* <Return>                                                              */
+  /*    The scalar in the range [0;1], as an FT_Fixed value.               */
+  /*                                                                       */
+  static FT_Fixed
+  ft_var_get_region_scalar( GX_Blend   blend,
+                            FT_Fixed*  peak,
+                            FT_Fixed*  start,
+                            FT_Fixed*  end )
+  {
+    FT_UInt   i;
+    FT_Fixed  scalar = 0x10000L;
+
+
+    for ( i = 0; i < blend->num_axis; ++i )
+    {
+      FT_Fixed  coord = blend->normalizedcoords[i];
+
+
+      if ( peak[i] == 0 || coord == peak[i] )
+        continue;
+
+      if ( coord <= start[i] || coord >= end[i] )
+        return 0;
+
+      if ( coord < peak[i] )
+        scalar = FT_MulDiv( scalar,
+                            coord - start[i],
+                            peak[i] - start[i] );
+      else
+        scalar = FT_MulDiv( scalar,
+                            end[i] - coord,
+                            end[i] - peak[i] );
     }
 
-  Fail3:
-    FT_FREE( tuple_coords );
-    FT_FREE( im_start_coords );
-    FT_FREE( im_end_coords );
+    return scalar;
+  }
 
-  Fail2:
-    FT_FRAME_EXIT();
 
-  Fail1:
-    if ( error )
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Function>                                                            */
+  /*    TT_Vary_Get_Advance_Delta                                          */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    Compute the advance width (or height) delta of a glyph for the     */
+  /*    current blend, using the `HVAR' (or `VVAR') table.  Unlike the     */
+  /*    phantom points of `gvar', this doesn't need the glyph's outline.   */
+  /*                                                                       */
+  /* <Input>                                                               */
+  /*    face        :: A handle to the target face object.                 */
+  /*                                                                       */
+  /*    glyph_index :: The glyph index.                                    */
+  /*                                                                       */
+  /*    vertical    :: If set, get the advance height delta.               */
+  /*                                                                       */
+  /* <Output>                                                              */
+  /*    adelta      :: The delta in font units.                            */
+  /*                                                                       */
+  /* <Return>                                                              */
+  /*    FreeType error code.  0 means success.                             */
+  /*    `FT_Err_Unimplemented_Feature' is returned if the face has no      */
+  /*    (valid) `HVAR' or `VVAR' table, respectively.                      */
+  /*                                                                       */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Vary_Get_Advance_Delta( TT_Face   face,
+                             FT_UInt   glyph_index,
+                             FT_Bool   vertical,
+                             FT_Int   *adelta )
+  {
+    GX_Blend         blend = face->blend;
+    GX_HVarTable     table;
+    GX_ItemVarStore  itemStore;
+    GX_ItemVarData   varData;
+    FT_UInt          outerIndex, innerIndex;
+    FT_Int*          deltaSet;
+    FT_Fixed         delta;
+    FT_UInt          i;
+
+
+    *adelta = 0;
+
+    if ( !face->doblend || blend == NULL )
+      return FT_THROW( Invalid_Argument );
+
+    table = vertical ? blend->vvar_table : blend->hvar_table;
+    if ( table == NULL )
+      return FT_THROW( Unimplemented_Feature );
+
+    itemStore = &table->itemStore;
+
+    if ( itemStore->scalars_serial != blend->coords_serial )
     {
-      FT_FREE( delta_xy );
-      *deltas = NULL;
+      for ( i = 0; i < itemStore->regionCount; ++i )
+      {
+        FT_Fixed*  peak = itemStore->regions + i * 3 * blend->num_axis;
+
+
+        itemStore->scalars[i] =
+          ft_var_get_region_scalar( blend,
+                                    peak,
+                                    peak + blend->num_axis,
+                                    peak + 2 * blend->num_axis );
+      }
+
+      itemStore->scalars_serial = blend->coords_serial;
     }
 
-  Exit:
-    return error;
+    if ( table->mapCount == 0 )
+    {
+      outerIndex = 0;
+      innerIndex = glyph_index;
+    }
+    else
+    {
+      /* glyphs beyond the mapping use its last entry */
+      if ( glyph_index >= table->mapCount )
+        glyph_index = table->mapCount - 1;
+
+      outerIndex = table->outerIndex[glyph_index];
+      innerIndex = table->innerIndex[glyph_index];
+    }
+
+    if ( outerIndex >= itemStore->dataCount )
+      return FT_Err_Ok;              /* no variation data for this glyph */
+
+    varData = itemStore->varData + outerIndex;
+    if ( innerIndex >= varData->itemCount )
+      return FT_Err_Ok;
+
+    deltaSet = varData->deltaSet + innerIndex * varData->regionIdxCount;
+    delta    = 0;
+
+    for ( i = 0; i < varData->regionIdxCount; ++i )
+    {
+      FT_Fixed  scalar = itemStore->scalars[varData->regionIndices[i]];
+
+
+      if ( scalar == 0 || deltaSet[i] == 0 )
+        continue;
+
+      /* round each term like the phantom point deltas of `gvar' */
+      delta += FT_MulFix( deltaSet[i], scalar );
+    }
+
+    *adelta = (FT_Int)delta;
+
+    return FT_Err_Ok;
   }
 
 
@@ -1520,6 +2480,34 @@
         FT_FREE( blend->avar_segment );
       }
 
+      for ( i = 0; i < GX_GLYPH_DELTAS_CACHE_SIZE; ++i )
+        ft_var_done_glyph_deltas( memory, blend->glyph_deltas[i] );
+
+      for ( i = 0; i < blend->num_instances; ++i )
+      {
+        FT_FREE( blend->instances[i].normalizedcoords );
+        FT_FREE( blend->instances[i].cvt );
+      }
+
+      if ( blend->hvar_table != NULL )
+      {
+        ft_var_done_item_variation_store( memory,
+                                          &blend->hvar_table->itemStore );
+        FT_FREE( blend->hvar_table->outerIndex );
+        FT_FREE( blend->hvar_table->innerIndex );
+        FT_FREE( blend->hvar_table );
+      }
+
+      if ( blend->vvar_table != NULL )
+      {
+        ft_var_done_item_variation_store( memory,
+                                          &blend->vvar_table->itemStore );
+        FT_FREE( blend->vvar_table->outerIndex );
+        FT_FREE( blend->vvar_table->innerIndex );
+        FT_FREE( blend->vvar_table );
+      }
+
+      FT_FREE( blend->tuplescalars );
       FT_FREE( blend->tuplecoords );
       FT_FREE( blend->glyphoffsets );
       FT_FREE( blend );
@@ -61,6 +61,222 @@ FT_BEGIN_HEADER
   } GX_AVarSegmentRec, *GX_AVarSegment;
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    GX_TupleDeltasRec                                                  */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    The decoded data of a tuple in a glyph's `gvar' variation data.    */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    tupleIndex  :: The tuple's flags, and the index of its peak        */
+  /*                   coordinates in the shared tuples of `gvar' (unless  */
+  /*                   they are embedded).                                 */
+  /*                                                                       */
+  /*    coords      :: The peak, start, and end coordinates of an embedded */
+  /*                   or intermediate tuple (three arrays of `num_axis'   */
+  /*                   elements each); NULL for a shared peak tuple.       */
+  /*                                                                       */
+  /*    point_count :: The number of points with deltas; 0 means all.      */
+  /*                                                                       */
+  /*    points      :: The point numbers; NULL if `point_count' is 0.      */
+  /*                   May be the glyph's shared point numbers.            */
+  /*                                                                       */
+  /*    deltas_x    :: The horizontal deltas.                              */
+  /*                                                                       */
+  /*    deltas_y    :: The vertical deltas.                                */
+  /*                                                                       */
+  typedef struct  GX_TupleDeltasRec_
+  {
+    FT_UInt     tupleIndex;
+    FT_Fixed*   coords;
+    FT_UInt     point_count;
+    FT_UShort*  points;
+    FT_Short*   deltas_x;
+    FT_Short*   deltas_y;
+
+  } GX_TupleDeltasRec, *GX_TupleDeltas;
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    GX_GlyphDeltasRec                                                  */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    The decoded `gvar' variation data of a glyph, independent of the   */
+  /*    blend coordinates.  Together with the tuple scalars for the        */
+  /*    current coordinates, it is kept in a small cache so that changing  */
+  /*    the blend only costs a multiply-accumulate per point and tuple.    */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    glyph_index   :: The glyph index.                                  */
+  /*                                                                       */
+  /*    n_points      :: The number of points (including phantom points)   */
+  /*                     the data has been decoded for.                    */
+  /*                                                                       */
+  /*    num_tuples    :: The number of valid tuples.                       */
+  /*                                                                       */
+  /*    tuples        :: An array of `num_tuples' tuples.                  */
+  /*                                                                       */
+  /*    sharedpoints  :: The shared point numbers of the tuples, if any.   */
+  /*                                                                       */
+  /*    scalars       :: The scalars of the tuples for the blend           */
+  /*                     coordinates identified by `coords_serial'.        */
+  /*                                                                       */
+  /*    coords_serial :: See @GX_BlendRec.                                 */
+  /*                                                                       */
+  /*    size          :: The number of bytes allocated for this record.    */
+  /*                                                                       */
+  typedef struct  GX_GlyphDeltasRec_
+  {
+    FT_UInt         glyph_index;
+    FT_UInt         n_points;
+    FT_UInt         num_tuples;
+    GX_TupleDeltas  tuples;
+    FT_UShort*      sharedpoints;
+    FT_Fixed*       scalars;
+    FT_ULong        coords_serial;
+    FT_Offset       size;
+
+  } GX_GlyphDeltasRec, *GX_GlyphDeltas;
+
+
+  /* the number of slots in the glyph deltas cache, a power of 2 */
+#define GX_GLYPH_DELTAS_CACHE_SIZE  256
+
+  /* the maximum number of bytes held by the glyph deltas cache */
+#define GX_GLYPH_DELTAS_MAX_BYTES  0x80000L
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    GX_ItemVarDataRec                                                  */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    An `ItemVariationData' subtable of an item variation store.        */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    itemCount      :: The number of delta sets.                        */
+  /*                                                                       */
+  /*    regionIdxCount :: The number of regions (and deltas per set).      */
+  /*                                                                       */
+  /*    regionIndices  :: The indices of the regions in the store's region */
+  /*                      list.                                            */
+  /*                                                                       */
+  /*    deltaSet       :: The deltas, `itemCount' rows of `regionIdxCount' */
+  /*                      values each.                                     */
+  /*                                                                       */
+  typedef struct  GX_ItemVarDataRec_
+  {
+    FT_UInt   itemCount;
+    FT_UInt   regionIdxCount;
+    FT_UInt*  regionIndices;
+    FT_Int*   deltaSet;
+
+  } GX_ItemVarDataRec, *GX_ItemVarData;
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    GX_ItemVarStoreRec                                                 */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    An item variation store, as used by the `HVAR' and `VVAR' tables.  */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    dataCount      :: The number of `ItemVariationData' subtables.     */
+  /*                                                                       */
+  /*    varData        :: The subtables.                                   */
+  /*                                                                       */
+  /*    regionCount    :: The number of regions.                           */
+  /*                                                                       */
+  /*    regions        :: The peak, start, and end coordinates of the      */
+  /*                      regions, `regionCount' rows laid out like the    */
+  /*                      `coords' field of @GX_TupleDeltasRec.            */
+  /*                                                                       */
+  /*    scalars        :: The scalars of the regions for the instance      */
+  /*                      identified by `scalars_serial'.                  */
+  /*                                                                       */
+  /*    scalars_serial :: See @GX_BlendRec.                                */
+  /*                                                                       */
+  typedef struct  GX_ItemVarStoreRec_
+  {
+    FT_UInt         dataCount;
+    GX_ItemVarData  varData;
+
+    FT_UInt         regionCount;
+    FT_Fixed*       regions;
+
+    FT_Fixed*       scalars;
+    FT_ULong        scalars_serial;
+
+  } GX_ItemVarStoreRec, *GX_ItemVarStore;
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    GX_HVarTableRec                                                    */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    The data of an `HVAR' or `VVAR' table needed for advances.         */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    itemStore  :: The item variation store.                            */
+  /*                                                                       */
+  /*    mapCount   :: The number of entries in the advance mapping; 0 if   */
+  /*                  glyph indices are used as inner indices directly.    */
+  /*                                                                       */
+  /*    outerIndex :: The outer (subtable) indices of the mapping.         */
+  /*                                                                       */
+  /*    innerIndex :: The inner (delta set) indices of the mapping.        */
+  /*                                                                       */
+  typedef struct  GX_HVarTableRec_
+  {
+    GX_ItemVarStoreRec  itemStore;
+
+    FT_UInt             mapCount;
+    FT_UShort*          outerIndex;
+    FT_UShort*          innerIndex;
+
+  } GX_HVarTableRec, *GX_HVarTable;
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* <Struct>                                                              */
+  /*    GX_InstanceRec                                                     */
+  /*                                                                       */
+  /* <Description>                                                         */
+  /*    A set of blend coordinates used recently with a face, together     */
+  /*    with the data depending on it.  Switching back to these            */
+  /*    coordinates restores the data instead of recomputing it.           */
+  /*                                                                       */
+  /* <Fields>                                                              */
+  /*    serial           :: A number identifying the instance; it is never */
+  /*                        reused for other coordinates of the same face. */
+  /*                                                                       */
+  /*    normalizedcoords :: The normalized blend coordinates.              */
+  /*                                                                       */
+  /*    cvt              :: The varied CVT; NULL if the face has no CVT.   */
+  /*                                                                       */
+  typedef struct  GX_InstanceRec_
+  {
+    FT_ULong   serial;
+    FT_Fixed*  normalizedcoords;
+    FT_Short*  cvt;
+
+  } GX_InstanceRec, *GX_Instance;
+
+
+  /* the number of blend instances kept per face */
+#define GX_MAX_INSTANCES  8
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Struct>                                                              */
@@ -78,6 +294,33 @@ FT_BEGIN_HEADER
   /*                        the contribution along each axis to the final  */
   /*                        interpolated font.                             */
   /*                                                                       */
+  /*    coords_serial    :: The serial number of the current instance;     */
+  /*                        identifies the values of `tuplescalars' and    */
+  /*                        the cached glyph scalars, and the results of   */
+  /*                        the CVT program.                               */
+  /*                                                                       */
+  /*    last_serial      :: The serial number of the last instance         */
+  /*                        created.                                       */
+  /*                                                                       */
+  /*    num_instances    :: The number of valid elements in `instances'.   */
+  /*                                                                       */
+  /*    instances        :: The recently used instances, most recently     */
+  /*                        used first.                                    */
+  /*                                                                       */
+  /*    hvar_table       :: The `HVAR' data, if any.  If set, it replaces  */
+  /*                        the horizontal phantom point deltas of `gvar'. */
+  /*                                                                       */
+  /*    vvar_table       :: The `VVAR' data, if any.  If set, it replaces  */
+  /*                        the vertical phantom point deltas of `gvar'.   */
+  /*                                                                       */
+  /*    tuplescalars     :: The scalars of the shared (non-intermediate)   */
+  /*                        tuples of `gvar' for the current coordinates.  */
+  /*                                                                       */
+  /*    glyph_deltas     :: A direct-mapped cache of decoded glyph         */
+  /*                        variation data, indexed by glyph index.        */
+  /*                                                                       */
+  /*    glyph_deltas_size :: The number of bytes held by `glyph_deltas'.   */
+  /*                                                                       */
   typedef struct  GX_BlendRec_
   {
     FT_UInt         num_axis;
@@ -95,6 +338,19 @@ FT_BEGIN_HEADER
     FT_UInt         gv_glyphcnt;
     FT_ULong*       glyphoffsets;
 
+    FT_ULong        coords_serial;
+    FT_Fixed*       tuplescalars;    /* tuplescalars[tuplecount]          */
+
+    FT_ULong        last_serial;
+    FT_UInt         num_instances;
+    GX_InstanceRec  instances[GX_MAX_INSTANCES];
+
+    GX_HVarTable    hvar_table;
+    GX_HVarTable    vvar_table;
+
+    GX_GlyphDeltas  glyph_deltas[GX_GLYPH_DELTAS_CACHE_SIZE];
+    FT_Offset       glyph_deltas_size;
+
   } GX_BlendRec;
 
 
@@ -141,6 +397,11 @@ FT_BEGIN_HEADER
 #define TTAG_slnt  FT_MAKE_TAG( 's', 'l', 'n', 't' )
 
 
+  /* the serial number of the current blend instance of `face', or 0 */
+#define TT_BLEND_INSTANCE( face )                                \
+          ( (face)->doblend ? (face)->blend->coords_serial : 0 )
+
+
   FT_LOCAL( FT_Error )
   TT_Set_MM_Blend( TT_Face    face,
                    FT_UInt    num_coords,
@@ -168,6 +429,13 @@ FT_BEGIN_HEADER
                             FT_UInt      n_points );
 
 
+  FT_LOCAL( FT_Error )
+  TT_Vary_Get_Advance_Delta( TT_Face   face,
+                             FT_UInt   glyph_index,
+                             FT_Bool   vertical,
+                             FT_Int   *adelta );
+
+
   FT_LOCAL( void )
   tt_done_blend( FT_Memory  memory,
                  GX_Blend   blend );
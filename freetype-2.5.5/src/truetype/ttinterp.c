@@ -760,7 +760,9 @@
   FT_EXPORT_DEF( TT_ExecContext )
   TT_New_Context( TT_Driver  driver )
   {
-    FT_Memory  memory;
+    FT_Memory       memory;
+    FT_Error        error;
+    TT_ExecContext  exec = NULL;
 
 
     if ( !driver )
@@ -768,26 +770,16 @@
 
     memory = driver->root.root.memory;
 
-    if ( !driver->context )
-    {
-      FT_Error        error;
-      TT_ExecContext  exec;
-
-
-      /* allocate object */
-      if ( FT_NEW( exec ) )
-        goto Fail;
-
-      /* initialize it; in case of error this deallocates `exec' too */
-      error = Init_Context( exec, memory );
-      if ( error )
-        goto Fail;
+    /* allocate object */
+    if ( FT_NEW( exec ) )
+      goto Fail;
 
-      /* store it into the driver */
-      driver->context = exec;
-    }
+    /* initialize it; in case of error this deallocates `exec' too */
+    error = Init_Context( exec, memory );
+    if ( error )
+      goto Fail;
 
-    return driver->context;
+    return exec;
 
   Fail:
     return NULL;
@@ -8203,6 +8195,12 @@
   /*************************************************************************/
 
 
+  /* add the number of executed instructions to the library's counter */
+#define TT_COUNT_INSTRUCTIONS()                               \
+          FT_COUNTER_ADD( FT_FACE_LIBRARY( CUR.face ),        \
+                          FT_COUNTER_INSTRUCTIONS, ins_counter )
+
+
   /* documentation is in ttinterp.h */
 
   FT_EXPORT_DEF( FT_Error )
@@ -8969,7 +8967,10 @@
       /* increment instruction counter and check if we didn't */
       /* run this program for too long (e.g. infinite loops). */
       if ( ++ins_counter > MAX_RUNNABLE_OPCODES )
+      {
+        TT_COUNT_INSTRUCTIONS();
         return FT_THROW( Execution_Too_Long );
+      }
 
     LSuiteLabel_:
       if ( CUR.IP >= CUR.codeSize )
@@ -8985,6 +8986,7 @@
     } while ( !CUR.instruction_trap );
 
   LNo_Error_:
+    TT_COUNT_INSTRUCTIONS();
 
 #ifdef TT_CONFIG_OPTION_STATIC_RASTER
     *exc = cur;
@@ -8996,6 +8998,7 @@
     CUR.error = FT_THROW( Code_Overflow );
 
   LErrorLabel_:
+    TT_COUNT_INSTRUCTIONS();
 
 #ifdef TT_CONFIG_OPTION_STATIC_RASTER
     *exc = cur;
@@ -327,18 +327,19 @@ FT_BEGIN_HEADER
   /*    TT_New_Context                                                     */
   /*                                                                       */
   /* <Description>                                                         */
-  /*    Queries the face context for a given font.  Note that there is     */
-  /*    now a _single_ execution context in the TrueType driver which is   */
-  /*    shared among faces.                                                */
+  /*    Create a new execution context.  Every size object of a face has  */
+  /*    its own one, so that no interpreter state is shared between faces. */
   /*                                                                       */
   /* <Input>                                                               */
-  /*    face :: A handle to the source face object.                        */
+  /*    driver :: A handle to the TrueType driver.                         */
   /*                                                                       */
   /* <Return>                                                              */
-  /*    A handle to the execution context.  Initialized for `face'.        */
+  /*    A handle to the execution context.  Its buffers are sized to the   */
+  /*    limits of the face it gets loaded with (see `TT_Load_Context').    */
   /*                                                                       */
   /* <Note>                                                                */
   /*    Only the glyph loader and debugger should call this function.      */
+  /*    The context is destroyed together with its size object.            */
   /*                                                                       */
   FT_EXPORT( TT_ExecContext )
   TT_New_Context( TT_Driver  driver );
@@ -693,6 +693,13 @@
     if ( face->extra.finalizer )
       face->extra.finalizer( face->extra.data );
 
+    /* with arena memory, the tables are discarded by the arena's owner */
+    if ( ft_mem_is_arena( memory ) )
+    {
+      face->sfnt = NULL;
+      return;
+    }
+
     if ( sfnt )
       sfnt->done_face( face );
 
@@ -701,6 +708,18 @@
 
     tt_face_free_hdmx( face );
 
+#ifdef TT_USE_BYTECODE_INTERPRETER
+    /* freeing the bytecode cache */
+    if ( face->bytecode_cache )
+    {
+      tt_face_flush_prep_cache( face );
+
+      FT_FREE( face->bytecode_cache->function_defs );
+      FT_FREE( face->bytecode_cache->instruction_defs );
+      FT_FREE( face->bytecode_cache );
+    }
+#endif
+
     /* freeing the CVT */
     FT_FREE( face->cvt );
     face->cvt_size = 0;
@@ -726,6 +745,407 @@
 
 #ifdef TT_USE_BYTECODE_INTERPRETER
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* The results of the font and CVT programs only depend on the face, the */
+  /* scaling values, and the following settings of the interpreter; they   */
+  /* are shared by all sizes of a face (see `TT_BytecodeCacheRec').        */
+  /*                                                                       */
+  static FT_UInt
+  tt_exec_mode( TT_ExecContext  exec,
+                FT_Bool         pedantic )
+  {
+    FT_UInt  mode = 0;
+
+
+    if ( pedantic )
+      mode |= 1;
+    if ( exec->grayscale )
+      mode |= 2;
+
+#ifdef TT_CONFIG_OPTION_SUBPIXEL_HINTING
+    if ( exec->subpixel )
+      mode |= 4;
+    if ( exec->compatible_widths )
+      mode |= 8;
+    if ( exec->symmetrical_smoothing )
+      mode |= 16;
+    if ( exec->bgr )
+      mode |= 32;
+
+    mode |= (FT_UInt)exec->rasterizer_version << 8;
+#endif
+
+    return mode;
+  }
+
+
+  /* Return the shared bytecode state of `size's face, or NULL if it */
+  /* can't be used.                                                   */
+  static TT_BytecodeCache
+  tt_size_get_bytecode_cache( TT_Size  size )
+  {
+    TT_Face    face   = (TT_Face)size->root.face;
+    FT_Memory  memory = face->root.memory;
+    FT_Error   error;
+
+
+    /* debuggers want to see every instruction */
+    if ( size->debug                                          ||
+         face->interpreter != (TT_Interpreter)TT_RunIns       )
+      return NULL;
+
+#ifdef TT_CONFIG_OPTION_SUBPIXEL_HINTING
+    /* with subpixel hinting, the interpreter's behaviour can */
+    /* depend on tweaks for the current glyph                 */
+    if ( size->context->ignore_x_mode )
+      return NULL;
+#endif
+
+    if ( !face->bytecode_cache && FT_NEW( face->bytecode_cache ) )
+      return NULL;
+
+    return face->bytecode_cache;
+  }
+
+
+  static void
+  tt_prep_state_done( FT_Memory     memory,
+                      TT_PrepState  state )
+  {
+    FT_FREE( state->cvt );
+    FT_FREE( state->storage );
+    FT_FREE( state->twilight_org );
+    FT_FREE( state->twilight_cur );
+    FT_FREE( state->twilight_tags );
+    FT_FREE( state->function_defs );
+    FT_FREE( state->instruction_defs );
+  }
+
+
+  /* Forget all cached results of the CVT program, for example after */
+  /* the CVT of the face has been changed.                            */
+  FT_LOCAL_DEF( void )
+  tt_face_flush_prep_cache( TT_Face  face )
+  {
+    TT_BytecodeCache  cache  = face->bytecode_cache;
+    FT_Memory         memory = face->root.memory;
+    FT_UInt           n;
+
+
+    if ( !cache )
+      return;
+
+    for ( n = 0; n < cache->num_preps; n++ )
+      tt_prep_state_done( memory, &cache->preps[n] );
+
+    cache->num_preps = 0;
+  }
+
+
+  /* Record the function and instruction definitions of the font */
+  /* program; `size' has just executed it.                       */
+  static void
+  tt_size_store_fpgm( TT_Size   size,
+                      FT_UInt   mode,
+                      FT_Error  fpgm_error )
+  {
+    TT_Face           face   = (TT_Face)size->root.face;
+    FT_Memory         memory = face->root.memory;
+    TT_BytecodeCache  cache;
+    FT_Error          error;
+
+
+    cache = tt_size_get_bytecode_cache( size );
+    if ( !cache )
+      return;
+
+    /* the cached CVT program results refer to the old definitions */
+    tt_face_flush_prep_cache( face );
+
+    FT_FREE( cache->function_defs );
+    FT_FREE( cache->instruction_defs );
+    cache->fpgm_valid = FALSE;
+
+    if ( !fpgm_error )
+    {
+      if ( FT_QNEW_ARRAY( cache->function_defs,
+                          size->max_function_defs )       ||
+           FT_QNEW_ARRAY( cache->instruction_defs,
+                          size->max_instruction_defs )    )
+      {
+        FT_FREE( cache->function_defs );
+        return;
+      }
+
+      if ( size->max_function_defs )
+        FT_ARRAY_COPY( cache->function_defs,
+                       size->function_defs,
+                       size->max_function_defs );
+      if ( size->max_instruction_defs )
+        FT_ARRAY_COPY( cache->instruction_defs,
+                       size->instruction_defs,
+                       size->max_instruction_defs );
+    }
+
+    cache->num_function_defs    = size->num_function_defs;
+    cache->num_instruction_defs = size->num_instruction_defs;
+    cache->max_func             = size->max_func;
+    cache->max_ins              = size->max_ins;
+
+    cache->fpgm_mode  = mode;
+    cache->fpgm_error = fpgm_error;
+    cache->fpgm_valid = TRUE;
+  }
+
+
+  /* Give `size' the state after running the font program, if there is */
+  /* a cached one.                                                      */
+  static FT_Bool
+  tt_size_restore_fpgm( TT_Size  size,
+                        FT_UInt  mode )
+  {
+    TT_Face           face = (TT_Face)size->root.face;
+    TT_BytecodeCache  cache;
+
+
+    cache = tt_size_get_bytecode_cache( size );
+    if ( !cache || !cache->fpgm_valid || cache->fpgm_mode != mode )
+      return FALSE;
+
+    if ( !cache->fpgm_error )
+    {
+      if ( size->max_function_defs )
+        FT_ARRAY_COPY( size->function_defs,
+                       cache->function_defs,
+                       size->max_function_defs );
+      if ( size->max_instruction_defs )
+        FT_ARRAY_COPY( size->instruction_defs,
+                       cache->instruction_defs,
+                       size->max_instruction_defs );
+
+      size->num_function_defs    = cache->num_function_defs;
+      size->num_instruction_defs = cache->num_instruction_defs;
+      size->max_func             = cache->max_func;
+      size->max_ins              = cache->max_ins;
+
+      /* this is what `TT_Save_Context' would have stored */
+      size->codeRangeTable[tt_coderange_font - 1].base =
+        face->font_program;
+      size->codeRangeTable[tt_coderange_font - 1].size =
+        face->font_program_size;
+      size->codeRangeTable[tt_coderange_cvt - 1].base   = NULL;
+      size->codeRangeTable[tt_coderange_cvt - 1].size   = 0;
+      size->codeRangeTable[tt_coderange_glyph - 1].base = NULL;
+      size->codeRangeTable[tt_coderange_glyph - 1].size = 0;
+    }
+
+    size->bytecode_ready = cache->fpgm_error;
+
+    return TRUE;
+  }
+
+
+  static FT_Bool
+  tt_prep_state_match( TT_PrepState  state,
+                       TT_Size       size,
+                       FT_UInt       mode )
+  {
+    return FT_BOOL( state->mode     == mode                        &&
+                    state->instance == size->instance              &&
+                    state->x_ppem   == size->metrics.x_ppem        &&
+                    state->y_ppem   == size->metrics.y_ppem        &&
+                    state->x_scale  == size->metrics.x_scale       &&
+                    state->y_scale  == size->metrics.y_scale       &&
+                    state->ppem     == size->ttmetrics.ppem        &&
+                    state->scale    == size->ttmetrics.scale       &&
+                    state->x_ratio  == size->ttmetrics.x_ratio     &&
+                    state->y_ratio  == size->ttmetrics.y_ratio     );
+  }
+
+
+  /* Record the state of `size' after running the CVT program. */
+  static void
+  tt_size_store_prep( TT_Size   size,
+                      FT_UInt   mode,
+                      FT_Error  prep_error )
+  {
+    TT_Face           face   = (TT_Face)size->root.face;
+    FT_Memory         memory = face->root.memory;
+    TT_BytecodeCache  cache;
+    TT_PrepStateRec   state;
+    FT_UInt           n_twilight;
+    FT_Error          error;
+
+
+    cache = tt_size_get_bytecode_cache( size );
+
+    /* the function definitions are stored relative to the font program */
+    if ( !cache || !cache->fpgm_valid || cache->fpgm_mode != mode )
+      return;
+
+    FT_ZERO( &state );
+
+    state.mode     = mode;
+    state.instance = size->instance;
+    state.x_ppem   = size->metrics.x_ppem;
+    state.y_ppem   = size->metrics.y_ppem;
+    state.x_scale  = size->metrics.x_scale;
+    state.y_scale  = size->metrics.y_scale;
+    state.ppem     = size->ttmetrics.ppem;
+    state.scale    = size->ttmetrics.scale;
+    state.x_ratio  = size->ttmetrics.x_ratio;
+    state.y_ratio  = size->ttmetrics.y_ratio;
+
+    state.error = prep_error;
+    state.GS    = size->GS;
+
+    n_twilight = (FT_UInt)size->twilight.n_points;
+
+    if ( FT_QNEW_ARRAY( state.cvt, size->cvt_size )         ||
+         FT_QNEW_ARRAY( state.storage, size->storage_size ) ||
+         FT_QNEW_ARRAY( state.twilight_org, n_twilight )    ||
+         FT_QNEW_ARRAY( state.twilight_cur, n_twilight )    ||
+         FT_QNEW_ARRAY( state.twilight_tags, n_twilight )   )
+      goto Fail;
+
+    if ( size->cvt_size )
+      FT_ARRAY_COPY( state.cvt, size->cvt, size->cvt_size );
+    if ( size->storage_size )
+      FT_ARRAY_COPY( state.storage, size->storage, size->storage_size );
+    if ( n_twilight )
+    {
+      FT_ARRAY_COPY( state.twilight_org, size->twilight.org, n_twilight );
+      FT_ARRAY_COPY( state.twilight_cur, size->twilight.cur, n_twilight );
+      FT_ARRAY_COPY( state.twilight_tags, size->twilight.tags, n_twilight );
+    }
+
+    state.num_function_defs    = size->num_function_defs;
+    state.num_instruction_defs = size->num_instruction_defs;
+    state.max_func             = size->max_func;
+    state.max_ins              = size->max_ins;
+
+    /* `prep' rarely defines functions; don't store the tables if */
+    /* they are unchanged                                         */
+    if ( size->num_function_defs    != cache->num_function_defs    ||
+         size->num_instruction_defs != cache->num_instruction_defs ||
+         ( size->max_function_defs                               &&
+           ft_memcmp( size->function_defs,
+                      cache->function_defs,
+                      size->max_function_defs *
+                        sizeof ( TT_DefRecord ) ) )                ||
+         ( size->max_instruction_defs                            &&
+           ft_memcmp( size->instruction_defs,
+                      cache->instruction_defs,
+                      size->max_instruction_defs *
+                        sizeof ( TT_DefRecord ) ) )                )
+    {
+      if ( FT_QNEW_ARRAY( state.function_defs,
+                          size->max_function_defs )       ||
+           FT_QNEW_ARRAY( state.instruction_defs,
+                          size->max_instruction_defs )    )
+        goto Fail;
+
+      if ( size->max_function_defs )
+        FT_ARRAY_COPY( state.function_defs,
+                       size->function_defs,
+                       size->max_function_defs );
+      if ( size->max_instruction_defs )
+        FT_ARRAY_COPY( state.instruction_defs,
+                       size->instruction_defs,
+                       size->max_instruction_defs );
+    }
+
+    /* drop the least recently used entry if necessary */
+    if ( cache->num_preps == TT_PREP_CACHE_SIZE )
+      tt_prep_state_done( memory, &cache->preps[--cache->num_preps] );
+
+    ft_memmove( cache->preps + 1,
+                cache->preps,
+                cache->num_preps * sizeof ( TT_PrepStateRec ) );
+    cache->preps[0] = state;
+    cache->num_preps++;
+    return;
+
+  Fail:
+    /* the cache is an optimization only; ignore allocation errors */
+    tt_prep_state_done( memory, &state );
+  }
+
+
+  /* Give `size' the state after running the CVT program, if there is */
+  /* a cached one for its scaling values.                              */
+  static FT_Bool
+  tt_size_restore_prep( TT_Size  size,
+                        FT_UInt  mode )
+  {
+    TT_Face           face = (TT_Face)size->root.face;
+    TT_BytecodeCache  cache;
+    TT_PrepStateRec   state;
+    FT_UInt           n, n_twilight;
+
+
+    cache = tt_size_get_bytecode_cache( size );
+    if ( !cache || !cache->fpgm_valid || cache->fpgm_mode != mode )
+      return FALSE;
+
+    for ( n = 0; n < cache->num_preps; n++ )
+      if ( tt_prep_state_match( &cache->preps[n], size, mode ) )
+        break;
+
+    if ( n == cache->num_preps )
+      return FALSE;
+
+    /* move entry to the front */
+    state = cache->preps[n];
+    ft_memmove( cache->preps + 1,
+                cache->preps,
+                n * sizeof ( TT_PrepStateRec ) );
+    cache->preps[0] = state;
+
+    n_twilight = (FT_UInt)size->twilight.n_points;
+
+    if ( size->cvt_size )
+      FT_ARRAY_COPY( size->cvt, state.cvt, size->cvt_size );
+    if ( size->storage_size )
+      FT_ARRAY_COPY( size->storage, state.storage, size->storage_size );
+    if ( n_twilight )
+    {
+      FT_ARRAY_COPY( size->twilight.org, state.twilight_org, n_twilight );
+      FT_ARRAY_COPY( size->twilight.cur, state.twilight_cur, n_twilight );
+      FT_ARRAY_COPY( size->twilight.tags, state.twilight_tags, n_twilight );
+    }
+
+    /* the size's tables might have been changed by glyph programs */
+    if ( size->max_function_defs )
+      FT_ARRAY_COPY( size->function_defs,
+                     state.function_defs ? state.function_defs
+                                         : cache->function_defs,
+                     size->max_function_defs );
+    if ( size->max_instruction_defs )
+      FT_ARRAY_COPY( size->instruction_defs,
+                     state.instruction_defs ? state.instruction_defs
+                                            : cache->instruction_defs,
+                     size->max_instruction_defs );
+
+    size->num_function_defs    = state.num_function_defs;
+    size->num_instruction_defs = state.num_instruction_defs;
+    size->max_func             = state.max_func;
+    size->max_ins              = state.max_ins;
+
+    size->codeRangeTable[tt_coderange_cvt - 1].base   = face->cvt_program;
+    size->codeRangeTable[tt_coderange_cvt - 1].size   =
+      face->cvt_program_size;
+    size->codeRangeTable[tt_coderange_glyph - 1].base = NULL;
+    size->codeRangeTable[tt_coderange_glyph - 1].size = 0;
+
+    size->GS        = state.GS;
+    size->cvt_ready = state.error;
+
+    return TRUE;
+  }
+
+
   /*************************************************************************/
   /*                                                                       */
   /* <Function>                                                            */
@@ -751,15 +1171,14 @@
     FT_Error        error;
 
 
-    /* debugging instances have their own context */
-    if ( size->debug )
-      exec = size->context;
-    else
-      exec = ( (TT_Driver)FT_FACE_DRIVER( face ) )->context;
-
+    exec = size->context;
     if ( !exec )
       return FT_THROW( Could_Not_Find_Context );
 
+    /* another size of this face has already run the font program */
+    if ( tt_size_restore_fpgm( size, tt_exec_mode( exec, pedantic ) ) )
+      return size->bytecode_ready;
+
     error = TT_Load_Context( exec, face, size );
     if ( error )
       return error;
@@ -816,6 +1235,8 @@
     if ( !error )
       TT_Save_Context( exec, size );
 
+    tt_size_store_fpgm( size, tt_exec_mode( exec, pedantic ), error );
+
     return error;
   }
 
@@ -845,12 +1266,7 @@
     FT_Error        error;
 
 
-    /* debugging instances have their own context */
-    if ( size->debug )
-      exec = size->context;
-    else
-      exec = ( (TT_Driver)FT_FACE_DRIVER( face ) )->context;
-
+    exec = size->context;
     if ( !exec )
       return FT_THROW( Could_Not_Find_Context );
 
@@ -931,6 +1347,11 @@
       size->context = NULL;
       size->debug   = FALSE;
     }
+    else if ( size->context )
+    {
+      TT_Done_Context( size->context );
+      size->context = NULL;
+    }
 
     FT_FREE( size->cvt );
     size->cvt_size = 0;
@@ -1035,6 +1456,18 @@
         face->interpreter = (TT_Interpreter)TT_RunIns;
     }
 
+    /* create the size's execution context; `TT_Load_Context' adjusts */
+    /* its buffers to the limits given in the `maxp' table            */
+    if ( !size->context )
+    {
+      size->context = TT_New_Context( (TT_Driver)face->root.driver );
+      if ( !size->context )
+      {
+        error = FT_THROW( Could_Not_Find_Context );
+        goto Exit;
+      }
+    }
+
     /* Fine, now run the font program! */
     error = tt_size_run_fpgm( size, pedantic );
 
@@ -1062,14 +1495,23 @@
     /* rescale CVT when needed */
     if ( size->cvt_ready < 0 )
     {
-      FT_UInt  i;
-      TT_Face  face = (TT_Face)size->root.face;
+      FT_UInt   i;
+      TT_Face   face  = (TT_Face)size->root.face;
+      FT_Long*  cvt   = size->cvt;
+      FT_Fixed  scale = size->ttmetrics.scale;
+
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+      /* the face's CVT depends on the blend instance */
+      size->instance = TT_BLEND_INSTANCE( face );
+#endif
 
       /* Scale the cvt values to the new ppem.          */
       /* We use by default the y ppem to scale the CVT. */
+      /* (`cvt' and `scale' are cached in locals since  */
+      /* the stores could otherwise alias them.)        */
       for ( i = 0; i < size->cvt_size; i++ )
-        size->cvt[i] = FT_MulFix( face->cvt[i], size->ttmetrics.scale );
+        cvt[i] = FT_MulFix( face->cvt[i], scale );
 
       /* all twilight points are originally zero */
       for ( i = 0; i < (FT_UInt)size->twilight.n_points; i++ )
@@ -1086,7 +1528,23 @@
 
       size->GS = tt_default_graphics_state;
 
-      error = tt_size_run_prep( size, pedantic );
+      /* the result of the CVT program only depends on the scaling */
+      /* values if it starts with the default state                */
+      {
+        TT_ExecContext  exec = size->context;
+        FT_UInt         mode = exec ? tt_exec_mode( exec, pedantic ) : 0;
+
+
+        if ( exec && tt_size_restore_prep( size, mode ) )
+          error = size->cvt_ready;
+        else
+        {
+          error = tt_size_run_prep( size, pedantic );
+
+          if ( exec )
+            tt_size_store_prep( size, mode, error );
+        }
+      }
     }
 
   Exit:
@@ -1260,9 +1718,6 @@
     TT_Driver  driver = (TT_Driver)ttdriver;
 
 
-    if ( !TT_New_Context( driver ) )
-      return FT_THROW( Could_Not_Find_Context );
-
 #ifdef TT_CONFIG_OPTION_SUBPIXEL_HINTING
     driver->interpreter_version = TT_INTERPRETER_VERSION_38;
 #else
@@ -1293,20 +1748,7 @@
   FT_LOCAL_DEF( void )
   tt_driver_done( FT_Module  ttdriver )     /* TT_Driver */
   {
-#ifdef TT_USE_BYTECODE_INTERPRETER
-    TT_Driver  driver = (TT_Driver)ttdriver;
-
-
-    /* destroy the execution context */
-    if ( driver->context )
-    {
-      TT_Done_Context( driver->context );
-      driver->context = NULL;
-    }
-#else
     FT_UNUSED( ttdriver );
-#endif
-
   }
 
 
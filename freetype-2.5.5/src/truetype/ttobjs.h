@@ -324,11 +324,9 @@ FT_BEGIN_HEADER
 
     TT_GlyphZoneRec    twilight;     /* The instance's twilight zone    */
 
-    /* debugging variables */
-
-    /* When using the debugger, we must keep the */
-    /* execution context tied to the instance    */
-    /* object rather than asking it on demand.   */
+    /* Each instance has its own execution context, created together   */
+    /* with the bytecode data; faces thus don't share any interpreter  */
+    /* state.  If `debug' is set, the context is owned by the debugger. */
 
     FT_Bool            debug;
     TT_ExecContext     context;
@@ -338,11 +336,95 @@ FT_BEGIN_HEADER
     FT_Error           bytecode_ready;
     FT_Error           cvt_ready;
 
+    /* the serial number of the face's blend instance the CVT has been */
+    /* scaled and the CVT program has been executed for (GX fonts)     */
+    FT_ULong           instance;
+
 #endif /* TT_USE_BYTECODE_INTERPRETER */
 
   } TT_SizeRec;
 
 
+#ifdef TT_USE_BYTECODE_INTERPRETER
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The number of `prep' results cached per face.                         */
+  /*                                                                       */
+#define TT_PREP_CACHE_SIZE  16
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The state of a size object after running the CVT program.  The first  */
+  /* fields are the key: the scaling values, the interpreter mode, and the */
+  /* blend instance the program has been executed with.  `function_defs'   */
+  /* and `instruction_defs' are NULL unless `prep' has changed the         */
+  /* definitions of the font program.                                      */
+  /*                                                                       */
+  typedef struct  TT_PrepStateRec_
+  {
+    FT_UShort         x_ppem;
+    FT_UShort         y_ppem;
+    FT_Fixed          x_scale;
+    FT_Fixed          y_scale;
+    FT_UShort         ppem;
+    FT_Fixed          scale;
+    FT_Long           x_ratio;
+    FT_Long           y_ratio;
+    FT_UInt           mode;
+    FT_ULong          instance;
+
+    FT_Error          error;
+    TT_GraphicsState  GS;
+
+    FT_Long*          cvt;
+    FT_Long*          storage;
+    FT_Vector*        twilight_org;
+    FT_Vector*        twilight_cur;
+    FT_Byte*          twilight_tags;
+
+    FT_UInt           num_function_defs;
+    FT_UInt           num_instruction_defs;
+    FT_UInt           max_func;
+    FT_UInt           max_ins;
+    TT_DefArray       function_defs;
+    TT_DefArray       instruction_defs;
+
+  } TT_PrepStateRec, *TT_PrepState;
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* The bytecode state shared by all sizes of a face.  The font program   */
+  /* is executed only once per interpreter mode; new sizes start with a    */
+  /* copy of the resulting function and instruction definitions.           */
+  /* `preps' holds the most recently used CVT program results, the first   */
+  /* element being the most recent one.  Hinted glyph loads modify this    */
+  /* structure, so a face must not be used by several threads at the same  */
+  /* time, even with different size objects.                               */
+  /*                                                                       */
+  typedef struct  TT_BytecodeCacheRec_
+  {
+    FT_Bool          fpgm_valid;
+    FT_UInt          fpgm_mode;
+    FT_Error         fpgm_error;
+
+    FT_UInt          num_function_defs;
+    FT_UInt          num_instruction_defs;
+    FT_UInt          max_func;
+    FT_UInt          max_ins;
+    TT_DefArray      function_defs;
+    TT_DefArray      instruction_defs;
+
+    FT_UInt          num_preps;
+    TT_PrepStateRec  preps[TT_PREP_CACHE_SIZE];
+
+  } TT_BytecodeCacheRec;
+
+#endif /* TT_USE_BYTECODE_INTERPRETER */
+
+
   /*************************************************************************/
   /*                                                                       */
   /* TrueType driver class.                                                */
@@ -351,7 +433,6 @@ FT_BEGIN_HEADER
   {
     FT_DriverRec  root;
 
-    TT_ExecContext   context;  /* execution context        */
     TT_GlyphZoneRec  zone;     /* glyph loader points zone */
 
     FT_UInt  interpreter_version;
@@ -407,6 +488,9 @@ FT_BEGIN_HEADER
   tt_size_ready_bytecode( TT_Size  size,
                           FT_Bool  pedantic );
 
+  FT_LOCAL( void )
+  tt_face_flush_prep_cache( TT_Face  face );
+
 #endif /* TT_USE_BYTECODE_INTERPRETER */
 
   FT_LOCAL( FT_Error )
@@ -293,6 +293,8 @@
         retval = (FT_Long)( type1->charstrings_len[idx] + 1 );
         if ( value && value_len >= retval )
         {
+          T1_Decrypt_Charstring( t1face, idx );
+
           ft_memcpy( value, (void *)( type1->charstrings[idx] ),
                      retval - 1 );
           ((FT_Char *)value)[retval - 1] = (FT_Char)'\0';
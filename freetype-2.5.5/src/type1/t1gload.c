@@ -18,6 +18,7 @@
 
 #include <ft2build.h>
 #include "t1gload.h"
+#include "t1load.h"
 #include FT_INTERNAL_CALC_H
 #include FT_INTERNAL_DEBUG_H
 #include FT_INTERNAL_STREAM_H
@@ -85,6 +86,8 @@
 
     /* For ordinary fonts get the character data stored in the face record. */
     {
+      T1_Decrypt_Charstring( face, glyph_index );
+
       char_string->pointer = type1->charstrings[glyph_index];
       char_string->length  = (FT_Int)type1->charstrings_len[glyph_index];
     }
@@ -149,6 +152,14 @@
   }
 
 
+  /* The advance width is set by the first operator of a charstring    */
+  /* (`hsbw' or `sbw'); we thus only decrypt a copy of the first bytes */
+  /* of each charstring, keeping the charstrings themselves encrypted  */
+  /* until their glyphs get loaded.                                    */
+
+#define T1_METRICS_PREFIX_SIZE  32
+
+
   FT_LOCAL_DEF( FT_Error )
   T1_Compute_Max_Advance( T1_Face  face,
                           FT_Pos*  max_advance )
@@ -193,8 +204,26 @@
     /* the advance width                                      */
     for ( glyph_index = 0; glyph_index < type1->num_glyphs; glyph_index++ )
     {
-      /* now get load the unscaled outline */
-      (void)T1_Parse_Glyph( &decoder, glyph_index );
+      FT_Byte  prefix[T1_METRICS_PREFIX_SIZE];
+      FT_UInt  len;
+
+
+      len = T1_Get_Charstring_Prefix( face, (FT_UInt)glyph_index,
+                                      prefix, T1_METRICS_PREFIX_SIZE );
+      if ( len )
+      {
+        decoder.font_matrix = type1->font_matrix;
+        decoder.font_offset = type1->font_offset;
+
+        error = decoder.funcs.parse_charstrings( &decoder, prefix, len );
+      }
+
+      /* if the prefix is too short, parse the whole glyph */
+      if ( !len                                          ||
+           error                                         ||
+           decoder.builder.parse_state == T1_Parse_Start )
+        (void)T1_Parse_Glyph( &decoder, (FT_UInt)glyph_index );
+
       if ( glyph_index == 0 || decoder.builder.advance.x > *max_advance )
         *max_advance = decoder.builder.advance.x;
 
@@ -1038,6 +1038,30 @@
   }
 
 
+  /* Charstrings and subroutines are stored without their `lenIV'     */
+  /* leading random bytes; the decryption key after those bytes is    */
+  /* thus needed to decrypt the rest.  In the `charstrings_keys'      */
+  /* array, the key of a charstring that hasn't been decrypted yet is */
+  /* flagged with T1_KEY_ENCRYPTED; zero means `already decrypted'.   */
+
+#define T1_KEY_ENCRYPTED  0x10000UL
+
+
+  static FT_UInt32
+  t1_charstring_key( FT_Byte*  base,
+                     FT_Int    lenIV )
+  {
+    FT_UInt32  key = 4330;
+    FT_Int     n;
+
+
+    for ( n = 0; n < lenIV; n++ )
+      key = ( ( base[n] + key ) * 52845U + 22719 ) & 0xFFFFU;
+
+    return key;
+  }
+
+
   static int
   read_binary_data( T1_Parser  parser,
                     FT_Long*   size,
@@ -1451,27 +1475,27 @@
       /*                                                         */
       if ( face->type1.private_dict.lenIV >= 0 )
       {
-        FT_Byte*  temp;
+        FT_Int     lenIV = face->type1.private_dict.lenIV;
+        FT_UInt32  key;
 
 
         /* some fonts define empty subr records -- this is not totally */
         /* compliant to the specification (which says they should at   */
         /* least contain a `return'), but we support them anyway       */
-        if ( size < face->type1.private_dict.lenIV )
+        if ( size < lenIV )
         {
           error = FT_THROW( Invalid_File_Format );
           goto Fail;
         }
 
-        /* t1_decrypt() shouldn't write to base -- make temporary copy */
-        if ( FT_ALLOC( temp, size ) )
-          goto Fail;
-        FT_MEM_COPY( temp, base, size );
-        psaux->t1_decrypt( temp, size, 4330 );
-        size -= face->type1.private_dict.lenIV;
-        error = T1_Add_Table( table, (FT_Int)idx,
-                              temp + face->type1.private_dict.lenIV, size );
-        FT_FREE( temp );
+        /* t1_decrypt() shouldn't write to base -- decrypt the copy */
+        /* in the table instead                                     */
+        key   = t1_charstring_key( base, lenIV );
+        size -= lenIV;
+        error = T1_Add_Table( table, (FT_Int)idx, base + lenIV, size );
+        if ( !error )
+          psaux->t1_decrypt( table->elements[idx], (FT_Offset)size,
+                             (FT_UShort)key );
       }
       else
         error = T1_Add_Table( table, (FT_Int)idx, base, size );
@@ -1549,6 +1573,11 @@
       error = psaux->ps_table_funcs->init( swap_table, 4, memory );
       if ( error )
         goto Fail;
+
+      FT_FREE( loader->charstrings_keys );
+      if ( FT_NEW_ARRAY( loader->charstrings_keys,
+                         num_glyphs + 1 + TABLE_EXTEND ) )
+        goto Fail;
     }
 
     n = 0;
@@ -1646,24 +1675,22 @@
         if ( face->type1.private_dict.lenIV >= 0 &&
              n < num_glyphs + TABLE_EXTEND       )
         {
-          FT_Byte*  temp;
+          FT_Int  lenIV = face->type1.private_dict.lenIV;
 
 
-          if ( size <= face->type1.private_dict.lenIV )
+          if ( size <= lenIV )
           {
             error = FT_THROW( Invalid_File_Format );
             goto Fail;
           }
 
-          /* t1_decrypt() shouldn't write to base -- make temporary copy */
-          if ( FT_ALLOC( temp, size ) )
-            goto Fail;
-          FT_MEM_COPY( temp, base, size );
-          psaux->t1_decrypt( temp, size, 4330 );
-          size -= face->type1.private_dict.lenIV;
-          error = T1_Add_Table( code_table, n,
-                                temp + face->type1.private_dict.lenIV, size );
-          FT_FREE( temp );
+          /* the charstring is stored encrypted; it gets decrypted in */
+          /* place by `T1_Decrypt_Charstring' when first needed       */
+          loader->charstrings_keys[n] = T1_KEY_ENCRYPTED |
+                                        t1_charstring_key( base, lenIV );
+
+          size -= lenIV;
+          error = T1_Add_Table( code_table, n, base + lenIV, size );
         }
         else
           error = T1_Add_Table( code_table, n, base, size );
@@ -1738,6 +1765,14 @@
       if ( error )
         goto Fail;
 
+      {
+        FT_UInt32*  keys = loader->charstrings_keys;
+        FT_UInt32   key  = keys[0];
+
+
+        keys[0]            = keys[notdef_index];
+        keys[notdef_index] = key;
+      }
     }
     else if ( !notdef_found )
     {
@@ -1784,6 +1819,9 @@
       if ( error )
         goto Fail;
 
+      loader->charstrings_keys[n] = loader->charstrings_keys[0];
+      loader->charstrings_keys[0] = 0;
+
       /* we added a glyph. */
       loader->num_glyphs += 1;
     }
@@ -1848,9 +1886,10 @@
               FT_Byte*   base,
               FT_Long    size )
   {
-    T1_Parser  parser = &loader->parser;
-    FT_Byte   *limit, *start_binary = NULL;
-    FT_Bool    have_integer = 0;
+    T1_Parser      parser = &loader->parser;
+    PSAux_Service  psaux  = (PSAux_Service)face->psaux;
+    FT_Byte       *limit, *start_binary = NULL;
+    FT_Bool        have_integer = 0;
 
 
     parser->root.cursor = base;
@@ -1942,82 +1981,68 @@
 
         if ( len > 0 && len < 22 && parser->root.cursor < limit )
         {
-          /* now compare the immediate name to the keyword table */
-          T1_Field  keyword = (T1_Field)t1_keywords;
+          /* now look up the immediate name in the keyword table */
+          T1_Field  keyword;
 
 
-          for (;;)
+          keyword = (T1_Field)psaux->keyword_hash_lookup( &loader->keywords,
+                                                          cur,
+                                                          len );
+          if ( keyword )
           {
-            FT_Byte*  name;
-
-
-            name = (FT_Byte*)keyword->ident;
-            if ( !name )
-              break;
-
-            if ( cur[0] == name[0]                                  &&
-                 len == (FT_PtrDist)ft_strlen( (const char *)name ) &&
-                 ft_memcmp( cur, name, len ) == 0                   )
+            /* If we found it, run the parsing callback.    */
+            /* We record every instance of every field      */
+            /* (until we reach the base font of a           */
+            /* synthetic font) to deal adequately with      */
+            /* multiple master fonts; this is also          */
+            /* necessary because later PostScript           */
+            /* definitions override earlier ones.           */
+
+            /* Once we encounter `FontDirectory' after      */
+            /* `/Private', we know that this is a synthetic */
+            /* font; except for `/CharStrings' we are not   */
+            /* interested in anything that follows this     */
+            /* `FontDirectory'.                             */
+
+            /* MM fonts have more than one /Private token at */
+            /* the top level; let's hope that all the junk   */
+            /* that follows the first /Private token is not  */
+            /* interesting to us.                            */
+
+            /* According to Adobe Tech Note #5175 (CID-Keyed */
+            /* Font Installation for ATM Software) a `begin' */
+            /* must be followed by exactly one `end', and    */
+            /* `begin' -- `end' pairs must be accurately     */
+            /* paired.  We could use this to distinguish     */
+            /* between the global Private and the Private    */
+            /* dict that is a member of the Blend dict.      */
+
+            const FT_UInt dict =
+              ( loader->keywords_encountered & T1_PRIVATE )
+                  ? T1_FIELD_DICT_PRIVATE
+                  : T1_FIELD_DICT_FONTDICT;
+
+            if ( !( dict & keyword->dict ) )
             {
-              /* We found it -- run the parsing callback!     */
-              /* We record every instance of every field      */
-              /* (until we reach the base font of a           */
-              /* synthetic font) to deal adequately with      */
-              /* multiple master fonts; this is also          */
-              /* necessary because later PostScript           */
-              /* definitions override earlier ones.           */
-
-              /* Once we encounter `FontDirectory' after      */
-              /* `/Private', we know that this is a synthetic */
-              /* font; except for `/CharStrings' we are not   */
-              /* interested in anything that follows this     */
-              /* `FontDirectory'.                             */
-
-              /* MM fonts have more than one /Private token at */
-              /* the top level; let's hope that all the junk   */
-              /* that follows the first /Private token is not  */
-              /* interesting to us.                            */
-
-              /* According to Adobe Tech Note #5175 (CID-Keyed */
-              /* Font Installation for ATM Software) a `begin' */
-              /* must be followed by exactly one `end', and    */
-              /* `begin' -- `end' pairs must be accurately     */
-              /* paired.  We could use this to distinguish     */
-              /* between the global Private and the Private    */
-              /* dict that is a member of the Blend dict.      */
-
-              const FT_UInt dict =
-                ( loader->keywords_encountered & T1_PRIVATE )
-                    ? T1_FIELD_DICT_PRIVATE
-                    : T1_FIELD_DICT_FONTDICT;
-
-              if ( !( dict & keyword->dict ) )
-              {
-                FT_TRACE1(( "parse_dict: found `%s' but ignoring it"
-                            " since it is in the wrong dictionary\n",
-                            keyword->ident ));
-                break;
-              }
-
-              if ( !( loader->keywords_encountered &
-                      T1_FONTDIR_AFTER_PRIVATE     )                  ||
-                   ft_strcmp( (const char*)name, "CharStrings" ) == 0 )
+              FT_TRACE1(( "parse_dict: found `%s' but ignoring it"
+                          " since it is in the wrong dictionary\n",
+                          keyword->ident ));
+            }
+            else if ( !( loader->keywords_encountered &
+                         T1_FONTDIR_AFTER_PRIVATE     )          ||
+                      ft_strcmp( keyword->ident, "CharStrings" ) == 0 )
+            {
+              parser->root.error = t1_load_keyword( face,
+                                                    loader,
+                                                    keyword );
+              if ( parser->root.error != FT_Err_Ok )
               {
-                parser->root.error = t1_load_keyword( face,
-                                                      loader,
-                                                      keyword );
-                if ( parser->root.error != FT_Err_Ok )
-                {
-                  if ( FT_ERR_EQ( parser->root.error, Ignore ) )
-                    parser->root.error = FT_Err_Ok;
-                  else
-                    return parser->root.error;
-                }
+                if ( FT_ERR_EQ( parser->root.error, Ignore ) )
+                  parser->root.error = FT_Err_Ok;
+                else
+                  return parser->root.error;
               }
-              break;
             }
-
-            keyword++;
           }
         }
 
@@ -2064,6 +2089,7 @@
   t1_done_loader( T1_Loader  loader )
   {
     T1_Parser  parser = &loader->parser;
+    FT_Memory  memory = parser->root.memory;
 
 
     /* finalize tables */
@@ -2073,6 +2099,8 @@
     T1_Release_Table( &loader->swap_table );
     T1_Release_Table( &loader->subrs );
 
+    FT_FREE( loader->charstrings_keys );
+
     /* finalize parser */
     T1_Finalize_Parser( parser );
   }
@@ -2091,6 +2119,7 @@
 
 
     t1_init_loader( &loader, face );
+    psaux->keyword_hash_init( &loader.keywords, t1_keywords );
 
     /* default values */
     face->ndv_idx          = -1;
@@ -2207,6 +2236,8 @@
     type1->charstrings_block = loader.charstrings.block;
     type1->charstrings       = loader.charstrings.elements;
     type1->charstrings_len   = loader.charstrings.lengths;
+    type1->charstrings_keys  = loader.charstrings_keys;
+    loader.charstrings_keys  = NULL;
 
     /* we copy the glyph names `block' and `elements' fields; */
     /* the `lengths' field must be released later             */
@@ -2276,4 +2307,67 @@
   }
 
 
+  /*************************************************************************/
+  /*                                                                       */
+  /* Charstrings are kept encrypted after loading the font; this function  */
+  /* decrypts a glyph's charstring in place if this hasn't happened yet.   */
+  /* It must be called before accessing `type1->charstrings[glyph_index]'. */
+  /*                                                                       */
+  FT_LOCAL_DEF( void )
+  T1_Decrypt_Charstring( T1_Face  face,
+                         FT_UInt  glyph_index )
+  {
+    T1_Font  type1 = &face->type1;
+
+
+    if ( type1->charstrings_keys                  &&
+         glyph_index < (FT_UInt)type1->num_glyphs &&
+         type1->charstrings_keys[glyph_index]     )
+    {
+      PSAux_Service  psaux = (PSAux_Service)face->psaux;
+
+
+      psaux->t1_decrypt( type1->charstrings[glyph_index],
+                         (FT_Offset)type1->charstrings_len[glyph_index],
+                         (FT_UShort)type1->charstrings_keys[glyph_index] );
+      type1->charstrings_keys[glyph_index] = 0;
+    }
+  }
+
+
+  /*************************************************************************/
+  /*                                                                       */
+  /* Copy and decrypt the first `size' bytes of a charstring that is still */
+  /* encrypted, leaving the charstring itself untouched.  Return the       */
+  /* number of bytes copied, or zero if the charstring isn't encrypted     */
+  /* (or doesn't exist).                                                   */
+  /*                                                                       */
+  FT_LOCAL_DEF( FT_UInt )
+  T1_Get_Charstring_Prefix( T1_Face   face,
+                            FT_UInt   glyph_index,
+                            FT_Byte*  buffer,
+                            FT_UInt   size )
+  {
+    T1_Font        type1 = &face->type1;
+    PSAux_Service  psaux = (PSAux_Service)face->psaux;
+    FT_UInt        len;
+
+
+    if ( !type1->charstrings_keys                 ||
+         glyph_index >= (FT_UInt)type1->num_glyphs ||
+         !type1->charstrings_keys[glyph_index]    )
+      return 0;
+
+    len = (FT_UInt)type1->charstrings_len[glyph_index];
+    if ( len > size )
+      len = size;
+
+    FT_MEM_COPY( buffer, type1->charstrings[glyph_index], len );
+    psaux->t1_decrypt( buffer, len,
+                       (FT_UShort)type1->charstrings_keys[glyph_index] );
+
+    return len;
+  }
+
+
 /* END */
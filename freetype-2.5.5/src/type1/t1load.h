@@ -42,6 +42,7 @@ FT_BEGIN_HEADER
     FT_Int        num_glyphs;
     PS_TableRec   glyph_names;
     PS_TableRec   charstrings;
+    FT_UInt32*    charstrings_keys;
     PS_TableRec   swap_table;      /* For moving .notdef glyph to index 0. */
 
     FT_Int        num_subrs;
@@ -50,6 +51,8 @@ FT_BEGIN_HEADER
 
     FT_UInt       keywords_encountered; /* T1_LOADER_ENCOUNTERED_XXX */
 
+    PS_Keyword_HashRec  keywords;  /* hash of `t1_keywords' */
+
   } T1_LoaderRec, *T1_Loader;
 
 
@@ -63,6 +66,16 @@ FT_BEGIN_HEADER
   FT_LOCAL( FT_Error )
   T1_Open_Face( T1_Face  face );
 
+  FT_LOCAL( void )
+  T1_Decrypt_Charstring( T1_Face  face,
+                         FT_UInt  glyph_index );
+
+  FT_LOCAL( FT_UInt )
+  T1_Get_Charstring_Prefix( T1_Face   face,
+                            FT_UInt   glyph_index,
+                            FT_Byte*  buffer,
+                            FT_UInt   size );
+
 #ifndef T1_CONFIG_OPTION_NO_MM_SUPPORT
 
   FT_LOCAL( FT_Error )
@@ -211,6 +211,10 @@
     memory = face->root.memory;
     type1  = &face->type1;
 
+    /* with arena memory, all sub-objects go away with the arena */
+    if ( ft_mem_is_arena( memory ) )
+      goto Exit;
+
 #ifndef T1_CONFIG_OPTION_NO_MM_SUPPORT
     /* release multiple masters information */
     FT_ASSERT( ( face->len_buildchar == 0 ) == ( face->buildchar == NULL ) );
@@ -240,6 +244,7 @@
     }
 
     /* release top dictionary */
+    FT_FREE( type1->charstrings_keys );
     FT_FREE( type1->charstrings_len );
     FT_FREE( type1->charstrings );
     FT_FREE( type1->glyph_names );
@@ -268,6 +273,7 @@
     face->unicode_map              = NULL;
 #endif
 
+  Exit:
     face->root.family_name = NULL;
     face->root.style_name  = NULL;
   }
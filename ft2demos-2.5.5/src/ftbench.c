@@ -29,6 +29,7 @@
 #include FT_MODULE_H
 #include FT_CFF_DRIVER_H
 #include FT_TRUETYPE_DRIVER_H
+#include FT_COUNTERS_H
 
 #ifdef UNIX
 #include <sys/time.h>
@@ -120,6 +121,7 @@
 
 
   int    preload;
+  int    show_counters;
   char*  filename;
 
   unsigned int  first_index;
@@ -175,6 +177,36 @@
 #define TIMER_RESET( timer )  ( timer )->total = 0
 
 
+  /* clock for FreeType's performance counters, in microseconds */
+  static FT_ULong
+  counter_clock( void )
+  {
+    return (FT_ULong)( get_time() * 1E6 );
+  }
+
+
+  static void
+  print_counters( int  done )
+  {
+    FT_UInt  n;
+
+
+    for ( n = 0; n < FT_COUNTER_MAX; n++ )
+    {
+      FT_ULong  value = FT_Get_Counter( lib, n );
+
+
+      if ( !value )
+        continue;
+
+      printf( "    %-23s %12lu", FT_Get_Counter_Name( n ), value );
+      if ( done )
+        printf( "  (%.2f/op)", (double)value / (double)done );
+      printf( "\n" );
+    }
+  }
+
+
   /*
    * Bench code
    */
@@ -209,6 +241,9 @@
     TIMER_RESET( &timer );
     TIMER_RESET( &elapsed );
 
+    if ( show_counters )
+      FT_Reset_Counters( lib );
+
     for ( n = 0; !max_iter || n < max_iter; n++ )
     {
       TIMER_START( &elapsed );
@@ -225,6 +260,9 @@
       printf( "%5.3f us/op\n", TIMER_GET( &timer ) * 1E6 / (double)done );
     else
       printf( "no error-free calls\n" );
+
+    if ( show_counters )
+      print_counters( done );
   }
 
 
@@ -741,6 +779,7 @@
       "  -r N      Set render mode to N\n"
       "              0: normal, 1: light, 2: mono, 3: LCD, 4: LCD vertical\n"
       "            (default is 0).\n"
+      "  -S        Show FreeType's performance counters after each test.\n"
       "  -s S      Use S ppem as face size (default is %dppem).\n"
       "            If set to zero, don't call FT_Set_Pixel_Sizes.\n"
       "            Use value 0 with option `-f 1' or something similar to\n"
@@ -812,7 +851,7 @@
       int  opt;
 
 
-      opt = getopt( argc, argv, "b:Cc:f:Hi:m:pr:s:t:v" );
+      opt = getopt( argc, argv, "b:Cc:f:Hi:m:pr:Ss:t:v" );
 
       if ( opt == -1 )
         break;
@@ -880,6 +919,11 @@
           render_mode = FT_RENDER_MODE_NORMAL;
         break;
 
+      case 'S':
+        show_counters = 1;
+        FT_Set_Counter_Clock( lib, counter_clock );
+        break;
+
       case 's':
         size = atoi( optarg );
         if ( size < 0 )